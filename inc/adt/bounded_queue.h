@@ -0,0 +1,325 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Bounded lock-free queues over a power-of-two ring buffer
+ * MPMCQueue: any number of producers and consumers;
+ * every cell carries a sequence number, a producer owns cell i when sequence == position,
+ * a consumer owns it when sequence == position + 1, so head and tail only need one CAS each;
+ * SPSCQueue: exactly one producer and one consumer, no CAS at all, each side caches the other index;
+ * try* never wait, push/pop spin with Backoff until they succeed;
+ * *Batch claims a run of cells with a single index update.
+************************/
+#ifndef CCLIB_ADT_BOUNDED_QUEUE_H
+#define CCLIB_ADT_BOUNDED_QUEUE_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "concurrent.h"
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace cclib {
+    namespace adt {
+        //COMMENT: round up to the next power of two, at least 2
+        inline cc_size_t ringCapacity(cc_size_t capacity) {
+            cc_size_t result = 2;
+            while(result < capacity) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        template<typename T>
+        class MPMCQueue {
+            public:
+                explicit MPMCQueue(cc_size_t capacity): _mask(ringCapacity(capacity) - 1), _M_cells(CC_NULL), _M_tail(0), _M_head(0) {
+                    _M_cells = new Cell[_mask + 1];
+                    for(cc_size_t i = 0; i <= _mask; i++) {
+                        _M_cells[i]._sequence.store(i, std::memory_order_relaxed);
+                    }
+                }
+
+                ~MPMCQueue() {
+                    for(cc_size_t i = _M_head.load(); i != _M_tail.load(); i++) {
+                        _M_cells[i & _mask].data()->~T();
+                    }
+                    delete[] _M_cells;
+                    _M_cells = CC_NULL;
+                }
+
+            private:
+                MPMCQueue(const MPMCQueue& instance);
+                MPMCQueue& operator=(const MPMCQueue& instance);
+
+            public:
+                bool tryPush(const T& data) {
+                    cc_size_t position = 0;
+                    if(!claim(_M_tail, 0, 1, position)) return false;
+
+                    Cell& cell = _M_cells[position & _mask];
+                    new (cell.data()) T(data);
+                    cell._sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+
+                bool tryPush(T&& data) {
+                    cc_size_t position = 0;
+                    if(!claim(_M_tail, 0, 1, position)) return false;
+
+                    Cell& cell = _M_cells[position & _mask];
+                    new (cell.data()) T(std::move(data));
+                    cell._sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+
+                bool tryPop(T& data) {
+                    cc_size_t position = 0;
+                    if(!claim(_M_head, 1, 1, position)) return false;
+
+                    Cell& cell = _M_cells[position & _mask];
+                    data = std::move(*cell.data());
+                    cell.data()->~T();
+                    cell._sequence.store(position + _mask + 1, std::memory_order_release);
+                    return true;
+                }
+
+                void push(const T& data) {
+                    Backoff backoff;
+                    while(!tryPush(data)) {
+                        backoff.pause();
+                    }
+                }
+
+                void pop(T& data) {
+                    Backoff backoff;
+                    while(!tryPop(data)) {
+                        backoff.pause();
+                    }
+                }
+
+                //NOTICE: returns how many of the count elements were pushed, 0 when the queue is full
+                cc_size_t tryPushBatch(const T* data, cc_size_t count) {
+                    cc_size_t position = 0;
+                    cc_size_t claimed = claim(_M_tail, 0, count, position);
+
+                    for(cc_size_t i = 0; i < claimed; i++) {
+                        Cell& cell = _M_cells[(position + i) & _mask];
+                        new (cell.data()) T(data[i]);
+                        cell._sequence.store(position + i + 1, std::memory_order_release);
+                    }
+                    return claimed;
+                }
+
+                cc_size_t tryPopBatch(T* data, cc_size_t count) {
+                    cc_size_t position = 0;
+                    cc_size_t claimed = claim(_M_head, 1, count, position);
+
+                    for(cc_size_t i = 0; i < claimed; i++) {
+                        Cell& cell = _M_cells[(position + i) & _mask];
+                        data[i] = std::move(*cell.data());
+                        cell.data()->~T();
+                        cell._sequence.store(position + i + _mask + 1, std::memory_order_release);
+                    }
+                    return claimed;
+                }
+
+                cc_size_t capacity() const {
+                    return _mask + 1;
+                }
+
+                //NOTICE: only a snapshot, other threads may change it right after
+                cc_size_t size() const {
+                    cc_size_t tail = _M_tail.load(std::memory_order_relaxed);
+                    cc_size_t head = _M_head.load(std::memory_order_relaxed);
+                    return tail > head ? tail - head : 0;
+                }
+
+                bool empty() const {
+                    return 0 == size();
+                }
+
+            private:
+                struct Cell {
+                    std::atomic<cc_size_t> _sequence;
+                    typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage;
+
+                    T* data() {
+                        return reinterpret_cast<T*>(&_storage);
+                    }
+                };
+
+                //COMMENT: claim up to count consecutive cells whose sequence is position + lag, lag 0 for producers, 1 for consumers
+                cc_size_t claim(std::atomic<cc_size_t>& index, cc_size_t lag, cc_size_t count, cc_size_t& position) {
+                    position = index.load(std::memory_order_relaxed);
+                    while(true) {
+                        cc_size_t ready = 0;
+                        while(ready < count && ready <= _mask) {
+                            cc_size_t sequence = _M_cells[(position + ready) & _mask]._sequence.load(std::memory_order_acquire);
+                            if(sequence != position + ready + lag) break;
+                            ++ready;
+                        }
+
+                        if(0 == ready) {
+                            cc_size_t sequence = _M_cells[position & _mask]._sequence.load(std::memory_order_acquire);
+                            //NOTICE: behind position means full (producer) or empty (consumer), ahead means we lost a race
+                            if((long long)(sequence - (position + lag)) < 0) return 0;
+                            position = index.load(std::memory_order_relaxed);
+                            continue;
+                        }
+
+                        if(index.compare_exchange_weak(position, position + ready, std::memory_order_relaxed, std::memory_order_relaxed)) {
+                            return ready;
+                        }
+                    }
+                }
+
+            private:
+                const cc_size_t _mask;
+                Cell* _M_cells;
+                alignas(CC_CACHE_LINE_SIZE) std::atomic<cc_size_t> _M_tail;
+                alignas(CC_CACHE_LINE_SIZE) std::atomic<cc_size_t> _M_head;
+        };
+
+        template<typename T>
+        class SPSCQueue {
+            public:
+                explicit SPSCQueue(cc_size_t capacity): _mask(ringCapacity(capacity) - 1), _M_array(CC_NULL),
+                 _M_tail(0), _M_headCache(0), _M_head(0), _M_tailCache(0) {
+                    _M_array = static_cast<T*>(::operator new((_mask + 1) * sizeof(T)));
+                }
+
+                ~SPSCQueue() {
+                    for(cc_size_t i = _M_head.load(); i != _M_tail.load(); i++) {
+                        _M_array[i & _mask].~T();
+                    }
+                    ::operator delete(_M_array);
+                    _M_array = CC_NULL;
+                }
+
+            private:
+                SPSCQueue(const SPSCQueue& instance);
+                SPSCQueue& operator=(const SPSCQueue& instance);
+
+            public:
+                //NOTICE: producer side
+                bool tryPush(const T& data) {
+                    cc_size_t tail = _M_tail.load(std::memory_order_relaxed);
+                    if(0 == writable(tail, 1)) return false;
+
+                    new (_M_array + (tail & _mask)) T(data);
+                    _M_tail.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+
+                bool tryPush(T&& data) {
+                    cc_size_t tail = _M_tail.load(std::memory_order_relaxed);
+                    if(0 == writable(tail, 1)) return false;
+
+                    new (_M_array + (tail & _mask)) T(std::move(data));
+                    _M_tail.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+
+                void push(const T& data) {
+                    Backoff backoff;
+                    while(!tryPush(data)) {
+                        backoff.pause();
+                    }
+                }
+
+                cc_size_t tryPushBatch(const T* data, cc_size_t count) {
+                    cc_size_t tail = _M_tail.load(std::memory_order_relaxed);
+                    count = writable(tail, count);
+
+                    for(cc_size_t i = 0; i < count; i++) {
+                        new (_M_array + ((tail + i) & _mask)) T(data[i]);
+                    }
+                    _M_tail.store(tail + count, std::memory_order_release);
+                    return count;
+                }
+
+                //NOTICE: consumer side
+                bool tryPop(T& data) {
+                    cc_size_t head = _M_head.load(std::memory_order_relaxed);
+                    if(0 == readable(head, 1)) return false;
+
+                    T* cell = _M_array + (head & _mask);
+                    data = std::move(*cell);
+                    cell->~T();
+                    _M_head.store(head + 1, std::memory_order_release);
+                    return true;
+                }
+
+                void pop(T& data) {
+                    Backoff backoff;
+                    while(!tryPop(data)) {
+                        backoff.pause();
+                    }
+                }
+
+                cc_size_t tryPopBatch(T* data, cc_size_t count) {
+                    cc_size_t head = _M_head.load(std::memory_order_relaxed);
+                    count = readable(head, count);
+
+                    for(cc_size_t i = 0; i < count; i++) {
+                        T* cell = _M_array + ((head + i) & _mask);
+                        data[i] = std::move(*cell);
+                        cell->~T();
+                    }
+                    _M_head.store(head + count, std::memory_order_release);
+                    return count;
+                }
+
+                cc_size_t capacity() const {
+                    return _mask + 1;
+                }
+
+                cc_size_t size() const {
+                    return _M_tail.load(std::memory_order_acquire) - _M_head.load(std::memory_order_acquire);
+                }
+
+                bool empty() const {
+                    return 0 == size();
+                }
+
+            private:
+                //COMMENT: reload the consumer index only when the cached one says the ring is full
+                cc_size_t writable(cc_size_t tail, cc_size_t count) {
+                    cc_size_t free = _mask + 1 - (tail - _M_headCache);
+                    if(free < count) {
+                        _M_headCache = _M_head.load(std::memory_order_acquire);
+                        free = _mask + 1 - (tail - _M_headCache);
+                    }
+                    return free < count ? free : count;
+                }
+
+                cc_size_t readable(cc_size_t head, cc_size_t count) {
+                    cc_size_t ready = _M_tailCache - head;
+                    if(ready < count) {
+                        _M_tailCache = _M_tail.load(std::memory_order_acquire);
+                        ready = _M_tailCache - head;
+                    }
+                    return ready < count ? ready : count;
+                }
+
+            private:
+                const cc_size_t _mask;
+                T* _M_array;
+                alignas(CC_CACHE_LINE_SIZE) std::atomic<cc_size_t> _M_tail;
+                cc_size_t _M_headCache;
+                alignas(CC_CACHE_LINE_SIZE) std::atomic<cc_size_t> _M_head;
+                cc_size_t _M_tailCache;
+        };
+    } // namespace adt
+} // namespace cclib
+
+#endif //CCLIB_ADT_BOUNDED_QUEUE_H
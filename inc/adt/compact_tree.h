@@ -0,0 +1,488 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Compact red black tree
+ * the same balancing as RedBlackTree, but all nodes live in one Vector and link by 32 bit index;
+ * the top bit of the parent index is the color (set means red), so a node is the value plus 12 bytes,
+ * 16 bytes for int keys against 32 bytes and a separate heap block for RedBlackNode<int>;
+ * index 0 is nil and the header: black, its left and right children are the leftmost and rightmost nodes;
+ * removed nodes go to a free list threaded through _leftChild and are reused by the next insert;
+ * at most 2^31 - 1 nodes; an insert may move the arena, iterators stay valid, references to values do not.
+************************/
+#ifndef CCLIB_ADT_COMPACT_TREE_H
+#define CCLIB_ADT_COMPACT_TREE_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "vector.h"
+#include <stdint.h>
+
+namespace cclib {
+    namespace adt {
+        template<typename Comparable>
+        struct CompactRedBlackNode {
+            Comparable _data;
+            uint32_t _leftChild;
+            uint32_t _rightChild;
+            uint32_t _parent;   //NOTICE: the top bit is the color
+
+            CompactRedBlackNode(): _data(Comparable()), _leftChild(0), _rightChild(0), _parent(0) {}
+        };
+
+        template<typename Comparable>
+        class CompactRedBlackTree;
+
+        template<typename Comparable>
+        class CompactRedBlackTreeIterator {
+            public:
+                typedef CompactRedBlackTreeIterator<Comparable> _Self;
+
+            public:
+                CompactRedBlackTreeIterator(): _M_tree(CC_NULL), _index(0) {}
+                CompactRedBlackTreeIterator(const CompactRedBlackTree<Comparable>* tree, uint32_t index): _M_tree(tree), _index(index) {}
+
+                const Comparable& operator*() const {
+                    return _M_tree->value(_index);
+                }
+
+                const Comparable* operator->() const {
+                    return &_M_tree->value(_index);
+                }
+
+                _Self& operator++() {
+                    _index = _M_tree->next(_index);
+                    return *this;
+                }
+
+                _Self operator++(int) {
+                    _Self temp = *this;
+                    _index = _M_tree->next(_index);
+                    return temp;
+                }
+
+                _Self& operator--() {
+                    _index = _M_tree->previous(_index);
+                    return *this;
+                }
+
+                _Self operator--(int) {
+                    _Self temp = *this;
+                    _index = _M_tree->previous(_index);
+                    return temp;
+                }
+
+                bool operator==(const _Self& instance) const {
+                    return _index == instance._index;
+                }
+
+                bool operator!=(const _Self& instance) const {
+                    return _index != instance._index;
+                }
+
+            private:
+                const CompactRedBlackTree<Comparable>* _M_tree;
+                uint32_t _index;
+        };
+
+        template<typename Comparable>
+        class CompactRedBlackTree {
+            public:
+                typedef CompactRedBlackTreeIterator<Comparable> iterator;
+                typedef CompactRedBlackNode<Comparable> Node;
+
+                static const uint32_t NIL = 0;
+                static const uint32_t RED_BIT = 0x80000000u;
+
+            public:
+                explicit CompactRedBlackTree(cc_size_t capacity = 0): _M_nodes(capacity + 1), _root(NIL), _free(NIL), _size(0) {
+                    _M_nodes.push_back(Node());
+                }
+
+                iterator begin() const {
+                    return iterator(this, _M_nodes[NIL]._leftChild);
+                }
+
+                iterator end() const {
+                    return iterator(this, NIL);
+                }
+
+                bool empty() const {
+                    return 0 == _size;
+                }
+
+                cc_size_t size() const {
+                    return _size;
+                }
+
+                //NOTICE: bytes held by live and free nodes, not counting the spare capacity of the arena
+                cc_size_t nodeBytes() const {
+                    return _M_nodes.size() * sizeof(Node);
+                }
+
+                bool clear() {
+                    _M_nodes.clear();
+                    _M_nodes.push_back(Node());
+                    _root = _free = NIL;
+                    _size = 0;
+                    return true;
+                }
+
+                bool contains(const Comparable& data) const {
+                    return NIL != findIndex(data);
+                }
+
+                iterator find(const Comparable& data) const {
+                    return iterator(this, findIndex(data));
+                }
+
+                //NOTICE: the first value not less than data, end() when there is none
+                iterator lowerBound(const Comparable& data) const {
+                    uint32_t result = NIL;
+                    for(uint32_t node = _root; NIL != node;) {
+                        if(_M_nodes[node]._data < data) {
+                            node = _M_nodes[node]._rightChild;
+                        } else {
+                            result = node;
+                            node = _M_nodes[node]._leftChild;
+                        }
+                    }
+                    return iterator(this, result);
+                }
+
+                bool insert(const Comparable& data) {
+                    uint32_t parentNode = NIL;
+                    uint32_t current = _root;
+                    bool leftSide = false, leftmost = true, rightmost = true;
+                    while(NIL != current) {
+                        parentNode = current;
+                        if(data < _M_nodes[current]._data) {
+                            current = _M_nodes[current]._leftChild;
+                            leftSide = true;
+                            rightmost = false;
+                        } else if(_M_nodes[current]._data < data) {
+                            current = _M_nodes[current]._rightChild;
+                            leftSide = false;
+                            leftmost = false;
+                        } else {
+                            return false;
+                        }
+                    }
+
+                    uint32_t node = allocate(data);
+                    _M_nodes[node]._parent = parentNode | RED_BIT;
+                    if(NIL == parentNode) {
+                        _root = node;
+                    } else if(leftSide) {
+                        _M_nodes[parentNode]._leftChild = node;
+                    } else {
+                        _M_nodes[parentNode]._rightChild = node;
+                    }
+                    if(leftmost) _M_nodes[NIL]._leftChild = node;
+                    if(rightmost) _M_nodes[NIL]._rightChild = node;
+                    ++_size;
+
+                    insertFixUp(node);
+                    return true;
+                }
+
+                bool remove(const Comparable& data) {
+                    uint32_t node = findIndex(data);
+                    if(NIL == node) return false;
+
+                    if(node == _M_nodes[NIL]._leftChild) {
+                        _M_nodes[NIL]._leftChild = NIL == right(node) ? parent(node) : findMin(right(node));
+                    }
+                    if(node == _M_nodes[NIL]._rightChild) {
+                        _M_nodes[NIL]._rightChild = NIL == left(node) ? parent(node) : findMax(left(node));
+                    }
+
+                    uint32_t realRemoveNode = node;
+                    uint32_t replaceNode = NIL;
+                    bool removeRed = red(node);
+                    if(NIL == left(node)) {
+                        replaceNode = right(node);
+                        transplant(node, replaceNode);
+                    } else if(NIL == right(node)) {
+                        replaceNode = left(node);
+                        transplant(node, replaceNode);
+                    } else {
+                        realRemoveNode = findMin(right(node));
+                        removeRed = red(realRemoveNode);
+                        replaceNode = right(realRemoveNode);
+                        if(parent(realRemoveNode) == node) {
+                            setParent(replaceNode, realRemoveNode);
+                        } else {
+                            transplant(realRemoveNode, replaceNode);
+                            _M_nodes[realRemoveNode]._rightChild = right(node);
+                            setParent(right(realRemoveNode), realRemoveNode);
+                        }
+                        transplant(node, realRemoveNode);
+                        _M_nodes[realRemoveNode]._leftChild = left(node);
+                        setParent(left(realRemoveNode), realRemoveNode);
+                        setRed(realRemoveNode, red(node));
+                    }
+                    if(!removeRed) {
+                        deleteFixUp(replaceNode);
+                    }
+
+                    release(node);
+                    --_size;
+                    return true;
+                }
+
+                //NOTICE: writes the values in order as {a, b, c}
+                template<typename Writer>
+                void dump(Writer& writer) const {
+                    writer << '{';
+                    for(iterator itr = begin(); itr != end(); ++itr) {
+                        if(itr != begin()) writer << ", ";
+                        writer << *itr;
+                    }
+                    writer << '}';
+                }
+
+            private:
+                friend class CompactRedBlackTreeIterator<Comparable>;
+
+                const Comparable& value(uint32_t node) const {
+                    return _M_nodes[node]._data;
+                }
+
+                uint32_t left(uint32_t node) const {
+                    return _M_nodes[node]._leftChild;
+                }
+
+                uint32_t right(uint32_t node) const {
+                    return _M_nodes[node]._rightChild;
+                }
+
+                uint32_t parent(uint32_t node) const {
+                    return _M_nodes[node]._parent & ~RED_BIT;
+                }
+
+                bool red(uint32_t node) const {
+                    return 0 != (_M_nodes[node]._parent & RED_BIT);
+                }
+
+                void setParent(uint32_t node, uint32_t parentNode) {
+                    _M_nodes[node]._parent = (_M_nodes[node]._parent & RED_BIT) | parentNode;
+                }
+
+                void setRed(uint32_t node, bool isRed) {
+                    _M_nodes[node]._parent = isRed ? (_M_nodes[node]._parent | RED_BIT) : (_M_nodes[node]._parent & ~RED_BIT);
+                }
+
+                uint32_t findIndex(const Comparable& data) const {
+                    uint32_t node = _root;
+                    while(NIL != node) {
+                        const Node& current = _M_nodes[node];
+                        if(data < current._data) {
+                            node = current._leftChild;
+                        } else if(current._data < data) {
+                            node = current._rightChild;
+                        } else {
+                            return node;
+                        }
+                    }
+                    return NIL;
+                }
+
+                uint32_t findMin(uint32_t node) const {
+                    while(NIL != left(node)) node = left(node);
+                    return node;
+                }
+
+                uint32_t findMax(uint32_t node) const {
+                    while(NIL != right(node)) node = right(node);
+                    return node;
+                }
+
+                //NOTICE: past the largest is nil, after nil comes the smallest
+                uint32_t next(uint32_t node) const {
+                    if(NIL == node) return _M_nodes[NIL]._leftChild;
+                    if(NIL != right(node)) return findMin(right(node));
+                    uint32_t parentNode = parent(node);
+                    while(NIL != parentNode && node == right(parentNode)) {
+                        node = parentNode;
+                        parentNode = parent(parentNode);
+                    }
+                    return parentNode;
+                }
+
+                uint32_t previous(uint32_t node) const {
+                    if(NIL == node) return _M_nodes[NIL]._rightChild;
+                    if(NIL != left(node)) return findMax(left(node));
+                    uint32_t parentNode = parent(node);
+                    while(NIL != parentNode && node == left(parentNode)) {
+                        node = parentNode;
+                        parentNode = parent(parentNode);
+                    }
+                    return parentNode;
+                }
+
+                uint32_t allocate(const Comparable& data) {
+                    uint32_t node = _free;
+                    if(NIL != node) {
+                        _free = _M_nodes[node]._leftChild;
+                    } else {
+                        node = (uint32_t)_M_nodes.size();
+                        _M_nodes.push_back(Node());
+                    }
+                    _M_nodes[node]._data = data;
+                    _M_nodes[node]._leftChild = _M_nodes[node]._rightChild = NIL;
+                    return node;
+                }
+
+                void release(uint32_t node) {
+                    _M_nodes[node]._data = Comparable();
+                    _M_nodes[node]._leftChild = _free;
+                    _free = node;
+                }
+
+                void transplant(uint32_t originalNode, uint32_t replaceNode) {
+                    uint32_t parentNode = parent(originalNode);
+                    if(NIL == parentNode) {
+                        _root = replaceNode;
+                    } else if(originalNode == left(parentNode)) {
+                        _M_nodes[parentNode]._leftChild = replaceNode;
+                    } else {
+                        _M_nodes[parentNode]._rightChild = replaceNode;
+                    }
+                    setParent(replaceNode, parentNode);
+                }
+
+                void rotateLeft(uint32_t x) {
+                    uint32_t y = right(x);
+                    _M_nodes[x]._rightChild = left(y);
+                    if(NIL != left(y)) setParent(left(y), x);
+                    transplant(x, y);
+                    _M_nodes[y]._leftChild = x;
+                    setParent(x, y);
+                }
+
+                void rotateRight(uint32_t y) {
+                    uint32_t x = left(y);
+                    _M_nodes[y]._leftChild = right(x);
+                    if(NIL != right(x)) setParent(right(x), y);
+                    transplant(y, x);
+                    _M_nodes[x]._rightChild = y;
+                    setParent(y, x);
+                }
+
+                void insertFixUp(uint32_t node) {
+                    while(red(parent(node))) {
+                        uint32_t parentNode = parent(node);
+                        uint32_t grandParent = parent(parentNode);
+                        if(parentNode == left(grandParent)) {
+                            uint32_t uncle = right(grandParent);
+                            if(red(uncle)) {
+                                setRed(parentNode, false);
+                                setRed(uncle, false);
+                                setRed(grandParent, true);
+                                node = grandParent;
+                                continue;
+                            }
+                            if(node == right(parentNode)) {
+                                node = parentNode;
+                                rotateLeft(node);
+                                parentNode = parent(node);
+                            }
+                            setRed(parentNode, false);
+                            setRed(grandParent, true);
+                            rotateRight(grandParent);
+                        } else {
+                            uint32_t uncle = left(grandParent);
+                            if(red(uncle)) {
+                                setRed(parentNode, false);
+                                setRed(uncle, false);
+                                setRed(grandParent, true);
+                                node = grandParent;
+                                continue;
+                            }
+                            if(node == left(parentNode)) {
+                                node = parentNode;
+                                rotateRight(node);
+                                parentNode = parent(node);
+                            }
+                            setRed(parentNode, false);
+                            setRed(grandParent, true);
+                            rotateLeft(grandParent);
+                        }
+                    }
+                    setRed(_root, false);
+                }
+
+                void deleteFixUp(uint32_t node) {
+                    while(node != _root && !red(node)) {
+                        uint32_t parentNode = parent(node);
+                        if(node == left(parentNode)) {
+                            uint32_t sibling = right(parentNode);
+                            if(red(sibling)) {
+                                setRed(sibling, false);
+                                setRed(parentNode, true);
+                                rotateLeft(parentNode);
+                                sibling = right(parentNode);
+                            }
+                            if(!red(left(sibling)) && !red(right(sibling))) {
+                                setRed(sibling, true);
+                                node = parentNode;
+                            } else {
+                                if(!red(right(sibling))) {
+                                    setRed(left(sibling), false);
+                                    setRed(sibling, true);
+                                    rotateRight(sibling);
+                                    sibling = right(parentNode);
+                                }
+                                setRed(sibling, red(parentNode));
+                                setRed(parentNode, false);
+                                setRed(right(sibling), false);
+                                rotateLeft(parentNode);
+                                node = _root;
+                            }
+                        } else {
+                            uint32_t sibling = left(parentNode);
+                            if(red(sibling)) {
+                                setRed(sibling, false);
+                                setRed(parentNode, true);
+                                rotateRight(parentNode);
+                                sibling = left(parentNode);
+                            }
+                            if(!red(left(sibling)) && !red(right(sibling))) {
+                                setRed(sibling, true);
+                                node = parentNode;
+                            } else {
+                                if(!red(left(sibling))) {
+                                    setRed(right(sibling), false);
+                                    setRed(sibling, true);
+                                    rotateLeft(sibling);
+                                    sibling = left(parentNode);
+                                }
+                                setRed(sibling, red(parentNode));
+                                setRed(parentNode, false);
+                                setRed(left(sibling), false);
+                                rotateRight(parentNode);
+                                node = _root;
+                            }
+                        }
+                    }
+                    setRed(node, false);
+                }
+
+            private:
+                Vector<Node> _M_nodes;
+                uint32_t _root;
+                uint32_t _free;
+                cc_size_t _size;
+        };
+    }   //namespace adt
+}   //namespace cclib
+
+#endif //CCLIB_ADT_COMPACT_TREE_H
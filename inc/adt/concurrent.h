@@ -0,0 +1,226 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: shared building blocks of the lock-free containers
+ * TaggedPointer packs a 48 bit user space pointer and a 16 bit ABA tag into one 64 bit word,
+ * so a single-word compare-and-swap covers both;
+ * Backoff spins with a bounded exponential delay after a failed compare-and-swap;
+ * EpochReclaimer defers freeing unlinked nodes until no reader can still hold them (epoch based reclamation).
+************************/
+#ifndef CCLIB_ADT_CONCURRENT_H
+#define CCLIB_ADT_CONCURRENT_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+#define CC_CACHE_LINE_SIZE 64
+
+namespace cclib {
+    namespace adt {
+        inline void cpuRelax() {
+            #if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+            #elif defined(__aarch64__)
+            asm volatile("yield" ::: "memory");
+            #endif
+        }
+
+        template<typename T>
+        class TaggedPointer {
+            static_assert(sizeof(void*) == 8, "TaggedPointer needs 64 bit pointers");
+
+            public:
+                explicit TaggedPointer(uint64_t value = 0): _value(value) {}
+                TaggedPointer(T* pointer, uint16_t tag): _value((uint64_t)tag << 48 | ((uint64_t)pointer & POINTER_MASK)) {}
+
+                T* pointer() const {
+                    return (T*)(_value & POINTER_MASK);
+                }
+
+                uint16_t tag() const {
+                    return (uint16_t)(_value >> 48);
+                }
+
+                uint64_t value() const {
+                    return _value;
+                }
+
+                //NOTICE: every successful swap bumps the tag, an A-B-A sequence of pointers still changes the word
+                TaggedPointer next(T* pointer) const {
+                    return TaggedPointer(pointer, tag() + 1);
+                }
+
+            private:
+                static const uint64_t POINTER_MASK = ((uint64_t)1 << 48) - 1;
+                uint64_t _value;
+        };
+
+        class Backoff {
+            public:
+                explicit Backoff(unsigned int limit = 1024): _spin(1), _limit(limit) {}
+
+                void pause() {
+                    for(unsigned int i = 0; i < _spin; i++) {
+                        cpuRelax();
+                    }
+
+                    if(_spin < _limit) {
+                        _spin <<= 1;
+                    } else {
+                        std::this_thread::yield();  //NOTICE: oversubscribed, give the owner a chance to run
+                    }
+                }
+
+                void reset() {
+                    _spin = 1;
+                }
+
+            private:
+                unsigned int _spin;
+                unsigned int _limit;
+        };
+
+        //COMMENT: xorshift, cheap per-thread randomness for slot selection
+        inline uint32_t threadRandom() {
+            static thread_local uint32_t state = (uint32_t)(uintptr_t)&state | 1;
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        //COMMENT: a small dense number per thread, fixed for the thread's life
+        inline cc_size_t threadSlot() {
+            static std::atomic<cc_size_t> next(0);
+            static thread_local cc_size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+            return slot;
+        }
+
+        //NOTICE: epoch based reclamation (Fraser); a reader holds a Guard while it touches shared nodes,
+        //retire() parks an unlinked node until every reader that could have seen it has left;
+        //readers count themselves in striped counters, one per epoch parity, so threads need no registration;
+        //the epoch moves on only when no reader of the previous one is left, a node retired in epoch e is freed at e + 2;
+        //T needs a T* _M_retiredNext member, dispose frees it
+        template<typename T>
+        class EpochReclaimer {
+            public:
+                class Guard {
+                    public:
+                        explicit Guard(EpochReclaimer& reclaimer): _M_reclaimer(reclaimer), _epoch(reclaimer.enter()) {}
+                        ~Guard() {
+                            _M_reclaimer.leave(_epoch);
+                        }
+
+                    private:
+                        Guard(const Guard& instance);
+                        Guard& operator=(const Guard& instance);
+
+                    private:
+                        friend class EpochReclaimer;
+                        EpochReclaimer& _M_reclaimer;
+                        uint64_t _epoch;
+                };
+
+            public:
+                explicit EpochReclaimer(void (*dispose)(T*)): _M_dispose(dispose), _M_epoch(0), _retired(0) {
+                    for(cc_size_t i = 0; i < STRIPES; i++) {
+                        _M_stripes[i]._readers[0].store(0, std::memory_order_relaxed);
+                        _M_stripes[i]._readers[1].store(0, std::memory_order_relaxed);
+                    }
+                    for(cc_size_t i = 0; i < 3; i++) _M_limbo[i].store(CC_NULL, std::memory_order_relaxed);
+                }
+
+                //NOTICE: no reader may be inside any more
+                ~EpochReclaimer() {
+                    for(cc_size_t i = 0; i < 3; i++) dispose(_M_limbo[i].exchange(CC_NULL, std::memory_order_acquire));
+                }
+
+            private:
+                EpochReclaimer(const EpochReclaimer& instance);
+                EpochReclaimer& operator=(const EpochReclaimer& instance);
+
+            public:
+                //NOTICE: node must be unlinked already, guard is the one the caller unlinked it under
+                void retire(T* node, const Guard& guard) {
+                    std::atomic<T*>& limbo = _M_limbo[guard._epoch % 3];
+                    T* head = limbo.load(std::memory_order_relaxed);
+                    do {
+                        node->_M_retiredNext = head;
+                    } while(!limbo.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+                    if(0 == (_retired.fetch_add(1, std::memory_order_relaxed) + 1) % ADVANCE_PERIOD) advance();
+                }
+
+            private:
+                uint64_t enter() {
+                    std::atomic<long>* readers = _M_stripes[threadSlot() % STRIPES]._readers;
+                    for(;;) {
+                        uint64_t epoch = _M_epoch.load(std::memory_order_seq_cst);
+                        readers[epoch & 1].fetch_add(1, std::memory_order_seq_cst);
+                        //NOTICE: the epoch moved between the load and the count, that count may have been missed
+                        if(epoch == _M_epoch.load(std::memory_order_seq_cst)) return epoch;
+                        readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+                    }
+                }
+
+                void leave(uint64_t epoch) {
+                    _M_stripes[threadSlot() % STRIPES]._readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+                }
+
+                //COMMENT: one advancer at a time, nobody else may move the epoch while the oldest limbo list is taken
+                void advance() {
+                    std::unique_lock<std::mutex> lock(_M_advance, std::try_to_lock);
+                    if(!lock.owns_lock()) return;
+
+                    uint64_t epoch = _M_epoch.load(std::memory_order_seq_cst);
+                    for(cc_size_t i = 0; i < STRIPES; i++) {
+                        if(0 != _M_stripes[i]._readers[(epoch + 1) & 1].load(std::memory_order_seq_cst)) return;
+                    }
+                    //NOTICE: the list of epoch - 2 is taken before the epoch moves, after that epoch + 1 reuses its slot
+                    T* expired = _M_limbo[(epoch + 1) % 3].exchange(CC_NULL, std::memory_order_acquire);
+                    _M_epoch.store(epoch + 1, std::memory_order_seq_cst);
+                    lock.unlock();
+                    dispose(expired);
+                }
+
+                void dispose(T* node) {
+                    while(CC_NULL != node) {
+                        T* next = node->_M_retiredNext;
+                        _M_dispose(node);
+                        node = next;
+                    }
+                }
+
+            private:
+                static const cc_size_t STRIPES = 16;
+                static const long ADVANCE_PERIOD = 64;
+
+                //NOTICE: padding instead of alignas, the reclaimer lives inside heap allocated containers
+                struct Stripe {
+                    std::atomic<long> _readers[2];
+                    char _M_padding[CC_CACHE_LINE_SIZE - 2 * sizeof(std::atomic<long>)];
+                };
+
+                void (*_M_dispose)(T*);
+                Stripe _M_stripes[STRIPES];
+                std::atomic<uint64_t> _M_epoch;
+                std::atomic<long> _retired;
+                std::atomic<T*> _M_limbo[3];
+                std::mutex _M_advance;
+        };
+    } // namespace adt
+} // namespace cclib
+
+#endif //CCLIB_ADT_CONCURRENT_H
@@ -0,0 +1,354 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Deque
+ * elements live in fixed-size blocks, a map of block pointers keeps the blocks in order;
+ * element i is block (first + i) / BlockSize, slot (first + i) % BlockSize, so operator[] is O(1);
+ * push/pop at either end touch one block, only the map of pointers ever moves,
+ * so references to elements stay valid when inserting at the ends.
+************************/
+#ifndef CCLIB_ADT_DEQUE_H
+#define CCLIB_ADT_DEQUE_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include <new>
+#include <utility>
+
+namespace cclib {
+    namespace adt {
+        template<typename T, cc_size_t BlockSize>
+        class Deque;
+
+        template<typename T, cc_size_t BlockSize>
+        class DequeIterator {
+            public:
+                typedef DequeIterator<T, BlockSize> _Self;
+
+            public:
+                DequeIterator(): _M_deque(CC_NULL), _index(0) {}
+                DequeIterator(Deque<T, BlockSize>* deque, cc_size_t index): _M_deque(deque), _index(index) {}
+
+                T& operator*() {
+                    return (*_M_deque)[_index];
+                }
+
+                T* operator->() {
+                    return &(*_M_deque)[_index];
+                }
+
+                _Self& operator++() {
+                    ++_index;
+                    return *this;
+                }
+
+                _Self operator++(int) {
+                    _Self temp = *this;
+                    ++_index;
+                    return temp;
+                }
+
+                _Self& operator--() {
+                    --_index;
+                    return *this;
+                }
+
+                _Self operator--(int) {
+                    _Self temp = *this;
+                    --_index;
+                    return temp;
+                }
+
+                _Self operator+(long long offset) const {
+                    return _Self(_M_deque, _index + offset);
+                }
+
+                _Self operator-(long long offset) const {
+                    return _Self(_M_deque, _index - offset);
+                }
+
+                long long operator-(const _Self& instance) const {
+                    return (long long)_index - (long long)instance._index;
+                }
+
+                bool operator==(const _Self& instance) const {
+                    return _M_deque == instance._M_deque && _index == instance._index;
+                }
+
+                bool operator!=(const _Self& instance) const {
+                    return !operator==(instance);
+                }
+
+            private:
+                Deque<T, BlockSize>* _M_deque;
+                cc_size_t _index;
+        };
+
+        template<typename T, cc_size_t BlockSize = (sizeof(T) < 256 ? 4096 / sizeof(T) : 16)>
+        class Deque {
+            public:
+                typedef DequeIterator<T, BlockSize> iterator;
+
+            public:
+                Deque(): _size(0), _first(0), _mapBegin(0), _mapEnd(0), _mapCapacity(0), _M_map(CC_NULL), _M_spare(CC_NULL) {}
+
+                Deque(const Deque& instance): _size(0), _first(0), _mapBegin(0), _mapEnd(0), _mapCapacity(0), _M_map(CC_NULL), _M_spare(CC_NULL) {
+                    operator=(instance);
+                }
+
+                Deque(Deque&& instance): _size(0), _first(0), _mapBegin(0), _mapEnd(0), _mapCapacity(0), _M_map(CC_NULL), _M_spare(CC_NULL) {
+                    swap(instance);
+                }
+
+                ~Deque() {
+                    clear();
+                    for(cc_size_t i = _mapBegin; i < _mapEnd; i++) {
+                        freeBlock(_M_map[i]);
+                    }
+                    freeBlock(_M_spare);
+                    delete[] _M_map;
+                    _M_map = CC_NULL;
+                }
+
+                Deque& operator=(const Deque& instance) {
+                    if(this != &instance) {
+                        clear();
+                        for(cc_size_t i = 0; i < instance._size; i++) {
+                            push_back(instance[i]);
+                        }
+                    }
+
+                    return *this;
+                }
+
+                Deque& operator=(Deque&& instance) {
+                    if(this != &instance) {
+                        Deque temp(std::move(instance));
+                        swap(temp);
+                    }
+
+                    return *this;
+                }
+
+            public:
+                T& operator[](cc_size_t index) {
+                    cc_size_t global = _first + index;
+                    return _M_map[_mapBegin + global / BlockSize][global % BlockSize];
+                }
+
+                const T& operator[](cc_size_t index) const {
+                    cc_size_t global = _first + index;
+                    return _M_map[_mapBegin + global / BlockSize][global % BlockSize];
+                }
+
+                T& front() {
+                    return operator[](0);
+                }
+
+                T& back() {
+                    return operator[](_size - 1);
+                }
+
+                iterator begin() {
+                    return iterator(this, 0);
+                }
+
+                iterator end() {
+                    return iterator(this, _size);
+                }
+
+                cc_size_t size() const {
+                    return _size;
+                }
+
+                bool empty() const {
+                    return 0 == _size;
+                }
+
+                bool clear() {
+                    while(!empty()) {
+                        pop_back();
+                    }
+                    return true;
+                }
+
+                bool push_back(const T& data) {
+                    new (backSlot()) T(data);
+                    ++_size;
+                    return true;
+                }
+
+                bool push_back(T&& data) {
+                    new (backSlot()) T(std::move(data));
+                    ++_size;
+                    return true;
+                }
+
+                template<typename... Args>
+                T& emplace_back(Args&&... args) {
+                    T* slot = backSlot();
+                    new (slot) T(std::forward<Args>(args)...);
+                    ++_size;
+                    return *slot;
+                }
+
+                bool push_front(const T& data) {
+                    new (frontSlot()) T(data);
+                    --_first;
+                    ++_size;
+                    return true;
+                }
+
+                bool push_front(T&& data) {
+                    new (frontSlot()) T(std::move(data));
+                    --_first;
+                    ++_size;
+                    return true;
+                }
+
+                template<typename... Args>
+                T& emplace_front(Args&&... args) {
+                    T* slot = frontSlot();
+                    new (slot) T(std::forward<Args>(args)...);
+                    --_first;
+                    ++_size;
+                    return *slot;
+                }
+
+                bool pop_back() {
+                    if(empty()) return false;
+
+                    back().~T();
+                    --_size;
+
+                    //COMMENT: give the trailing block back once nothing lives in it
+                    cc_size_t global = _first + _size;
+                    if(0 == global % BlockSize && _mapBegin + global / BlockSize < _mapEnd) {
+                        recycleBlock(_M_map[--_mapEnd]);
+                    }
+                    resetIfEmpty();
+                    return true;
+                }
+
+                bool pop_front() {
+                    if(empty()) return false;
+
+                    front().~T();
+                    --_size;
+                    if(BlockSize == ++_first) {
+                        recycleBlock(_M_map[_mapBegin++]);
+                        _first = 0;
+                    }
+                    resetIfEmpty();
+                    return true;
+                }
+
+                void swap(Deque& instance) {
+                    std::swap(_size, instance._size);
+                    std::swap(_first, instance._first);
+                    std::swap(_mapBegin, instance._mapBegin);
+                    std::swap(_mapEnd, instance._mapEnd);
+                    std::swap(_mapCapacity, instance._mapCapacity);
+                    std::swap(_M_map, instance._M_map);
+                    std::swap(_M_spare, instance._M_spare);
+                }
+
+            private:
+                //NOTICE: returns raw storage for the new back element, the caller constructs it
+                T* backSlot() {
+                    cc_size_t global = _first + _size;
+                    cc_size_t block = _mapBegin + global / BlockSize;
+                    if(block == _mapEnd) {
+                        if(_mapEnd == _mapCapacity) {
+                            reallocateMap();
+                            block = _mapBegin + global / BlockSize;
+                        }
+                        _M_map[_mapEnd++] = allocateBlock();
+                    }
+                    return _M_map[block] + global % BlockSize;
+                }
+
+                T* frontSlot() {
+                    if(0 == _first || _mapBegin == _mapEnd) {
+                        if(0 == _mapBegin) {
+                            reallocateMap();
+                        }
+                        _M_map[--_mapBegin] = allocateBlock();
+                        _first += BlockSize;
+                    }
+                    return _M_map[_mapBegin] + (_first - 1);
+                }
+
+                //COMMENT: recenter the used blocks, doubling the map when it is more than half full
+                void reallocateMap() {
+                    cc_size_t used = _mapEnd - _mapBegin;
+                    cc_size_t capacity = _mapCapacity;
+                    if(2 * (used + 1) > capacity) {
+                        capacity = 2 * capacity + 4;
+                    }
+
+                    T** temp = new T*[capacity];
+                    cc_size_t begin = (capacity - used) / 2;
+                    for(cc_size_t i = 0; i < used; i++) {
+                        temp[begin + i] = _M_map[_mapBegin + i];
+                    }
+
+                    delete[] _M_map;
+                    _M_map = temp;
+                    _mapCapacity = capacity;
+                    _mapBegin = begin;
+                    _mapEnd = begin + used;
+                }
+
+                void resetIfEmpty() {
+                    if(0 == _size && _mapBegin != _mapEnd) {
+                        while(_mapBegin != _mapEnd) {
+                            recycleBlock(_M_map[--_mapEnd]);
+                        }
+                        _first = 0;
+                    }
+                }
+
+                T* allocateBlock() {
+                    if(CC_NULL != _M_spare) {
+                        T* block = _M_spare;
+                        _M_spare = CC_NULL;
+                        return block;
+                    }
+                    return static_cast<T*>(::operator new(BlockSize * sizeof(T)));
+                }
+
+                //NOTICE: keep one block around so that push/pop across a block boundary does not allocate every time
+                void recycleBlock(T* block) {
+                    if(CC_NULL == _M_spare) {
+                        _M_spare = block;
+                    } else {
+                        freeBlock(block);
+                    }
+                }
+
+                void freeBlock(T* block) {
+                    ::operator delete(block);
+                }
+
+            private:
+                cc_size_t _size;
+                cc_size_t _first;
+                cc_size_t _mapBegin;
+                cc_size_t _mapEnd;
+                cc_size_t _mapCapacity;
+                T** _M_map;
+                T* _M_spare;
+        };
+    } // namespace adt
+} // namespace cclib
+
+#endif //CCLIB_ADT_DEQUE_H
@@ -0,0 +1,109 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Fenwick tree (binary indexed tree)
+ * prefix sums over an array that keeps changing, O(log n) for a point update and for a prefix sum, n + 1 values in one Vector;
+ * slot i (1 based) holds the sum of the i & -i values ending at i, a prefix walks down by clearing low bits,
+ * an update walks up by adding them;
+ * T needs +, -, < and T() as zero; indexes are 0 based in the interface.
+************************/
+#ifndef CCLIB_ADT_FENWICK_TREE_H
+#define CCLIB_ADT_FENWICK_TREE_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "vector.h"
+
+namespace cclib {
+    namespace adt {
+        template<typename T>
+        class FenwickTree {
+            public:
+                //NOTICE: size values, all zero
+                explicit FenwickTree(cc_size_t size = 0): _size(size) {
+                    _M_tree.reserve(size + 1);
+                    for(cc_size_t i = 0; i <= size; i++) _M_tree.push_back(T());
+                }
+
+                //NOTICE: O(n), every slot hands its sum up to the next slot that covers it
+                explicit FenwickTree(const Vector<T>& values): _size(values.size()) {
+                    _M_tree.reserve(_size + 1);
+                    _M_tree.push_back(T());
+                    for(cc_size_t i = 0; i < _size; i++) _M_tree.push_back(values[i]);
+                    for(cc_size_t i = 1; i <= _size; i++) {
+                        cc_size_t parent = i + lowBit(i);
+                        if(parent <= _size) _M_tree[parent] = _M_tree[parent] + _M_tree[i];
+                    }
+                }
+
+            public:
+                cc_size_t size() const {
+                    return _size;
+                }
+
+                void add(cc_size_t index, const T& delta) {
+                    for(cc_size_t i = index + 1; i <= _size; i += lowBit(i)) {
+                        _M_tree[i] = _M_tree[i] + delta;
+                    }
+                }
+
+                void set(cc_size_t index, const T& value) {
+                    add(index, value - at(index));
+                }
+
+                //NOTICE: sum of the first count values
+                T prefixSum(cc_size_t count) const {
+                    T sum = T();
+                    for(cc_size_t i = count; i > 0; i -= lowBit(i)) {
+                        sum = sum + _M_tree[i];
+                    }
+                    return sum;
+                }
+
+                //NOTICE: sum of the values in [first, last)
+                T rangeSum(cc_size_t first, cc_size_t last) const {
+                    return prefixSum(last) - prefixSum(first);
+                }
+
+                T at(cc_size_t index) const {
+                    return rangeSum(index, index + 1);
+                }
+
+                //NOTICE: the first index whose prefix sum (itself included) reaches target, size() when the total stays below;
+                //one walk down the implicit tree, O(log n); the values must not be negative
+                cc_size_t lowerBound(const T& target) const {
+                    cc_size_t step = 1;
+                    while(step <= _size / 2) step <<= 1;
+
+                    cc_size_t position = 0;
+                    T rest = target;
+                    for(; step > 0 && _size > 0; step >>= 1) {
+                        if(position + step <= _size && _M_tree[position + step] < rest) {
+                            position += step;
+                            rest = rest - _M_tree[position];
+                        }
+                    }
+                    return position;
+                }
+
+            private:
+                static cc_size_t lowBit(cc_size_t index) {
+                    return index & (~index + 1);
+                }
+
+            private:
+                cc_size_t _size;
+                Vector<T> _M_tree;  //NOTICE: slot 0 is unused
+        };
+    }   //namespace adt
+}   //namespace cclib
+
+#endif //CCLIB_ADT_FENWICK_TREE_H
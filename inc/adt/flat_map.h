@@ -0,0 +1,218 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Flat map and flat set
+ * the entries sit sorted by key in one Vector, a lookup is a binary search over contiguous memory, no pointers to chase;
+ * a single insert() or erase() shifts the tail, O(n), fine for read-mostly tables;
+ * for a rebuild, append() queues entries in any order and commit() sorts the batch once and merges it in one pass,
+ * O(n + m log m); queued entries are not visible before commit(), a later entry for the same key wins;
+ * eraseIf() drops every entry a predicate picks in one pass.
+************************/
+#ifndef CCLIB_ADT_FLAT_MAP_H
+#define CCLIB_ADT_FLAT_MAP_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "vector.h"
+#include "pair.h"
+#include <algorithm>
+
+namespace cclib {
+    namespace adt {
+        template<typename Key, typename Value>
+        struct FlatMapKey {
+            static const Key& key(const Pair<Key, Value>& entry) {
+                return entry._key;
+            }
+        };
+
+        template<typename Key>
+        struct FlatSetKey {
+            static const Key& key(const Key& entry) {
+                return entry;
+            }
+        };
+
+        //NOTICE: the sorted storage shared by FlatMap and FlatSet, KeyOf::key(entry) gives the key an entry is sorted by
+        template<typename Entry, typename Key, typename KeyOf>
+        class FlatTable {
+            public:
+                cc_size_t size() const {
+                    return _M_entries.size();
+                }
+
+                bool empty() const {
+                    return _M_entries.empty();
+                }
+
+                bool clear() {
+                    _M_entries.clear();
+                    _M_pending.clear();
+                    return true;
+                }
+
+                bool contains(const Key& key) const {
+                    return CC_NULL != findEntry(key);
+                }
+
+                //NOTICE: the entries in key order, index < size()
+                const Entry& operator[](cc_size_t index) const {
+                    return _M_entries[index];
+                }
+
+                //NOTICE: index of the first entry not less than key, size() when there is none
+                cc_size_t lowerBound(const Key& key) const {
+                    cc_size_t first = 0, count = _M_entries.size();
+                    while(count > 0) {
+                        cc_size_t half = count / 2;
+                        if(KeyOf::key(_M_entries[first + half]) < key) {
+                            first += half + 1;
+                            count -= half + 1;
+                        } else {
+                            count = half;
+                        }
+                    }
+                    return first;
+                }
+
+                bool erase(const Key& key) {
+                    cc_size_t index = lowerBound(key);
+                    if(index == _M_entries.size() || key < KeyOf::key(_M_entries[index])) return false;
+                    return _M_entries.earse(index);
+                }
+
+                //NOTICE: removes every entry predicate(entry) is true for, one pass, returns how many
+                template<typename Predicate>
+                cc_size_t eraseIf(Predicate predicate) {
+                    cc_size_t kept = 0, count = _M_entries.size();
+                    for(cc_size_t i = 0; i < count; i++) {
+                        if(predicate(_M_entries[i])) continue;
+                        if(kept != i) _M_entries[kept] = _M_entries[i];
+                        ++kept;
+                    }
+                    for(cc_size_t i = kept; i < count; i++) _M_entries.pop_back();
+                    return count - kept;
+                }
+
+                //NOTICE: entries appended and not committed yet
+                cc_size_t pending() const {
+                    return _M_pending.size();
+                }
+
+                //NOTICE: sorts the queued entries (stable, so the last one of a key wins) and merges them in one pass
+                void commit() {
+                    cc_size_t count = _M_pending.size();
+                    if(0 == count) return;
+
+                    std::stable_sort(&_M_pending[0], &_M_pending[0] + count, EntryLess());
+                    Vector<Entry> merged;
+                    merged.reserve(_M_entries.size() + count);
+                    cc_size_t i = 0, j = 0;
+                    while(i < _M_entries.size() || j < count) {
+                        if(j == count || (i < _M_entries.size() && KeyOf::key(_M_entries[i]) < KeyOf::key(_M_pending[j]))) {
+                            merged.push_back(_M_entries[i++]);
+                            continue;
+                        }
+                        while(j + 1 < count && !(KeyOf::key(_M_pending[j]) < KeyOf::key(_M_pending[j + 1]))) ++j;
+                        if(i < _M_entries.size() && !(KeyOf::key(_M_pending[j]) < KeyOf::key(_M_entries[i]))) ++i;  //NOTICE: replaced
+                        merged.push_back(_M_pending[j++]);
+                    }
+                    _M_entries.swap(merged);
+                    _M_pending.clear();
+                }
+
+                //NOTICE: calls visitor(entry) in key order
+                template<typename Visitor>
+                void forEach(Visitor visitor) const {
+                    for(cc_size_t i = 0; i < _M_entries.size(); i++) visitor(_M_entries[i]);
+                }
+
+                //NOTICE: calls visitor(entry) in key order for the keys in [low, high)
+                template<typename Visitor>
+                void forRange(const Key& low, const Key& high, Visitor visitor) const {
+                    for(cc_size_t i = lowerBound(low); i < _M_entries.size() && KeyOf::key(_M_entries[i]) < high; i++) visitor(_M_entries[i]);
+                }
+
+                //NOTICE: writes the entries in key order as [a, b, c]
+                template<typename Writer>
+                void dump(Writer& writer) const {
+                    _M_entries.dump(writer);
+                }
+
+            protected:
+                struct EntryLess {
+                    bool operator()(const Entry& left, const Entry& right) const {
+                        return KeyOf::key(left) < KeyOf::key(right);
+                    }
+                };
+
+                const Entry* findEntry(const Key& key) const {
+                    cc_size_t index = lowerBound(key);
+                    if(index == _M_entries.size() || key < KeyOf::key(_M_entries[index])) return CC_NULL;
+                    return &_M_entries[index];
+                }
+
+                //NOTICE: false when the key is there already, the old entry stays
+                bool insertEntry(const Entry& entry) {
+                    cc_size_t index = lowerBound(KeyOf::key(entry));
+                    if(index < _M_entries.size() && !(KeyOf::key(entry) < KeyOf::key(_M_entries[index]))) return false;
+                    return _M_entries.insert((int)index, entry);
+                }
+
+                void appendEntry(const Entry& entry) {
+                    _M_pending.push_back(entry);
+                }
+
+            protected:
+                Vector<Entry> _M_entries;
+                Vector<Entry> _M_pending;
+        };
+
+        template<typename Key, typename Value>
+        class FlatMap: public FlatTable<Pair<Key, Value>, Key, FlatMapKey<Key, Value> > {
+            public:
+                typedef Pair<Key, Value> Entry;
+
+            public:
+                //NOTICE: CC_NULL when key is not in the map
+                const Value* find(const Key& key) const {
+                    const Entry* entry = this->findEntry(key);
+                    return CC_NULL == entry ? CC_NULL : &entry->_value;
+                }
+
+                Value* find(const Key& key) {
+                    return const_cast<Value*>(static_cast<const FlatMap*>(this)->find(key));
+                }
+
+                bool insert(const Key& key, const Value& value) {
+                    return this->insertEntry(Entry(key, value));
+                }
+
+                void append(const Key& key, const Value& value) {
+                    this->appendEntry(Entry(key, value));
+                }
+        };
+
+        template<typename Key>
+        class FlatSet: public FlatTable<Key, Key, FlatSetKey<Key> > {
+            public:
+                bool insert(const Key& key) {
+                    return this->insertEntry(key);
+                }
+
+                void append(const Key& key) {
+                    this->appendEntry(key);
+                }
+        };
+    }   //namespace adt
+}   //namespace cclib
+
+#endif //CCLIB_ADT_FLAT_MAP_H
@@ -0,0 +1,224 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Lock-free stack (Treiber stack)
+ * the head is a TaggedPointer, so a node popped and pushed again between a load and a CAS fails the CAS (ABA);
+ * popped nodes go to an internal free-list instead of the allocator, a node read by a late thread is always valid memory;
+ * nodes are released only in the destructor, when no other thread can touch the stack;
+ * on contention push/pop meet in an elimination array and cancel out without touching the head.
+************************/
+#ifndef CCLIB_ADT_LOCK_FREE_STACK_H
+#define CCLIB_ADT_LOCK_FREE_STACK_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "concurrent.h"
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace cclib {
+    namespace adt {
+        template<typename T>
+        struct LockFreeStackNode {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage;
+            std::atomic<LockFreeStackNode*> _next;
+
+            LockFreeStackNode(): _next(CC_NULL) {}
+
+            T* data() {
+                return reinterpret_cast<T*>(&_storage);
+            }
+        };
+
+        template<typename T, cc_size_t EliminationSize = 8>
+        class LockFreeStack {
+            public:
+                typedef LockFreeStackNode<T> Node;
+
+            public:
+                LockFreeStack(): _M_head(0), _M_free(0) {
+                    for(cc_size_t i = 0; i < EliminationSize; i++) {
+                        _M_elimination[i]._slot.store(0, std::memory_order_relaxed);
+                    }
+                }
+
+                ~LockFreeStack() {
+                    Node* node = popNode();
+                    while(CC_NULL != node) {
+                        node->data()->~T();
+                        delete node;
+                        node = popNode();
+                    }
+
+                    node =TaggedPointer<Node>(_M_free.load()).pointer();
+                    while(CC_NULL != node) {
+                        Node* next = node->_next.load(std::memory_order_relaxed);
+                        delete node;
+                        node = next;
+                    }
+                }
+
+            private:
+                LockFreeStack(const LockFreeStack& instance);
+                LockFreeStack& operator=(const LockFreeStack& instance);
+
+            public:
+                bool push(const T& data) {
+                    Node* node = allocate();
+                    new (node->data()) T(data);
+                    pushNode(node);
+                    return true;
+                }
+
+                bool push(T&& data) {
+                    Node* node = allocate();
+                    new (node->data()) T(std::move(data));
+                    pushNode(node);
+                    return true;
+                }
+
+                bool pop(T& data) {
+                    Node* node = popNode();
+                    if(CC_NULL == node) return false;
+
+                    data = std::move(*node->data());
+                    node->data()->~T();
+                    release(node);
+                    return true;
+                }
+
+                //NOTICE: only a snapshot, other threads may change it right after
+                bool empty() const {
+                    return CC_NULL == TaggedPointer<Node>(_M_head.load(std::memory_order_acquire)).pointer();
+                }
+
+            private:
+                void pushNode(Node* node) {
+                    Backoff backoff;
+                    TaggedPointer<Node> head(_M_head.load(std::memory_order_relaxed));
+                    while(true) {
+                        node->_next.store(head.pointer(), std::memory_order_relaxed);
+                        uint64_t expected = head.value();
+                        if(_M_head.compare_exchange_weak(expected, head.next(node).value(),
+                            std::memory_order_release, std::memory_order_relaxed)) {
+                            return;
+                        }
+
+                        //COMMENT: contended, try to hand the node straight to a concurrent pop
+                        if(eliminatePush(node)) return;
+                        backoff.pause();
+                        head = TaggedPointer<Node>(_M_head.load(std::memory_order_relaxed));
+                    }
+                }
+
+                Node* popNode() {
+                    Backoff backoff;
+                    while(true) {
+                        TaggedPointer<Node> head(_M_head.load(std::memory_order_acquire));
+                        Node* node = head.pointer();
+                        if(CC_NULL == node) return CC_NULL;
+
+                        //NOTICE: node may already be popped and recycled, the tag makes the CAS below fail then
+                        Node* next = node->_next.load(std::memory_order_relaxed);
+                        uint64_t expected = head.value();
+                        if(_M_head.compare_exchange_weak(expected, head.next(next).value(),
+                            std::memory_order_acquire, std::memory_order_relaxed)) {
+                            return node;
+                        }
+
+                        node = eliminatePop();
+                        if(CC_NULL != node) return node;
+                        backoff.pause();
+                    }
+                }
+
+                bool eliminatePush(Node* node) {
+                    std::atomic<uint64_t>& slot = _M_elimination[threadRandom() % EliminationSize]._slot;
+                    TaggedPointer<Node> empty(slot.load(std::memory_order_relaxed));
+                    if(CC_NULL != empty.pointer()) return false;
+
+                    TaggedPointer<Node> offer = empty.next(node);
+                    uint64_t expected = empty.value();
+                    if(!slot.compare_exchange_strong(expected, offer.value(), std::memory_order_release, std::memory_order_relaxed)) {
+                        return false;
+                    }
+
+                    for(int i = 0; i < ELIMINATION_SPIN; i++) {
+                        if(slot.load(std::memory_order_relaxed) != offer.value()) {
+                            return true;    //NOTICE: taken by a pop
+                        }
+                        cpuRelax();
+                    }
+
+                    //COMMENT: withdraw the offer, failing means a pop took it in the meantime
+                    expected = offer.value();
+                    return !slot.compare_exchange_strong(expected, offer.next(CC_NULL).value(),
+                        std::memory_order_relaxed, std::memory_order_relaxed);
+                }
+
+                Node* eliminatePop() {
+                    std::atomic<uint64_t>& slot = _M_elimination[threadRandom() % EliminationSize]._slot;
+                    TaggedPointer<Node> offer(slot.load(std::memory_order_acquire));
+                    if(CC_NULL == offer.pointer()) return CC_NULL;
+
+                    uint64_t expected = offer.value();
+                    if(slot.compare_exchange_strong(expected, offer.next(CC_NULL).value(),
+                        std::memory_order_acquire, std::memory_order_relaxed)) {
+                        return offer.pointer();
+                    }
+
+                    return CC_NULL;
+                }
+
+                Node* allocate() {
+                    TaggedPointer<Node> head(_M_free.load(std::memory_order_acquire));
+                    while(CC_NULL != head.pointer()) {
+                        Node* next = head.pointer()->_next.load(std::memory_order_relaxed);
+                        uint64_t expected = head.value();
+                        if(_M_free.compare_exchange_weak(expected, head.next(next).value(),
+                            std::memory_order_acquire, std::memory_order_acquire)) {
+                            return head.pointer();
+                        }
+                        head = TaggedPointer<Node>(expected);
+                    }
+
+                    return new Node();
+                }
+
+                void release(Node* node) {
+                    TaggedPointer<Node> head(_M_free.load(std::memory_order_relaxed));
+                    while(true) {
+                        node->_next.store(head.pointer(), std::memory_order_relaxed);
+                        uint64_t expected = head.value();
+                        if(_M_free.compare_exchange_weak(expected, head.next(node).value(),
+                            std::memory_order_release, std::memory_order_relaxed)) {
+                            return;
+                        }
+                        head = TaggedPointer<Node>(expected);
+                    }
+                }
+
+            private:
+                static const int ELIMINATION_SPIN = 64;
+
+                struct alignas(CC_CACHE_LINE_SIZE) EliminationSlot {
+                    std::atomic<uint64_t> _slot;
+                };
+
+                alignas(CC_CACHE_LINE_SIZE) std::atomic<uint64_t> _M_head;
+                alignas(CC_CACHE_LINE_SIZE) std::atomic<uint64_t> _M_free;
+                EliminationSlot _M_elimination[EliminationSize];
+        };
+    } // namespace adt
+} // namespace cclib
+
+#endif //CCLIB_ADT_LOCK_FREE_STACK_H
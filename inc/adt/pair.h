@@ -13,6 +13,7 @@
 #define CCLIB_ADT_PAIR_H
 
 #include "./../../cclib-common/inc/base/common_define.h"
+#include "./../str/writer.h"
 #include <string>
 
 namespace cclib
@@ -32,6 +33,7 @@ namespace cclib
             Pair& operator=(const Pair& instance) {
                 this->_key = instance._key;
                 this->_value = instance._value;
+                return *this;
             }
 
             bool operator==(const Pair& instance) const {
@@ -50,14 +52,38 @@ namespace cclib
                 return this->_key > instance._key;
             }
 
-            // std::string operator<<() {}  //TODO:
-            // std::string operator>>() {}  //TODO:
+            //NOTICE: writer is str::Writer or anything else with operator<< for _Key and _Value
+            template<typename Writer>
+            void dump(Writer& writer) const {
+                writer << "key:" << this->_key << "-value:" << this->_value;
+            }
 
-            //TODO: remove std::string
+            //NOTICE: formats into a stack buffer, the returned string is the only allocation;
+            //a longer dump (a String key, say) is formatted again into a heap buffer that doubles until it fits
             static std::string to_string(const Pair& instance) {
-                return "key:" + std::to_string(instance._key) + "-" + "value:" + std::to_string(instance._value);
+                char buffer[2 * str::FLOAT_CHARS_MAX + 16];
+                str::Writer writer(buffer, sizeof(buffer));
+                instance.dump(writer);
+                if(!writer.overflow()) return std::string(writer.data(), writer.size());
+
+                std::string result(2 * sizeof(buffer), '\0');
+                for(;;) {
+                    str::Writer retry(&result[0], result.size());
+                    instance.dump(retry);
+                    if(!retry.overflow()) {
+                        result.resize(retry.size());
+                        return result;
+                    }
+                    result.resize(2 * result.size());
+                }
             }
         };
+
+        template<typename Writer, typename _Key, typename _Value>
+        Writer& operator<<(Writer& writer, const Pair<_Key, _Value>& instance) {
+            instance.dump(writer);
+            return writer;
+        }
     } // namespace adt
 } // namespace cclib
 
@@ -0,0 +1,335 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Persistent map
+ * an AVL tree whose nodes are never changed after they are built; insert() and erase() copy the O(log n) nodes
+ * on the path to the key and share every other subtree with the old version, which stays valid and unchanged;
+ * nodes are reference counted (atomically), a copy of a PersistentMap is a snapshot in O(1);
+ * AtomicPersistentMap publishes one version to many threads: snapshot() never blocks and never waits for publish(),
+ * the external reference count rides in the tag bits of a TaggedPointer (split reference counting),
+ * so a reader can take the current version while the writer swaps in the next one.
+************************/
+#ifndef CCLIB_ADT_PERSISTENT_MAP_H
+#define CCLIB_ADT_PERSISTENT_MAP_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "concurrent.h"
+
+//NOTICE: a test defines it to stop a thread inside snapshot() or publish(), where the counts are in flight
+#ifndef CCLIB_PERSISTENT_MAP_PAUSE
+#define CCLIB_PERSISTENT_MAP_PAUSE(where)
+#endif
+
+namespace cclib {
+    namespace adt {
+        template<typename Key, typename Value>
+        struct PersistentMapNode {
+            Key _key;
+            Value _value;
+            PersistentMapNode* _leftChild;
+            PersistentMapNode* _rightChild;
+            int _height;
+            std::atomic<long> _refs;
+
+            //NOTICE: takes over one reference of each child
+            PersistentMapNode(const Key& key, const Value& value, PersistentMapNode* leftChild, PersistentMapNode* rightChild):
+             _key(key), _value(value), _leftChild(leftChild), _rightChild(rightChild), _refs(1) {
+                int left = CC_NULL == leftChild ? 0 : leftChild->_height;
+                int right = CC_NULL == rightChild ? 0 : rightChild->_height;
+                _height = (left > right ? left : right) + 1;
+            }
+        };
+
+        template<typename Key, typename Value>
+        class PersistentMap {
+            public:
+                typedef PersistentMapNode<Key, Value> Node;
+
+            public:
+                PersistentMap(): _size(0), _M_root(CC_NULL) {}
+
+                PersistentMap(const PersistentMap& instance): _size(instance._size), _M_root(retain(instance._M_root)) {}
+
+                ~PersistentMap() {
+                    release(_M_root);
+                }
+
+                PersistentMap& operator=(const PersistentMap& instance) {
+                    Node* root = retain(instance._M_root);  //NOTICE: retain first, instance may be this
+                    release(_M_root);
+                    _M_root = root;
+                    _size = instance._size;
+                    return *this;
+                }
+
+            public:
+                cc_size_t size() const {
+                    return _size;
+                }
+
+                bool empty() const {
+                    return 0 == _size;
+                }
+
+                //NOTICE: CC_NULL when key is not in the map, the value lives as long as any version holding it
+                const Value* find(const Key& key) const {
+                    const Node* node = _M_root;
+                    while(CC_NULL != node) {
+                        if(key < node->_key) {
+                            node = node->_leftChild;
+                        } else if(node->_key < key) {
+                            node = node->_rightChild;
+                        } else {
+                            return &node->_value;
+                        }
+                    }
+                    return CC_NULL;
+                }
+
+                bool contains(const Key& key) const {
+                    return CC_NULL != find(key);
+                }
+
+                //NOTICE: a new version with key set to value, this one does not change
+                PersistentMap insert(const Key& key, const Value& value) const {
+                    bool added = false;
+                    Node* root = insert(_M_root, key, value, added);
+                    return PersistentMap(root, added ? _size + 1 : _size);
+                }
+
+                //NOTICE: a new version without key, sharing everything when key is not there
+                PersistentMap erase(const Key& key) const {
+                    if(!contains(key)) return *this;
+                    return PersistentMap(erase(_M_root, key), _size - 1);
+                }
+
+                //NOTICE: calls visitor(key, value) in key order
+                template<typename Visitor>
+                void forEach(Visitor visitor) const {
+                    forEach(_M_root, visitor);
+                }
+
+                //NOTICE: writes the entries in key order as {key: value, ...}
+                template<typename Writer>
+                void dump(Writer& writer) const {
+                    bool first = true;
+                    auto entry = [&writer, &first](const Key& key, const Value& value) {
+                        if(!first) writer << ", ";
+                        writer << key << ": " << value;
+                        first = false;
+                    };
+                    writer << '{';
+                    forEach(_M_root, entry);
+                    writer << '}';
+                }
+
+                //NOTICE: for walking the tree directly, nodes must not be changed
+                const Node* root() const {
+                    return _M_root;
+                }
+
+            private:
+                PersistentMap(Node* root, cc_size_t size): _size(size), _M_root(root) {}
+
+                static int height(const Node* node) {
+                    return CC_NULL == node ? 0 : node->_height;
+                }
+
+                static Node* retain(Node* node) {
+                    if(CC_NULL != node) node->_refs.fetch_add(1, std::memory_order_relaxed);
+                    return node;
+                }
+
+                //NOTICE: frees every node no version holds any more, left subtrees by recursion (O(log n) deep), right ones by the loop
+                static void release(Node* node) {
+                    while(CC_NULL != node && 1 == node->_refs.fetch_sub(1, std::memory_order_acq_rel)) {
+                        Node* left = node->_leftChild;
+                        Node* right = node->_rightChild;
+                        delete node;
+                        release(left);
+                        node = right;
+                    }
+                }
+
+                //NOTICE: builds a node over left and right (their references are taken over) and restores the AVL rule,
+                //a rotation copies the child it lifts, the old child is released and stays intact in the older versions
+                static Node* balance(const Key& key, const Value& value, Node* left, Node* right) {
+                    if(height(left) > height(right) + 1) {
+                        Node* leftLeft = retain(left->_leftChild);
+                        Node* leftRight = retain(left->_rightChild);
+                        Node* result = CC_NULL;
+                        if(height(leftLeft) >= height(leftRight)) {
+                            result = new Node(left->_key, left->_value, leftLeft, new Node(key, value, leftRight, right));
+                        } else {
+                            result = new Node(leftRight->_key, leftRight->_value,
+                                              new Node(left->_key, left->_value, leftLeft, retain(leftRight->_leftChild)),
+                                              new Node(key, value, retain(leftRight->_rightChild), right));
+                            release(leftRight);
+                        }
+                        release(left);
+                        return result;
+                    }
+
+                    if(height(right) > height(left) + 1) {
+                        Node* rightLeft = retain(right->_leftChild);
+                        Node* rightRight = retain(right->_rightChild);
+                        Node* result = CC_NULL;
+                        if(height(rightRight) >= height(rightLeft)) {
+                            result = new Node(right->_key, right->_value, new Node(key, value, left, rightLeft), rightRight);
+                        } else {
+                            result = new Node(rightLeft->_key, rightLeft->_value,
+                                              new Node(key, value, left, retain(rightLeft->_leftChild)),
+                                              new Node(right->_key, right->_value, retain(rightLeft->_rightChild), rightRight));
+                            release(rightLeft);
+                        }
+                        release(right);
+                        return result;
+                    }
+
+                    return new Node(key, value, left, right);
+                }
+
+                //NOTICE: returns a new root holding one reference, node itself is not touched
+                static Node* insert(const Node* node, const Key& key, const Value& value, bool& added) {
+                    if(CC_NULL == node) {
+                        added = true;
+                        return new Node(key, value, CC_NULL, CC_NULL);
+                    }
+
+                    if(key < node->_key) {
+                        return balance(node->_key, node->_value, insert(node->_leftChild, key, value, added), retain(node->_rightChild));
+                    }
+                    if(node->_key < key) {
+                        return balance(node->_key, node->_value, retain(node->_leftChild), insert(node->_rightChild, key, value, added));
+                    }
+                    return new Node(key, value, retain(node->_leftChild), retain(node->_rightChild));   //NOTICE: same key, new value
+                }
+
+                static Node* eraseMin(const Node* node, const Node*& min) {
+                    if(CC_NULL == node->_leftChild) {
+                        min = node;
+                        return retain(node->_rightChild);
+                    }
+                    return balance(node->_key, node->_value, eraseMin(node->_leftChild, min), retain(node->_rightChild));
+                }
+
+                //NOTICE: key must be in the tree
+                static Node* erase(const Node* node, const Key& key) {
+                    if(key < node->_key) {
+                        return balance(node->_key, node->_value, erase(node->_leftChild, key), retain(node->_rightChild));
+                    }
+                    if(node->_key < key) {
+                        return balance(node->_key, node->_value, retain(node->_leftChild), erase(node->_rightChild, key));
+                    }
+
+                    if(CC_NULL == node->_leftChild) return retain(node->_rightChild);
+                    if(CC_NULL == node->_rightChild) return retain(node->_leftChild);
+
+                    const Node* min = CC_NULL;   //NOTICE: stays alive, the old version still holds it
+                    Node* right = eraseMin(node->_rightChild, min);
+                    return balance(min->_key, min->_value, retain(node->_leftChild), right);
+                }
+
+                template<typename Visitor>
+                static void forEach(const Node* node, Visitor& visitor) {
+                    while(CC_NULL != node) {
+                        forEach(node->_leftChild, visitor);
+                        visitor(node->_key, node->_value);
+                        node = node->_rightChild;
+                    }
+                }
+
+            private:
+                cc_size_t _size;
+                Node* _M_root;
+        };
+
+        //NOTICE: one published version; readers take it with snapshot() without locks, a writer replaces it with publish();
+        //writers do not coordinate with each other, two racing publish() calls keep only the later one
+        template<typename Key, typename Value>
+        class AtomicPersistentMap {
+            public:
+                typedef PersistentMap<Key, Value> Map;
+
+            public:
+                AtomicPersistentMap(): _M_current(TaggedPointer<Version>(new Version(Map()), 0).value()) {}
+
+                explicit AtomicPersistentMap(const Map& map): _M_current(TaggedPointer<Version>(new Version(map), 0).value()) {}
+
+                ~AtomicPersistentMap() {
+                    TaggedPointer<Version> current(_M_current.load(std::memory_order_acquire));
+                    releaseVersion(current.pointer(), (long)current.tag());
+                }
+
+            private:
+                AtomicPersistentMap(const AtomicPersistentMap& instance);
+                AtomicPersistentMap& operator=(const AtomicPersistentMap& instance);
+
+            public:
+                //NOTICE: lock-free; the tag counts readers between the fetch_add and the hand back,
+                //they keep the version alive while they copy its root
+                Map snapshot() const {
+                    TaggedPointer<Version> borrowed(_M_current.fetch_add(ONE_READER, std::memory_order_acq_rel));
+                    Version* version = borrowed.pointer();
+                    Map result(version->_map);
+                    CCLIB_PERSISTENT_MAP_PAUSE("snapshot");
+
+                    uint64_t current = _M_current.load(std::memory_order_acquire);
+                    for(;;) {
+                        if(TaggedPointer<Version>(current).pointer() != version) {
+                            //COMMENT: publish() moved our count onto the version, give it back there
+                            releaseVersion(version, -1);
+                            break;
+                        }
+                        if(_M_current.compare_exchange_weak(current, current - ONE_READER, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                            break;
+                        }
+                    }
+                    return result;
+                }
+
+                //NOTICE: the next snapshot() sees map, snapshots taken before keep the old version
+                void publish(const Map& map) {
+                    Version* version = new Version(map);
+                    TaggedPointer<Version> old(_M_current.exchange(TaggedPointer<Version>(version, 0).value(), std::memory_order_acq_rel));
+                    CCLIB_PERSISTENT_MAP_PAUSE("publish");
+                    //NOTICE: the readers still inside snapshot() move onto the internal count, the holder's own reference left with the exchange;
+                    //their -1 may land before this, the count then goes below zero and only comes back to zero once both sides are done
+                    releaseVersion(old.pointer(), (long)old.tag());
+                }
+
+            private:
+                //NOTICE: a new Version on every publish(), its address can not come back while a reader still holds a count on it;
+                //_refs is the internal count, 0 while the version is current: the readers in flight are counted in the tag
+                struct Version {
+                    Map _map;
+                    std::atomic<long> _refs;
+
+                    explicit Version(const Map& map): _map(map), _refs(0) {}
+                };
+
+                //NOTICE: the one that brings the internal count to zero deletes, a transfer of zero readers included
+                static void releaseVersion(Version* version, long delta) {
+                    if(-delta == version->_refs.fetch_add(delta, std::memory_order_acq_rel)) {
+                        delete version;
+                    }
+                }
+
+            private:
+                static const uint64_t ONE_READER = (uint64_t)1 << 48;
+
+                mutable std::atomic<uint64_t> _M_current;
+        };
+    }   //namespace adt
+}   //namespace cclib
+
+#endif //CCLIB_ADT_PERSISTENT_MAP_H
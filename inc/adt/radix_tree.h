@@ -0,0 +1,722 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Adaptive radix tree (Leis, Kemper and Neumann, ART)
+ * a trie over the bytes of the key, one byte per level, so a lookup costs O(key length) and no key comparisons;
+ * inner nodes come in four sizes (4, 16, 48 and 256 children) and grow or shrink with their fan-out;
+ * a chain of one-child nodes is compressed into a prefix of the next node, only the first RADIX_PREFIX bytes are stored,
+ * the rest is skipped on the way down and checked against the full key kept in the leaf (hybrid path compression);
+ * a key that ends inside the tree ("ab" next to "abc") hangs in the end slot of its inner node;
+ * children are kept in byte order, forEach() and scanPrefix() visit keys in lexicographic (memcmp) order.
+************************/
+#ifndef CCLIB_ADT_RADIX_TREE_H
+#define CCLIB_ADT_RADIX_TREE_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "./../str/string_view.h"
+#include <stdint.h>
+#include <string.h>
+#include <new>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace cclib {
+    namespace adt {
+        enum RadixNodeType {EN_RadixLeaf, EN_RadixNode4, EN_RadixNode16, EN_RadixNode48, EN_RadixNode256};
+
+        static const cc_size_t RADIX_PREFIX = 8;
+
+        struct RadixNode {
+            uint8_t _type;
+
+            explicit RadixNode(uint8_t type): _type(type) {}
+        };
+
+        //NOTICE: the key bytes follow the leaf in the same allocation
+        template<typename Value>
+        struct RadixLeaf: public RadixNode {
+            Value _value;
+            cc_size_t _length;
+
+            RadixLeaf(const Value& value, cc_size_t length): RadixNode(EN_RadixLeaf), _value(value), _length(length) {}
+
+            char* key() {
+                return reinterpret_cast<char*>(this + 1);
+            }
+
+            const char* key() const {
+                return reinterpret_cast<const char*>(this + 1);
+            }
+        };
+
+        struct RadixInner: public RadixNode {
+            uint16_t _count;
+            uint32_t _prefixLength;
+            unsigned char _prefix[RADIX_PREFIX];
+            RadixNode* _M_leaf;     //NOTICE: the key that ends right after the prefix, if any
+
+            explicit RadixInner(uint8_t type): RadixNode(type), _count(0), _prefixLength(0), _M_leaf(CC_NULL) {}
+        };
+
+        //NOTICE: _keys sorted, the children at the same positions
+        struct RadixNode4: public RadixInner {
+            unsigned char _keys[4];
+            RadixNode* _M_children[4];
+
+            RadixNode4(): RadixInner(EN_RadixNode4) {}
+        };
+
+        struct RadixNode16: public RadixInner {
+            unsigned char _keys[16];
+            RadixNode* _M_children[16];
+
+            RadixNode16(): RadixInner(EN_RadixNode16) {}
+        };
+
+        //NOTICE: _index maps a byte to its child position plus one, 0 is no child
+        struct RadixNode48: public RadixInner {
+            unsigned char _index[256];
+            RadixNode* _M_children[48];
+
+            RadixNode48(): RadixInner(EN_RadixNode48) {
+                memset(_index, 0, sizeof(_index));
+                memset(_M_children, 0, sizeof(_M_children));
+            }
+        };
+
+        struct RadixNode256: public RadixInner {
+            RadixNode* _M_children[256];
+
+            RadixNode256(): RadixInner(EN_RadixNode256) {
+                memset(_M_children, 0, sizeof(_M_children));
+            }
+        };
+
+        template<typename Value>
+        class RadixTree {
+            public:
+                typedef RadixLeaf<Value> Leaf;
+
+            public:
+                RadixTree(): _size(0), _M_root(CC_NULL) {}
+                ~RadixTree() {
+                    clear();
+                }
+
+            private:
+                RadixTree(const RadixTree& instance);
+                RadixTree& operator=(const RadixTree& instance);
+
+            public:
+                cc_size_t size() const {
+                    return _size;
+                }
+
+                bool empty() const {
+                    return 0 == _size;
+                }
+
+                bool clear() {
+                    destroy(_M_root);
+                    _M_root = CC_NULL;
+                    _size = 0;
+                    return true;
+                }
+
+                //NOTICE: CC_NULL when key is not in the tree
+                Value* find(const str::StringView& key) {
+                    return const_cast<Value*>(static_cast<const RadixTree*>(this)->find(key));
+                }
+
+                const Value* find(const str::StringView& key) const {
+                    RadixNode* node = _M_root;
+                    cc_size_t depth = 0;
+                    while(CC_NULL != node) {
+                        if(EN_RadixLeaf == node->_type) {
+                            const Leaf* leaf = static_cast<const Leaf*>(node);
+                            return matches(leaf, key) ? &leaf->_value : CC_NULL;
+                        }
+
+                        RadixInner* inner = static_cast<RadixInner*>(node);
+                        if(!prefixMatches(inner, key, depth)) return CC_NULL;
+                        depth += inner->_prefixLength;
+                        if(depth >= key.size()) {
+                            node = depth == key.size() ? inner->_M_leaf : CC_NULL;
+                            continue;
+                        }
+
+                        RadixNode** child = findChild(inner, key[depth]);
+                        node = CC_NULL == child ? CC_NULL : *child;
+                        ++depth;
+                    }
+                    return CC_NULL;
+                }
+
+                bool contains(const str::StringView& key) const {
+                    return CC_NULL != find(key);
+                }
+
+                //NOTICE: true when key is new, an existing key gets the new value
+                bool insert(const str::StringView& key, const Value& value) {
+                    bool added = insert(_M_root, key, value, 0);
+                    if(added) ++_size;
+                    return added;
+                }
+
+                bool erase(const str::StringView& key) {
+                    bool removed = erase(_M_root, key, 0);
+                    if(removed) --_size;
+                    return removed;
+                }
+
+                //NOTICE: calls visitor(key, value) for every key in byte order, key is a StringView into the leaf
+                template<typename Visitor>
+                void forEach(Visitor visitor) const {
+                    forEach(_M_root, visitor);
+                }
+
+                //NOTICE: calls visitor(key, value) in byte order for the keys starting with prefix, returns how many;
+                //one descent to the subtree of prefix, then a walk of that subtree only
+                template<typename Visitor>
+                cc_size_t scanPrefix(const str::StringView& prefix, Visitor visitor) const {
+                    RadixNode* node = _M_root;
+                    cc_size_t depth = 0;
+                    while(CC_NULL != node && EN_RadixLeaf != node->_type) {
+                        RadixInner* inner = static_cast<RadixInner*>(node);
+                        if(!prefixMatches(inner, prefix, depth)) return 0;
+                        if(depth + inner->_prefixLength >= prefix.size()) break;   //NOTICE: every key below starts the same way
+
+                        depth += inner->_prefixLength;
+                        RadixNode** child = findChild(inner, prefix[depth]);
+                        node = CC_NULL == child ? CC_NULL : *child;
+                        ++depth;
+                    }
+                    if(CC_NULL == node) return 0;
+
+                    //COMMENT: the skipped prefix bytes are only known from a leaf, one check covers the whole subtree
+                    const Leaf* first = minimum(node);
+                    if(first->_length < prefix.size() || 0 != memcmp(first->key(), prefix.data(), prefix.size())) return 0;
+                    cc_size_t count = 0;
+                    auto counted = [&visitor, &count](const str::StringView& key, const Value& value) {
+                        visitor(key, value);
+                        ++count;
+                    };
+                    forEach(node, counted);
+                    return count;
+                }
+
+                //NOTICE: writes the entries in key order as {key: value, ...}
+                template<typename Writer>
+                void dump(Writer& writer) const {
+                    bool first = true;
+                    auto entry = [&writer, &first](const str::StringView& key, const Value& value) {
+                        if(!first) writer << ", ";
+                        writer << key << ": " << value;
+                        first = false;
+                    };
+                    writer << '{';
+                    forEach(_M_root, entry);
+                    writer << '}';
+                }
+
+            private:
+                static bool matches(const Leaf* leaf, const str::StringView& key) {
+                    return leaf->_length == key.size() && 0 == memcmp(leaf->key(), key.data(), key.size());
+                }
+
+                static Leaf* makeLeaf(const str::StringView& key, const Value& value) {
+                    void* memory = ::operator new(sizeof(Leaf) + key.size());
+                    Leaf* leaf = new(memory) Leaf(value, key.size());
+                    memcpy(leaf->key(), key.data(), key.size());
+                    return leaf;
+                }
+
+                static void freeLeaf(Leaf* leaf) {
+                    leaf->~Leaf();
+                    ::operator delete(leaf);
+                }
+
+                static void freeInner(RadixInner* inner) {
+                    switch(inner->_type) {
+                        case EN_RadixNode4: delete static_cast<RadixNode4*>(inner); break;
+                        case EN_RadixNode16: delete static_cast<RadixNode16*>(inner); break;
+                        case EN_RadixNode48: delete static_cast<RadixNode48*>(inner); break;
+                        default: delete static_cast<RadixNode256*>(inner); break;
+                    }
+                }
+
+                static void destroy(RadixNode* node) {
+                    if(CC_NULL == node) return;
+                    if(EN_RadixLeaf == node->_type) {
+                        freeLeaf(static_cast<Leaf*>(node));
+                        return;
+                    }
+
+                    RadixInner* inner = static_cast<RadixInner*>(node);
+                    destroy(inner->_M_leaf);
+                    forEachChild(inner, [](unsigned char, RadixNode* child) { destroy(child); });
+                    freeInner(inner);
+                }
+
+                //NOTICE: calls function(byte, child) in byte order
+                template<typename Function>
+                static void forEachChild(RadixInner* inner, Function function) {
+                    switch(inner->_type) {
+                        case EN_RadixNode4: {
+                            RadixNode4* node = static_cast<RadixNode4*>(inner);
+                            for(cc_size_t i = 0; i < node->_count; i++) function(node->_keys[i], node->_M_children[i]);
+                            break;
+                        }
+                        case EN_RadixNode16: {
+                            RadixNode16* node = static_cast<RadixNode16*>(inner);
+                            for(cc_size_t i = 0; i < node->_count; i++) function(node->_keys[i], node->_M_children[i]);
+                            break;
+                        }
+                        case EN_RadixNode48: {
+                            RadixNode48* node = static_cast<RadixNode48*>(inner);
+                            for(cc_size_t i = 0; i < 256; i++) {
+                                if(0 != node->_index[i]) function((unsigned char)i, node->_M_children[node->_index[i] - 1]);
+                            }
+                            break;
+                        }
+                        default: {
+                            RadixNode256* node = static_cast<RadixNode256*>(inner);
+                            for(cc_size_t i = 0; i < 256; i++) {
+                                if(CC_NULL != node->_M_children[i]) function((unsigned char)i, node->_M_children[i]);
+                            }
+                            break;
+                        }
+                    }
+                }
+
+                template<typename Visitor>
+                static void forEach(const RadixNode* node, Visitor& visitor) {
+                    if(CC_NULL == node) return;
+                    if(EN_RadixLeaf == node->_type) {
+                        const Leaf* leaf = static_cast<const Leaf*>(node);
+                        visitor(str::StringView(leaf->key(), leaf->_length), leaf->_value);
+                        return;
+                    }
+
+                    RadixInner* inner = const_cast<RadixInner*>(static_cast<const RadixInner*>(node));
+                    forEach(inner->_M_leaf, visitor);   //NOTICE: the shorter key comes first
+                    forEachChild(inner, [&visitor](unsigned char, RadixNode* child) { forEach(child, visitor); });
+                }
+
+                //NOTICE: the smallest key below node, the end slot before any child
+                static const Leaf* minimum(const RadixNode* node) {
+                    while(EN_RadixLeaf != node->_type) {
+                        const RadixInner* inner = static_cast<const RadixInner*>(node);
+                        if(CC_NULL != inner->_M_leaf) {
+                            node = inner->_M_leaf;
+                            continue;
+                        }
+                        switch(inner->_type) {
+                            case EN_RadixNode4: node = static_cast<const RadixNode4*>(inner)->_M_children[0]; break;
+                            case EN_RadixNode16: node = static_cast<const RadixNode16*>(inner)->_M_children[0]; break;
+                            case EN_RadixNode48: {
+                                const RadixNode48* node48 = static_cast<const RadixNode48*>(inner);
+                                cc_size_t i = 0;
+                                while(0 == node48->_index[i]) ++i;
+                                node = node48->_M_children[node48->_index[i] - 1];
+                                break;
+                            }
+                            default: {
+                                const RadixNode256* node256 = static_cast<const RadixNode256*>(inner);
+                                cc_size_t i = 0;
+                                while(CC_NULL == node256->_M_children[i]) ++i;
+                                node = node256->_M_children[i];
+                                break;
+                            }
+                        }
+                    }
+                    return static_cast<const Leaf*>(node);
+                }
+
+                static RadixNode** findChild(RadixInner* inner, char ch) {
+                    unsigned char byte = (unsigned char)ch;
+                    switch(inner->_type) {
+                        case EN_RadixNode4: {
+                            RadixNode4* node = static_cast<RadixNode4*>(inner);
+                            for(cc_size_t i = 0; i < node->_count; i++) {
+                                if(byte == node->_keys[i]) return &node->_M_children[i];
+                            }
+                            return CC_NULL;
+                        }
+                        case EN_RadixNode16: {
+                            RadixNode16* node = static_cast<RadixNode16*>(inner);
+                            #if defined(__SSE2__)
+                            //COMMENT: all 16 keys in one compare, the mask drops the unused tail
+                            __m128i equal = _mm_cmpeq_epi8(_mm_set1_epi8(ch), _mm_loadu_si128((const __m128i*)node->_keys));
+                            unsigned int mask = (unsigned int)_mm_movemask_epi8(equal) & ((1u << node->_count) - 1);
+                            return 0 == mask ? CC_NULL : &node->_M_children[__builtin_ctz(mask)];
+                            #else
+                            for(cc_size_t i = 0; i < node->_count; i++) {
+                                if(byte == node->_keys[i]) return &node->_M_children[i];
+                            }
+                            return CC_NULL;
+                            #endif
+                        }
+                        case EN_RadixNode48: {
+                            RadixNode48* node = static_cast<RadixNode48*>(inner);
+                            return 0 == node->_index[byte] ? CC_NULL : &node->_M_children[node->_index[byte] - 1];
+                        }
+                        default: {
+                            RadixNode256* node = static_cast<RadixNode256*>(inner);
+                            return CC_NULL == node->_M_children[byte] ? CC_NULL : &node->_M_children[byte];
+                        }
+                    }
+                }
+
+                //NOTICE: only the stored bytes are compared, a longer prefix is checked at the leaf;
+                //true when key runs out inside the stored bytes, the caller checks the length itself
+                static bool prefixMatches(const RadixInner* inner, const str::StringView& key, cc_size_t depth) {
+                    cc_size_t stored = inner->_prefixLength < RADIX_PREFIX ? inner->_prefixLength : RADIX_PREFIX;
+                    for(cc_size_t i = 0; i < stored && depth + i < key.size(); i++) {
+                        if(inner->_prefix[i] != (unsigned char)key[depth + i]) return false;
+                    }
+                    return true;
+                }
+
+                //NOTICE: length of the common part of the node prefix and key from depth, the full prefix comes from a leaf when it is long
+                static cc_size_t prefixMismatch(const RadixInner* inner, const str::StringView& key, cc_size_t depth) {
+                    cc_size_t limit = key.size() - depth;
+                    if(inner->_prefixLength < limit) limit = inner->_prefixLength;
+
+                    cc_size_t stored = limit < RADIX_PREFIX ? limit : RADIX_PREFIX;
+                    cc_size_t i = 0;
+                    for(; i < stored; i++) {
+                        if(inner->_prefix[i] != (unsigned char)key[depth + i]) return i;
+                    }
+                    if(i < limit) {
+                        const Leaf* leaf = minimum(inner);
+                        for(; i < limit; i++) {
+                            if(leaf->key()[depth + i] != key[depth + i]) return i;
+                        }
+                    }
+                    return i;
+                }
+
+                static void setPrefix(RadixInner* inner, const char* prefix, cc_size_t length) {
+                    inner->_prefixLength = (uint32_t)length;
+                    memcpy(inner->_prefix, prefix, length < RADIX_PREFIX ? length : RADIX_PREFIX);
+                }
+
+                static void copyHeader(RadixInner* to, const RadixInner* from) {
+                    to->_count = from->_count;
+                    to->_prefixLength = from->_prefixLength;
+                    memcpy(to->_prefix, from->_prefix, RADIX_PREFIX);
+                    to->_M_leaf = from->_M_leaf;
+                }
+
+                //NOTICE: slot points at inner and is replaced when inner has to grow
+                static void addChild(RadixNode*& slot, unsigned char byte, RadixNode* child) {
+                    RadixInner* inner = static_cast<RadixInner*>(slot);
+                    switch(inner->_type) {
+                        case EN_RadixNode4: {
+                            RadixNode4* node = static_cast<RadixNode4*>(inner);
+                            if(node->_count < 4) {
+                                insertSorted(node->_keys, node->_M_children, node->_count, byte, child);
+                                return;
+                            }
+                            RadixNode16* grown = new RadixNode16();
+                            copyHeader(grown, node);
+                            memcpy(grown->_keys, node->_keys, 4);
+                            memcpy(grown->_M_children, node->_M_children, 4 * sizeof(RadixNode*));
+                            delete node;
+                            slot = grown;
+                            insertSorted(grown->_keys, grown->_M_children, grown->_count, byte, child);
+                            return;
+                        }
+                        case EN_RadixNode16: {
+                            RadixNode16* node = static_cast<RadixNode16*>(inner);
+                            if(node->_count < 16) {
+                                insertSorted(node->_keys, node->_M_children, node->_count, byte, child);
+                                return;
+                            }
+                            RadixNode48* grown = new RadixNode48();
+                            copyHeader(grown, node);
+                            for(cc_size_t i = 0; i < 16; i++) {
+                                grown->_index[node->_keys[i]] = (unsigned char)(i + 1);
+                                grown->_M_children[i] = node->_M_children[i];
+                            }
+                            delete node;
+                            slot = grown;
+                            addChild(slot, byte, child);
+                            return;
+                        }
+                        case EN_RadixNode48: {
+                            RadixNode48* node = static_cast<RadixNode48*>(inner);
+                            if(node->_count < 48) {
+                                cc_size_t free = 0;
+                                while(CC_NULL != node->_M_children[free]) ++free;
+                                node->_M_children[free] = child;
+                                node->_index[byte] = (unsigned char)(free + 1);
+                                ++node->_count;
+                                return;
+                            }
+                            RadixNode256* grown = new RadixNode256();
+                            copyHeader(grown, node);
+                            for(cc_size_t i = 0; i < 256; i++) {
+                                if(0 != node->_index[i]) grown->_M_children[i] = node->_M_children[node->_index[i] - 1];
+                            }
+                            delete node;
+                            slot = grown;
+                            addChild(slot, byte, child);
+                            return;
+                        }
+                        default: {
+                            RadixNode256* node = static_cast<RadixNode256*>(inner);
+                            node->_M_children[byte] = child;
+                            ++node->_count;
+                            return;
+                        }
+                    }
+                }
+
+                static void insertSorted(unsigned char* keys, RadixNode** children, uint16_t& count, unsigned char byte, RadixNode* child) {
+                    cc_size_t position = count;
+                    while(position > 0 && keys[position - 1] > byte) {
+                        keys[position] = keys[position - 1];
+                        children[position] = children[position - 1];
+                        --position;
+                    }
+                    keys[position] = byte;
+                    children[position] = child;
+                    ++count;
+                }
+
+                //NOTICE: puts leaf under the fresh inner node, into the end slot when its key ends at depth
+                static void addLeaf(RadixNode*& slot, Leaf* leaf, cc_size_t depth) {
+                    if(leaf->_length == depth) {
+                        static_cast<RadixInner*>(slot)->_M_leaf = leaf;
+                    } else {
+                        addChild(slot, (unsigned char)leaf->key()[depth], leaf);
+                    }
+                }
+
+                static bool insert(RadixNode*& slot, const str::StringView& key, const Value& value, cc_size_t depth) {
+                    if(CC_NULL == slot) {
+                        slot = makeLeaf(key, value);
+                        return true;
+                    }
+
+                    if(EN_RadixLeaf == slot->_type) {
+                        Leaf* leaf = static_cast<Leaf*>(slot);
+                        if(matches(leaf, key)) {
+                            leaf->_value = value;
+                            return false;
+                        }
+
+                        //COMMENT: two keys, one node holding their common part as its prefix
+                        cc_size_t limit = (leaf->_length < key.size() ? leaf->_length : key.size()) - depth;
+                        cc_size_t common = 0;
+                        while(common < limit && leaf->key()[depth + common] == key[depth + common]) ++common;
+                        RadixNode4* node = new RadixNode4();
+                        setPrefix(node, key.data() + depth, common);
+                        slot = node;
+                        addLeaf(slot, leaf, depth + common);
+                        addLeaf(slot, makeLeaf(key, value), depth + common);
+                        return true;
+                    }
+
+                    RadixInner* inner = static_cast<RadixInner*>(slot);
+                    if(0 != inner->_prefixLength) {
+                        cc_size_t mismatch = prefixMismatch(inner, key, depth);
+                        if(mismatch < inner->_prefixLength) {
+                            //COMMENT: key leaves the prefix, a new node takes the common part and inner keeps the rest
+                            RadixNode4* parent = new RadixNode4();
+                            setPrefix(parent, key.data() + depth, mismatch);
+                            unsigned char byte = 0;
+                            if(inner->_prefixLength <= RADIX_PREFIX) {
+                                byte = inner->_prefix[mismatch];
+                                inner->_prefixLength -= (uint32_t)(mismatch + 1);
+                                memmove(inner->_prefix, inner->_prefix + mismatch + 1, inner->_prefixLength);
+                            } else {
+                                const Leaf* first = minimum(inner);
+                                byte = (unsigned char)first->key()[depth + mismatch];
+                                inner->_prefixLength -= (uint32_t)(mismatch + 1);
+                                cc_size_t stored = inner->_prefixLength < RADIX_PREFIX ? inner->_prefixLength : RADIX_PREFIX;
+                                memcpy(inner->_prefix, first->key() + depth + mismatch + 1, stored);
+                            }
+                            slot = parent;
+                            addChild(slot, byte, inner);
+                            addLeaf(slot, makeLeaf(key, value), depth + mismatch);
+                            return true;
+                        }
+                        depth += inner->_prefixLength;
+                    }
+
+                    if(depth == key.size()) {
+                        if(CC_NULL != inner->_M_leaf) {
+                            static_cast<Leaf*>(inner->_M_leaf)->_value = value;
+                            return false;
+                        }
+                        inner->_M_leaf = makeLeaf(key, value);
+                        return true;
+                    }
+
+                    RadixNode** child = findChild(inner, key[depth]);
+                    if(CC_NULL != child) return insert(*child, key, value, depth + 1);
+
+                    addChild(slot, (unsigned char)key[depth], makeLeaf(key, value));
+                    return true;
+                }
+
+                static void removeChild(RadixNode*& slot, unsigned char byte) {
+                    RadixInner* inner = static_cast<RadixInner*>(slot);
+                    switch(inner->_type) {
+                        case EN_RadixNode4:
+                        case EN_RadixNode16: {
+                            unsigned char* keys = EN_RadixNode4 == inner->_type ? static_cast<RadixNode4*>(inner)->_keys : static_cast<RadixNode16*>(inner)->_keys;
+                            RadixNode** children = EN_RadixNode4 == inner->_type ? static_cast<RadixNode4*>(inner)->_M_children : static_cast<RadixNode16*>(inner)->_M_children;
+                            cc_size_t position = 0;
+                            while(keys[position] != byte) ++position;
+                            for(; position + 1 < inner->_count; position++) {
+                                keys[position] = keys[position + 1];
+                                children[position] = children[position + 1];
+                            }
+                            break;
+                        }
+                        case EN_RadixNode48: {
+                            RadixNode48* node = static_cast<RadixNode48*>(inner);
+                            node->_M_children[node->_index[byte] - 1] = CC_NULL;
+                            node->_index[byte] = 0;
+                            break;
+                        }
+                        default:
+                            static_cast<RadixNode256*>(inner)->_M_children[byte] = CC_NULL;
+                            break;
+                    }
+                    --inner->_count;
+                    shrink(slot);
+                }
+
+                //NOTICE: moves inner to the next smaller node once it is well below its size (with some slack against flapping),
+                //a node left with one entry is replaced by that entry
+                static void shrink(RadixNode*& slot) {
+                    RadixInner* inner = static_cast<RadixInner*>(slot);
+                    switch(inner->_type) {
+                        case EN_RadixNode4:
+                            if(inner->_count + (CC_NULL == inner->_M_leaf ? 0 : 1) == 1) collapse(slot);
+                            return;
+                        case EN_RadixNode16: {
+                            if(inner->_count > 3) return;
+                            RadixNode16* node = static_cast<RadixNode16*>(inner);
+                            RadixNode4* smaller = new RadixNode4();
+                            copyHeader(smaller, node);
+                            memcpy(smaller->_keys, node->_keys, node->_count);
+                            memcpy(smaller->_M_children, node->_M_children, node->_count * sizeof(RadixNode*));
+                            delete node;
+                            slot = smaller;
+                            return;
+                        }
+                        case EN_RadixNode48: {
+                            if(inner->_count > 12) return;
+                            RadixNode48* node = static_cast<RadixNode48*>(inner);
+                            RadixNode16* smaller = new RadixNode16();
+                            copyHeader(smaller, node);
+                            cc_size_t position = 0;
+                            for(cc_size_t i = 0; i < 256; i++) {
+                                if(0 == node->_index[i]) continue;
+                                smaller->_keys[position] = (unsigned char)i;
+                                smaller->_M_children[position++] = node->_M_children[node->_index[i] - 1];
+                            }
+                            delete node;
+                            slot = smaller;
+                            return;
+                        }
+                        default: {
+                            if(inner->_count > 37) return;
+                            RadixNode256* node = static_cast<RadixNode256*>(inner);
+                            RadixNode48* smaller = new RadixNode48();
+                            copyHeader(smaller, node);
+                            cc_size_t position = 0;
+                            for(cc_size_t i = 0; i < 256; i++) {
+                                if(CC_NULL == node->_M_children[i]) continue;
+                                smaller->_index[i] = (unsigned char)(position + 1);
+                                smaller->_M_children[position++] = node->_M_children[i];
+                            }
+                            delete node;
+                            slot = smaller;
+                            return;
+                        }
+                    }
+                }
+
+                //NOTICE: a node4 with a single entry; a leaf takes its place, an inner child takes it over with the prefixes joined
+                static void collapse(RadixNode*& slot) {
+                    RadixNode4* node = static_cast<RadixNode4*>(slot);
+                    if(CC_NULL != node->_M_leaf) {
+                        slot = node->_M_leaf;
+                        delete node;
+                        return;
+                    }
+
+                    RadixNode* child = node->_M_children[0];
+                    if(EN_RadixLeaf != child->_type) {
+                        RadixInner* inner = static_cast<RadixInner*>(child);
+                        unsigned char prefix[RADIX_PREFIX];
+                        cc_size_t length = node->_prefixLength < RADIX_PREFIX ? node->_prefixLength : RADIX_PREFIX;
+                        memcpy(prefix, node->_prefix, length);
+                        if(length < RADIX_PREFIX) prefix[length++] = node->_keys[0];
+                        for(cc_size_t i = 0; length < RADIX_PREFIX && i < inner->_prefixLength; i++) prefix[length++] = inner->_prefix[i];
+
+                        memcpy(inner->_prefix, prefix, length);
+                        inner->_prefixLength += node->_prefixLength + 1;
+                    }
+                    slot = child;
+                    delete node;
+                }
+
+                static bool erase(RadixNode*& slot, const str::StringView& key, cc_size_t depth) {
+                    if(CC_NULL == slot) return false;
+                    if(EN_RadixLeaf == slot->_type) {
+                        if(!matches(static_cast<Leaf*>(slot), key)) return false;
+                        freeLeaf(static_cast<Leaf*>(slot));
+                        slot = CC_NULL;     //NOTICE: only the root is a bare leaf
+                        return true;
+                    }
+
+                    RadixInner* inner = static_cast<RadixInner*>(slot);
+                    if(!prefixMatches(inner, key, depth)) return false;
+                    depth += inner->_prefixLength;
+                    if(depth > key.size()) return false;
+
+                    if(depth == key.size()) {
+                        if(CC_NULL == inner->_M_leaf || !matches(static_cast<Leaf*>(inner->_M_leaf), key)) return false;
+                        freeLeaf(static_cast<Leaf*>(inner->_M_leaf));
+                        inner->_M_leaf = CC_NULL;
+                        shrink(slot);
+                        return true;
+                    }
+
+                    RadixNode** child = findChild(inner, key[depth]);
+                    if(CC_NULL == child) return false;
+                    if(EN_RadixLeaf != (*child)->_type) return erase(*child, key, depth + 1);
+
+                    if(!matches(static_cast<Leaf*>(*child), key)) return false;
+                    freeLeaf(static_cast<Leaf*>(*child));
+                    removeChild(slot, (unsigned char)key[depth]);
+                    return true;
+                }
+
+            private:
+                cc_size_t _size;
+                RadixNode* _M_root;
+        };
+    }   //namespace adt
+}   //namespace cclib
+
+#endif //CCLIB_ADT_RADIX_TREE_H
@@ -0,0 +1,232 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Segment tree with lazy range updates (iterative, bottom up)
+ * range queries and range updates in O(log n) over flat arrays, no recursion:
+ * node i has children 2i and 2i + 1, the leaves are nodes n..2n-1, n rounded up to a power of two
+ * (padding leaves hold the identity) so every node covers exactly n >> level leaves;
+ * an update fully covering a node changes the node and parks the update in the node's lazy slot,
+ * the parked updates on a path are pushed down before the path is read or changed, the path is rebuilt afterwards;
+ * the operators are a policy, Operation must provide:
+ *   typedef Value, typedef Update,
+ *   Value identity(), Value combine(a, b) (associative),
+ *   Update noUpdate(), Update compose(newer, older), Value apply(value, update, length of the node);
+ * SegmentSumAdd, SegmentMinAdd and SegmentMaxAdd are the usual ones: range add with range sum, min or max.
+************************/
+#ifndef CCLIB_ADT_SEGMENT_TREE_H
+#define CCLIB_ADT_SEGMENT_TREE_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "vector.h"
+#include <limits>
+
+namespace cclib {
+    namespace adt {
+        template<typename T>
+        struct SegmentSumAdd {
+            typedef T Value;
+            typedef T Update;
+
+            static Value identity() {
+                return T();
+            }
+
+            static Value combine(const Value& left, const Value& right) {
+                return left + right;
+            }
+
+            static Update noUpdate() {
+                return T();
+            }
+
+            static Update compose(const Update& newer, const Update& older) {
+                return newer + older;
+            }
+
+            static Value apply(const Value& value, const Update& update, cc_size_t length) {
+                return value + update * (T)length;
+            }
+        };
+
+        template<typename T>
+        struct SegmentMinAdd {
+            typedef T Value;
+            typedef T Update;
+
+            static Value identity() {
+                return std::numeric_limits<T>::max();
+            }
+
+            static Value combine(const Value& left, const Value& right) {
+                return right < left ? right : left;
+            }
+
+            static Update noUpdate() {
+                return T();
+            }
+
+            static Update compose(const Update& newer, const Update& older) {
+                return newer + older;
+            }
+
+            //NOTICE: a node holding the identity covers padding only, it never gets an update
+            static Value apply(const Value& value, const Update& update, cc_size_t) {
+                return value + update;
+            }
+        };
+
+        template<typename T>
+        struct SegmentMaxAdd {
+            typedef T Value;
+            typedef T Update;
+
+            static Value identity() {
+                return std::numeric_limits<T>::lowest();
+            }
+
+            static Value combine(const Value& left, const Value& right) {
+                return left < right ? right : left;
+            }
+
+            static Update noUpdate() {
+                return T();
+            }
+
+            static Update compose(const Update& newer, const Update& older) {
+                return newer + older;
+            }
+
+            static Value apply(const Value& value, const Update& update, cc_size_t) {
+                return value + update;
+            }
+        };
+
+        template<typename Operation>
+        class SegmentTree {
+            public:
+                typedef typename Operation::Value Value;
+                typedef typename Operation::Update Update;
+
+            public:
+                //NOTICE: size values, all the identity
+                explicit SegmentTree(cc_size_t size = 0) {
+                    allocate(size);
+                }
+
+                //NOTICE: O(n), the leaves are filled and every inner node is combined once
+                explicit SegmentTree(const Vector<Value>& values) {
+                    allocate(values.size());
+                    for(cc_size_t i = 0; i < _size; i++) _M_tree[_leaves + i] = values[i];
+                    for(cc_size_t i = _leaves - 1; i > 0; i--) _M_tree[i] = Operation::combine(_M_tree[2 * i], _M_tree[2 * i + 1]);
+                }
+
+            public:
+                cc_size_t size() const {
+                    return _size;
+                }
+
+                //NOTICE: combine() of the values in [first, last), the identity for an empty range;
+                //not const, the parked updates on the two border paths are pushed down first
+                Value query(cc_size_t first, cc_size_t last) {
+                    if(first >= last) return Operation::identity();
+
+                    first += _leaves;
+                    last += _leaves;
+                    push(first);
+                    push(last - 1);
+                    Value left = Operation::identity(), right = Operation::identity();
+                    for(; first < last; first >>= 1, last >>= 1) {
+                        if(first & 1) left = Operation::combine(left, _M_tree[first++]);
+                        if(last & 1) right = Operation::combine(_M_tree[--last], right);
+                    }
+                    return Operation::combine(left, right);
+                }
+
+                //NOTICE: applies update to every value in [first, last)
+                void update(cc_size_t first, cc_size_t last, const Update& update) {
+                    if(first >= last) return;
+
+                    first += _leaves;
+                    last += _leaves;
+                    cc_size_t left = first, right = last - 1;
+                    push(left);     //NOTICE: an older update must land below before a newer one that does not commute
+                    push(right);
+                    for(cc_size_t length = 1; first < last; first >>= 1, last >>= 1, length <<= 1) {
+                        if(first & 1) applyNode(first++, update, length);
+                        if(last & 1) applyNode(--last, update, length);
+                    }
+                    rebuild(left);
+                    rebuild(right);
+                }
+
+                void set(cc_size_t index, const Value& value) {
+                    cc_size_t node = index + _leaves;
+                    push(node);
+                    _M_tree[node] = value;
+                    rebuild(node);
+                }
+
+                Value at(cc_size_t index) {
+                    return query(index, index + 1);
+                }
+
+            private:
+                void allocate(cc_size_t size) {
+                    _size = size;
+                    _leaves = 1;
+                    _height = 0;
+                    while(_leaves < size) {
+                        _leaves <<= 1;
+                        ++_height;
+                    }
+                    _M_tree.reserve(2 * _leaves);
+                    _M_lazy.reserve(_leaves);
+                    for(cc_size_t i = 0; i < 2 * _leaves; i++) _M_tree.push_back(Operation::identity());
+                    for(cc_size_t i = 0; i < _leaves; i++) _M_lazy.push_back(Operation::noUpdate());
+                }
+
+                //NOTICE: length is the number of leaves below node, 1 << k for a node k levels above the leaves
+                void applyNode(cc_size_t node, const Update& update, cc_size_t length) {
+                    _M_tree[node] = Operation::apply(_M_tree[node], update, length);
+                    if(node < _leaves) _M_lazy[node] = Operation::compose(update, _M_lazy[node]);
+                }
+
+                //NOTICE: pushes the parked updates down the path from the root to leaf, top first
+                void push(cc_size_t leaf) {
+                    for(cc_size_t shift = _height; shift > 0; shift--) {
+                        cc_size_t node = leaf >> shift;
+                        applyNode(2 * node, _M_lazy[node], (cc_size_t)1 << (shift - 1));
+                        applyNode(2 * node + 1, _M_lazy[node], (cc_size_t)1 << (shift - 1));
+                        _M_lazy[node] = Operation::noUpdate();
+                    }
+                }
+
+                //NOTICE: recombines the path from leaf up, a node's own parked update is applied over its children
+                void rebuild(cc_size_t leaf) {
+                    cc_size_t length = 2;
+                    for(cc_size_t node = leaf >> 1; node > 0; node >>= 1, length <<= 1) {
+                        Value combined = Operation::combine(_M_tree[2 * node], _M_tree[2 * node + 1]);
+                        _M_tree[node] = Operation::apply(combined, _M_lazy[node], length);
+                    }
+                }
+
+            private:
+                cc_size_t _size;
+                cc_size_t _leaves;
+                cc_size_t _height;
+                Vector<Value> _M_tree;
+                Vector<Update> _M_lazy;
+        };
+    }   //namespace adt
+}   //namespace cclib
+
+#endif //CCLIB_ADT_SEGMENT_TREE_H
@@ -0,0 +1,288 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Concurrent skip list map (lock-free, Fraser; Herlihy and Shavit)
+ * an ordered map any number of threads may read and write at once, no operation takes a lock;
+ * each node sits in the bottom list and, with probability 1/4 per level, in the lists above it, O(log n) expected hops;
+ * erase() marks the low bit of the node's next pointers top down, the bottom mark is the point the key is gone,
+ * any thread passing a marked node unlinks it; insert() links the bottom level first, that is the point the key is there;
+ * unlinked nodes go to an EpochReclaimer, readers never see freed memory;
+ * values are set once by insert() and never changed, find() copies one out;
+ * forEach() and forRange() walk the bottom list while others change it: a key present for the whole walk is visited
+ * once and in order, a key inserted or erased during the walk may or may not be.
+************************/
+#ifndef CCLIB_ADT_SKIP_LIST_H
+#define CCLIB_ADT_SKIP_LIST_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "concurrent.h"
+#include <new>
+
+namespace cclib {
+    namespace adt {
+        //NOTICE: the _level next pointers follow the node in the same allocation, the low bit of each is the erase mark
+        template<typename Key, typename Value>
+        struct SkipListNode {
+            Key _key;
+            Value _value;
+            int _level;
+            std::atomic<int> _state;    //NOTICE: LINKED and UNLINKED bits, the second one to finish retires the node
+            SkipListNode* _M_retiredNext;
+
+            SkipListNode(const Key& key, const Value& value, int level): _key(key), _value(value), _level(level), _state(0), _M_retiredNext(CC_NULL) {}
+
+            std::atomic<uintptr_t>* next() {
+                return reinterpret_cast<std::atomic<uintptr_t>*>(this + 1);
+            }
+        };
+
+        template<typename Key, typename Value>
+        class ConcurrentSkipList {
+            public:
+                typedef SkipListNode<Key, Value> Node;
+
+            public:
+                ConcurrentSkipList(): _M_reclaimer(&ConcurrentSkipList::dispose), _size(0) {
+                    for(int i = 0; i < MAX_LEVEL; i++) _M_head[i].store(0, std::memory_order_relaxed);
+                }
+
+                //NOTICE: no other thread may use the list any more
+                ~ConcurrentSkipList() {
+                    Node* node = pointer(_M_head[0].load(std::memory_order_acquire));
+                    while(CC_NULL != node) {
+                        Node* next = pointer(node->next()[0].load(std::memory_order_relaxed));
+                        dispose(node);
+                        node = next;
+                    }
+                }
+
+            private:
+                ConcurrentSkipList(const ConcurrentSkipList& instance);
+                ConcurrentSkipList& operator=(const ConcurrentSkipList& instance);
+
+            public:
+                //NOTICE: only a snapshot, other threads may change it right after
+                cc_size_t size() const {
+                    long size = _size.load(std::memory_order_relaxed);
+                    return size < 0 ? 0 : (cc_size_t)size;
+                }
+
+                bool empty() const {
+                    return 0 == size();
+                }
+
+                //NOTICE: copies the value into value, false when key is not there; never unlinks, a pure read
+                bool find(const Key& key, Value& value) {
+                    Guard guard(_M_reclaimer);
+                    Node* node = lowerBound(key);
+                    if(CC_NULL == node || key < node->_key) return false;
+                    value = node->_value;
+                    return true;
+                }
+
+                bool contains(const Key& key) {
+                    Guard guard(_M_reclaimer);
+                    Node* node = lowerBound(key);
+                    return CC_NULL != node && !(key < node->_key);
+                }
+
+                //NOTICE: false when key is there already, its value is kept
+                bool insert(const Key& key, const Value& value) {
+                    Guard guard(_M_reclaimer);
+                    std::atomic<uintptr_t>* preds[MAX_LEVEL];
+                    Node* succs[MAX_LEVEL];
+                    int level = randomLevel();
+                    Node* node = CC_NULL;
+                    for(;;) {
+                        if(search(key, preds, succs)) {
+                            if(CC_NULL != node) dispose(node);
+                            return false;
+                        }
+                        if(CC_NULL == node) node = makeNode(key, value, level);
+                        for(int i = 0; i < level; i++) node->next()[i].store((uintptr_t)succs[i], std::memory_order_relaxed);
+
+                        uintptr_t expected = (uintptr_t)succs[0];
+                        if(preds[0][0].compare_exchange_strong(expected, (uintptr_t)node, std::memory_order_release, std::memory_order_relaxed)) break;
+                    }
+                    _size.fetch_add(1, std::memory_order_relaxed);
+
+                    //COMMENT: the key is in, the upper levels are only shortcuts; give up on them once the node is being erased
+                    bool linking = true;
+                    for(int i = 1; linking && i < level; i++) {
+                        for(;;) {
+                            uintptr_t next = node->next()[i].load(std::memory_order_acquire);
+                            if(marked(next) || (pointer(next) != succs[i] && !node->next()[i].compare_exchange_strong(next, (uintptr_t)succs[i], std::memory_order_acq_rel))) {
+                                linking = false;
+                                break;
+                            }
+                            uintptr_t expected = (uintptr_t)succs[i];
+                            if(preds[i][i].compare_exchange_strong(expected, (uintptr_t)node, std::memory_order_release, std::memory_order_relaxed)) break;
+                            if(!search(key, preds, succs) || succs[0] != node) {
+                                linking = false;
+                                break;
+                            }
+                        }
+                    }
+                    finish(node, LINKED, guard);
+                    return true;
+                }
+
+                bool erase(const Key& key) {
+                    Guard guard(_M_reclaimer);
+                    std::atomic<uintptr_t>* preds[MAX_LEVEL];
+                    Node* succs[MAX_LEVEL];
+                    if(!search(key, preds, succs)) return false;
+
+                    Node* node = succs[0];
+                    for(int i = node->_level - 1; i > 0; i--) mark(node->next()[i]);
+
+                    //NOTICE: whoever marks the bottom level erased the key
+                    uintptr_t next = node->next()[0].load(std::memory_order_acquire);
+                    for(;;) {
+                        if(marked(next)) return false;
+                        if(node->next()[0].compare_exchange_weak(next, next | 1, std::memory_order_acq_rel, std::memory_order_acquire)) break;
+                    }
+                    _size.fetch_sub(1, std::memory_order_relaxed);
+
+                    search(key, preds, succs);  //COMMENT: unlinks the node from every level it is linked at
+                    finish(node, UNLINKED, guard);
+                    return true;
+                }
+
+                //NOTICE: calls visitor(key, value) in key order for every key
+                template<typename Visitor>
+                void forEach(Visitor visitor) {
+                    Guard guard(_M_reclaimer);
+                    walk(pointer(_M_head[0].load(std::memory_order_acquire)), CC_NULL, visitor);
+                }
+
+                //NOTICE: calls visitor(key, value) in key order for the keys in [low, high)
+                template<typename Visitor>
+                void forRange(const Key& low, const Key& high, Visitor visitor) {
+                    Guard guard(_M_reclaimer);
+                    walk(lowerBound(low), &high, visitor);
+                }
+
+            private:
+                typedef typename EpochReclaimer<Node>::Guard Guard;
+
+                static const int MAX_LEVEL = 24;
+                static const int LINKED = 1;
+                static const int UNLINKED = 2;
+
+                static Node* pointer(uintptr_t next) {
+                    return (Node*)(next & ~(uintptr_t)1);
+                }
+
+                static bool marked(uintptr_t next) {
+                    return 0 != (next & 1);
+                }
+
+                static void mark(std::atomic<uintptr_t>& next) {
+                    uintptr_t value = next.load(std::memory_order_acquire);
+                    while(!marked(value) && !next.compare_exchange_weak(value, value | 1, std::memory_order_acq_rel, std::memory_order_acquire)) {}
+                }
+
+                //COMMENT: level i + 1 with probability 4^-i
+                static int randomLevel() {
+                    uint32_t bits = threadRandom();
+                    int level = 1;
+                    while(level < MAX_LEVEL && 0 == (bits & 3)) {
+                        ++level;
+                        bits >>= 2;
+                    }
+                    return level;
+                }
+
+                static Node* makeNode(const Key& key, const Value& value, int level) {
+                    void* memory = ::operator new(sizeof(Node) + level * sizeof(std::atomic<uintptr_t>));
+                    Node* node = new(memory) Node(key, value, level);
+                    for(int i = 0; i < level; i++) new(&node->next()[i]) std::atomic<uintptr_t>(0);
+                    return node;
+                }
+
+                static void dispose(Node* node) {
+                    node->~Node();
+                    ::operator delete(node);
+                }
+
+                //NOTICE: an erase can finish while the insert is still linking upper levels, and may miss a level linked late;
+                //so the later of the two runs the last unlinking search and retires the node
+                void finish(Node* node, int done, const Guard& guard) {
+                    if(0 == (node->_state.fetch_or(done, std::memory_order_acq_rel) & (LINKED | UNLINKED) & ~done)) return;
+                    if(LINKED == done) {
+                        std::atomic<uintptr_t>* preds[MAX_LEVEL];
+                        Node* succs[MAX_LEVEL];
+                        search(node->_key, preds, succs);
+                    }
+                    _M_reclaimer.retire(node, guard);
+                }
+
+                //NOTICE: fills preds (the next arrays to link from) and succs for every level, unlinking marked nodes on the way;
+                //true when an unmarked node with key is in the bottom list, it is succs[0] then
+                bool search(const Key& key, std::atomic<uintptr_t>** preds, Node** succs) {
+                retry:
+                    std::atomic<uintptr_t>* pred = _M_head;
+                    for(int i = MAX_LEVEL - 1; i >= 0; i--) {
+                        Node* current = pointer(pred[i].load(std::memory_order_acquire));
+                        while(CC_NULL != current) {
+                            uintptr_t next = current->next()[i].load(std::memory_order_acquire);
+                            if(marked(next)) {
+                                uintptr_t expected = (uintptr_t)current;
+                                if(!pred[i].compare_exchange_strong(expected, (uintptr_t)pointer(next), std::memory_order_acq_rel, std::memory_order_relaxed)) goto retry;
+                                current = pointer(next);
+                                continue;
+                            }
+                            if(!(current->_key < key)) break;
+                            pred = current->next();
+                            current = pointer(next);
+                        }
+                        preds[i] = pred;
+                        succs[i] = current;
+                    }
+                    return CC_NULL != succs[0] && !(key < succs[0]->_key);
+                }
+
+                //NOTICE: the first unmarked node not less than key, read only; marked nodes are stepped over, not unlinked
+                Node* lowerBound(const Key& key) {
+                    std::atomic<uintptr_t>* pred = _M_head;
+                    Node* current = CC_NULL;
+                    for(int i = MAX_LEVEL - 1; i >= 0; i--) {
+                        current = pointer(pred[i].load(std::memory_order_acquire));
+                        while(CC_NULL != current) {
+                            uintptr_t next = current->next()[i].load(std::memory_order_acquire);
+                            if(!marked(next) && !(current->_key < key)) break;
+                            if(current->_key < key) pred = current->next();
+                            current = pointer(next);
+                        }
+                    }
+                    return current;
+                }
+
+                template<typename Visitor>
+                static void walk(Node* node, const Key* high, Visitor& visitor) {
+                    while(CC_NULL != node && (CC_NULL == high || node->_key < *high)) {
+                        uintptr_t next = node->next()[0].load(std::memory_order_acquire);
+                        if(!marked(next)) visitor(node->_key, node->_value);
+                        node = pointer(next);
+                    }
+                }
+
+            private:
+                std::atomic<uintptr_t> _M_head[MAX_LEVEL];
+                EpochReclaimer<Node> _M_reclaimer;
+                std::atomic<long> _size;
+        };
+    }   //namespace adt
+}   //namespace cclib
+
+#endif //CCLIB_ADT_SKIP_LIST_H
@@ -0,0 +1,274 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Splay tree
+ * a binary search tree that moves every key it touches to the root (top down splaying, Sleator and Tarjan);
+ * any sequence of m operations costs O(m log n), and a key used often stays a few hops from the root,
+ * so skewed (Zipfian) lookups get cheaper than in a balanced tree;
+ * find() restructures the tree, it is not const and two threads may not even read at the same time;
+ * every node keeps its subtree size, so size() is O(1) after split() and join().
+************************/
+#ifndef CCLIB_ADT_SPLAY_TREE_H
+#define CCLIB_ADT_SPLAY_TREE_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "vector.h"
+
+namespace cclib {
+    namespace adt {
+        template<typename Comparable>
+        struct SplayNode {
+            Comparable _data;
+            SplayNode* _leftChild;
+            SplayNode* _rightChild;
+            cc_size_t _count;
+
+            SplayNode(const Comparable& data): _data(data), _leftChild(CC_NULL), _rightChild(CC_NULL), _count(1) {}
+        };
+
+        template<typename Comparable>
+        class SplayTree {
+            public:
+                SplayTree(): _M_root(CC_NULL) {}
+                ~SplayTree() {
+                    clear();
+                }
+
+            private:
+                SplayTree(const SplayTree& instance);
+                SplayTree& operator=(const SplayTree& instance);
+
+            public:
+                bool empty() const {
+                    return CC_NULL == _M_root;
+                }
+
+                cc_size_t size() const {
+                    return count(_M_root);
+                }
+
+                //NOTICE: iterative, a splay tree may be a path n nodes deep
+                bool clear() {
+                    SplayNode<Comparable>* node = _M_root;
+                    while(CC_NULL != node) {
+                        if(CC_NULL != node->_leftChild) {   //NOTICE: rotate the left subtree up until there is none
+                            SplayNode<Comparable>* left = node->_leftChild;
+                            node->_leftChild = left->_rightChild;
+                            left->_rightChild = node;
+                            node = left;
+                        } else {
+                            SplayNode<Comparable>* right = node->_rightChild;
+                            delete node;
+                            node = right;
+                        }
+                    }
+                    _M_root = CC_NULL;
+                    return true;
+                }
+
+                bool insert(const Comparable& data) {
+                    SplayNode<Comparable>* node = new SplayNode<Comparable>(data);
+                    if(CC_NULL == _M_root) {
+                        _M_root = node;
+                        return true;
+                    }
+
+                    _M_root = splay(&data, _M_root);
+                    if(data < _M_root->_data) {
+                        node->_leftChild = _M_root->_leftChild;
+                        node->_rightChild = _M_root;
+                        _M_root->_leftChild = CC_NULL;
+                    } else if(_M_root->_data < data) {
+                        node->_rightChild = _M_root->_rightChild;
+                        node->_leftChild = _M_root;
+                        _M_root->_rightChild = CC_NULL;
+                    } else {    //NOTICE: duplicate data, do nothing
+                        delete node;
+                        return false;
+                    }
+                    update(_M_root);
+                    update(node);
+                    _M_root = node;
+                    return true;
+                }
+
+                bool remove(const Comparable& data) {
+                    if(CC_NULL == _M_root) return false;
+
+                    _M_root = splay(&data, _M_root);
+                    if(data < _M_root->_data || _M_root->_data < data) return false;
+
+                    SplayNode<Comparable>* node = _M_root;
+                    if(CC_NULL == node->_leftChild) {
+                        _M_root = node->_rightChild;
+                    } else {    //NOTICE: everything on the left is smaller, splaying data there brings up the maximum
+                        _M_root = splay(&data, node->_leftChild);
+                        _M_root->_rightChild = node->_rightChild;
+                        update(_M_root);
+                    }
+                    delete node;
+                    return true;
+                }
+
+                //NOTICE: CC_NULL when data is not in the tree, the last node looked at becomes the root either way
+                SplayNode<Comparable>* find(const Comparable& data) {
+                    if(CC_NULL == _M_root) return CC_NULL;
+
+                    _M_root = splay(&data, _M_root);
+                    return data < _M_root->_data || _M_root->_data < data ? CC_NULL : _M_root;
+                }
+
+                bool contains(const Comparable& data) {
+                    return CC_NULL != find(data);
+                }
+
+                //NOTICE: moves the values not less than key into right, which is emptied first
+                void split(const Comparable& key, SplayTree& right) {
+                    if(this == &right) return;
+
+                    right.clear();
+                    if(CC_NULL == _M_root) return;
+
+                    _M_root = splay(&key, _M_root);
+                    if(_M_root->_data < key) {
+                        right._M_root = _M_root->_rightChild;
+                        _M_root->_rightChild = CC_NULL;
+                    } else {
+                        right._M_root = _M_root;
+                        _M_root = _M_root->_leftChild;
+                        right._M_root->_leftChild = CC_NULL;
+                        update(right._M_root);
+                        return;
+                    }
+                    update(_M_root);
+                }
+
+                //NOTICE: every value of right must be greater than every value here, right is left empty;
+                //joining a tree with itself changes nothing
+                void join(SplayTree& right) {
+                    if(this == &right || CC_NULL == right._M_root) return;
+                    if(CC_NULL == _M_root) {
+                        _M_root = right._M_root;
+                    } else {
+                        _M_root = splay(CC_NULL, _M_root);  //NOTICE: the maximum has no right child
+                        _M_root->_rightChild = right._M_root;
+                        update(_M_root);
+                    }
+                    right._M_root = CC_NULL;
+                }
+
+                //NOTICE: writes the values in order as {a, b, c}, without recursion
+                template<typename Writer>
+                void dump(Writer& writer) const {
+                    Vector<const SplayNode<Comparable>*> path;
+                    const SplayNode<Comparable>* node = _M_root;
+                    bool first = true;
+                    writer << '{';
+                    while(CC_NULL != node || !path.empty()) {
+                        if(CC_NULL != node) {
+                            path.push_back(node);
+                            node = node->_leftChild;
+                            continue;
+                        }
+                        node = path[path.size() - 1];
+                        path.pop_back();
+                        if(!first) writer << ", ";
+                        writer << node->_data;
+                        first = false;
+                        node = node->_rightChild;
+                    }
+                    writer << '}';
+                }
+
+            private:
+                static cc_size_t count(const SplayNode<Comparable>* node) {
+                    return CC_NULL == node ? 0 : node->_count;
+                }
+
+                static void update(SplayNode<Comparable>* node) {
+                    node->_count = 1 + count(node->_leftChild) + count(node->_rightChild);
+                }
+
+                //NOTICE: top down splay with subtree sizes (Sleator); brings key, or the last node on its search path, to the root;
+                //key == CC_NULL means larger than everything, which brings up the maximum;
+                //nodes passed on the way hang off the left tree (all smaller) and the right tree (all greater),
+                //their sizes are fixed in a second walk down the two spines before the three parts are put together
+                static SplayNode<Comparable>* splay(const Comparable* key, SplayNode<Comparable>* root) {
+                    SplayNode<Comparable>* leftTree = CC_NULL;
+                    SplayNode<Comparable>* rightTree = CC_NULL;
+                    SplayNode<Comparable>** leftHook = &leftTree;   //NOTICE: the right child slot of the largest node of the left tree
+                    SplayNode<Comparable>** rightHook = &rightTree;
+                    cc_size_t leftSize = 0, rightSize = 0;
+
+                    for(;;) {
+                        if(CC_NULL != key && *key < root->_data) {
+                            if(CC_NULL == root->_leftChild) break;
+                            if(*key < root->_leftChild->_data) {    //zig zig: rotate right first
+                                SplayNode<Comparable>* child = root->_leftChild;
+                                root->_leftChild = child->_rightChild;
+                                child->_rightChild = root;
+                                update(root);
+                                root = child;
+                                if(CC_NULL == root->_leftChild) break;
+                            }
+                            *rightHook = root;  //link right
+                            rightHook = &root->_leftChild;
+                            rightSize += 1 + count(root->_rightChild);
+                            root = root->_leftChild;
+                        } else if(CC_NULL == key || root->_data < *key) {
+                            if(CC_NULL == root->_rightChild) break;
+                            if(CC_NULL == key || root->_rightChild->_data < *key) { //zag zag: rotate left first
+                                SplayNode<Comparable>* child = root->_rightChild;
+                                root->_rightChild = child->_leftChild;
+                                child->_leftChild = root;
+                                update(root);
+                                root = child;
+                                if(CC_NULL == root->_rightChild) break;
+                            }
+                            *leftHook = root;   //link left
+                            leftHook = &root->_rightChild;
+                            leftSize += 1 + count(root->_leftChild);
+                            root = root->_rightChild;
+                        } else {
+                            break;
+                        }
+                    }
+
+                    leftSize += count(root->_leftChild);
+                    rightSize += count(root->_rightChild);
+                    root->_count = leftSize + rightSize + 1;
+
+                    *leftHook = CC_NULL;
+                    *rightHook = CC_NULL;
+                    for(SplayNode<Comparable>* node = leftTree; CC_NULL != node; node = node->_rightChild) {
+                        node->_count = leftSize;
+                        leftSize -= 1 + count(node->_leftChild);
+                    }
+                    for(SplayNode<Comparable>* node = rightTree; CC_NULL != node; node = node->_leftChild) {
+                        node->_count = rightSize;
+                        rightSize -= 1 + count(node->_rightChild);
+                    }
+
+                    *leftHook = root->_leftChild;   //assemble
+                    *rightHook = root->_rightChild;
+                    root->_leftChild = leftTree;
+                    root->_rightChild = rightTree;
+                    return root;
+                }
+
+            private:
+                SplayNode<Comparable>* _M_root;
+        };
+    }   //namespace adt
+}   //namespace cclib
+
+#endif //CCLIB_ADT_SPLAY_TREE_H
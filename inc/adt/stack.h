@@ -9,49 +9,208 @@
  *
  * author: hello_chenchen <https://github.com/hello-chenchen>
  **********************************************************************************/
+/************************
+ * NOTICE: Stack
+ * the first InlineCapacity elements live inside the Stack object itself, no heap allocation;
+ * when the depth exceeds InlineCapacity the elements spill to a heap buffer that grows by doubling;
+ * top() / push() / pop() index one contiguous buffer, no Vector or pointer hop in between.
+************************/
 #ifndef CCLIB_ADT_STACK_H
 #define CCLIB_ADT_STACK_H
 
 #include "./../../cclib-common/inc/base/common_define.h"
-#include "vector.h"
-#include <iostream>
-
-using namespace cclib;
-using namespace cclib::adt;
+#include <new>
+#include <utility>
+#include <type_traits>
 
 namespace cclib {
     namespace adt {
-        template<typename T>
+        template<typename T, cc_size_t InlineCapacity = 16>
         class Stack {
+            static_assert(InlineCapacity > 0, "Stack InlineCapacity must be greater than 0");
+
             public:
-                Stack():_M_vector(new Vector<T>()) {}
+                Stack(): _size(0), _capacity(InlineCapacity), _M_data(inlineData()) {}
+
+                Stack(const Stack& instance): _size(0), _capacity(InlineCapacity), _M_data(inlineData()) {
+                    reserve(instance._size);
+                    for(cc_size_t i = 0; i < instance._size; i++) {
+                        new (_M_data + i) T(instance._M_data[i]);
+                    }
+                    _size = instance._size;
+                }
+
+                Stack(Stack&& instance): _size(0), _capacity(InlineCapacity), _M_data(inlineData()) {
+                    steal(instance);
+                }
+
                 ~Stack() {
-                    delete _M_vector;
-                    _M_vector = CC_NULL;
+                    clear();
+                    releaseHeap();
+                }
+
+                Stack& operator=(const Stack& instance) {
+                    if(this != &instance) {
+                        clear();
+                        reserve(instance._size);
+                        for(cc_size_t i = 0; i < instance._size; i++) {
+                            new (_M_data + i) T(instance._M_data[i]);
+                        }
+                        _size = instance._size;
+                    }
+
+                    return *this;
+                }
+
+                Stack& operator=(Stack&& instance) {
+                    if(this != &instance) {
+                        clear();
+                        releaseHeap();
+                        steal(instance);
+                    }
+
+                    return *this;
                 }
 
             public:
                 bool push(const T& data) {
-                    return _M_vector->push_back(data);
+                    if(_size == _capacity) {
+                        //NOTICE: data may live inside this stack, copy it before the buffer moves
+                        T temp(data);
+                        doubleExpansion();
+                        new (_M_data + _size) T(std::move(temp));
+                    } else {
+                        new (_M_data + _size) T(data);
+                    }
+                    ++_size;
+                    return true;
+                }
+
+                bool push(T&& data) {
+                    if(_size == _capacity) {
+                        T temp(std::move(data));
+                        doubleExpansion();
+                        new (_M_data + _size) T(std::move(temp));
+                    } else {
+                        new (_M_data + _size) T(std::move(data));
+                    }
+                    ++_size;
+                    return true;
+                }
+
+                template<typename... Args>
+                T& emplace(Args&&... args) {
+                    if(_size == _capacity) {
+                        //NOTICE: args may refer into this stack, build the element before the buffer moves
+                        T temp(std::forward<Args>(args)...);
+                        doubleExpansion();
+                        new (_M_data + _size) T(std::move(temp));
+                    } else {
+                        new (_M_data + _size) T(std::forward<Args>(args)...);
+                    }
+                    return _M_data[_size++];
                 }
 
                 bool pop() {
-                    return _M_vector->pop_back();
+                    if(0 == _size) return false;
+
+                    _M_data[--_size].~T();
+                    return true;
                 }
 
+                //NOTICE: undefined when the stack is empty, check empty() first
                 T& top() {
-                    typename Vector<T>::Iterator itr = _M_vector->end();
-                    return *(--itr);
+                    return _M_data[_size - 1];
+                }
+
+                const T& top() const {
+                    return _M_data[_size - 1];
+                }
+
+                cc_size_t size() const {
+                    return _size;
+                }
+
+                bool empty() const {
+                    return 0 == _size;
+                }
+
+                cc_size_t capacity() const {
+                    return _capacity;
+                }
+
+                bool onHeap() const {
+                    return _M_data != inlineData();
+                }
+
+                bool clear() {
+                    while(0 != _size) {
+                        _M_data[--_size].~T();
+                    }
+                    return true;
+                }
+
+                bool reserve(cc_size_t capacity) {
+                    if(capacity <= _capacity) return true;
+
+                    T* temp = static_cast<T*>(::operator new(capacity * sizeof(T)));
+                    for(cc_size_t i = 0; i < _size; i++) {
+                        new (temp + i) T(std::move(_M_data[i]));
+                        _M_data[i].~T();
+                    }
+
+                    releaseHeap();
+                    _M_data = temp;
+                    _capacity = capacity;
+                    return true;
+                }
+
+            private:
+                void doubleExpansion() {
+                    reserve(2 * _capacity);
+                }
+
+                void releaseHeap() {
+                    if(onHeap()) {
+                        ::operator delete(_M_data);
+                    }
+                    _M_data = inlineData();
+                    _capacity = InlineCapacity;
+                }
+
+                //NOTICE: a heap buffer is taken over as is, inline elements have to be moved one by one
+                void steal(Stack& instance) {
+                    if(instance.onHeap()) {
+                        _M_data = instance._M_data;
+                        _capacity = instance._capacity;
+                        _size = instance._size;
+                        instance._M_data = instance.inlineData();
+                        instance._capacity = InlineCapacity;
+                        instance._size = 0;
+                    } else {
+                        for(cc_size_t i = 0; i < instance._size; i++) {
+                            new (_M_data + i) T(std::move(instance._M_data[i]));
+                        }
+                        _size = instance._size;
+                        instance.clear();
+                    }
+                }
+
+                T* inlineData() {
+                    return reinterpret_cast<T*>(_M_inline);
                 }
 
-                cc_size_t size() {
-                    return _M_vector->size();
+                const T* inlineData() const {
+                    return reinterpret_cast<const T*>(_M_inline);
                 }
 
             private:
-                Vector<T>* _M_vector;
+                cc_size_t _size;
+                cc_size_t _capacity;
+                T* _M_data;
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type _M_inline[InlineCapacity];
         };
     } //namespace adt
 } //namespace cclib
 
-#endif //CCLIB_ADT_STACK_H
\ No newline at end of file
+#endif //CCLIB_ADT_STACK_H
@@ -16,6 +16,7 @@
  * a total order is defined on these values (every two values can be compared with each other);
  * left subtree of a node contains only values lesser, than the node's value;
  * right subtree of a node contains only values greater, than the node's value.
+ * the Balance parameter keeps it O(log n) deep: BinaryNoBalance (none), BinaryTreapBalance, BinaryAVLBalance.
 *************************/
 /************************
  * NOTICE: Red Black tree
@@ -23,11 +24,16 @@
  * Root of tree is always black.
  * There are no two adjacent red nodes (A red node cannot have a red parent or red child).
  * Every path from a node (including root) to any of its descendant NULL node has the same number of black nodes.
+ * unionWith(), intersectWith(), differenceWith() and split() are join based, the Fork policy decides whether
+ * the two halves of a large subtree run in parallel: RedBlackSerialFork here, ParallelRedBlackTree in parallel_tree.h.
+ * IntervalTree augments it with the largest interval end of every subtree for overlap() and stab() queries.
 ************************/
 #ifndef CCLIB_ADT_TREE_H
 #define CCLIB_ADT_TREE_H
 #include "./../../cclib-common/inc/base/common_define.h"
+#include <stdint.h>
 #include <iostream>
+#include <limits>
 
 namespace cclib
 {
@@ -36,8 +42,80 @@ namespace cclib
         enum RedBlackColor {EN_Red, EN_Black};
         enum RedBlackDirection{EN_Left, EN_Right};
 
-        template<typename Comparable>
-        struct RedBlackNode {
+        //NOTICE: an augmentation is a base class of RedBlackNode holding extra fields per node,
+        //update() recomputes them from the two children, the tree calls it bottom up after every change of shape
+        struct RedBlackNoAugment {
+            template<typename Node>
+            static void update(Node*) {}
+        };
+
+        //NOTICE: subtree size, enables rank(), select() and rangeCount() in O(log n); nil counts 0
+        struct RedBlackOrderStatistic {
+            cc_size_t _count;
+
+            RedBlackOrderStatistic(): _count(0) {}
+
+            template<typename Node>
+            static void update(Node* node) {
+                node->_count = 1 + node->_leftChild->_count + node->_rightChild->_count;
+            }
+        };
+
+        //NOTICE: closed interval [_low, _high], ordered by _low then _high; two equal intervals are one value in a tree
+        template<typename T>
+        struct Interval {
+            T _low;
+            T _high;
+
+            Interval(): _low(T()), _high(T()) {}
+            Interval(const T& low, const T& high): _low(low), _high(high) {}
+
+            bool operator==(const Interval& instance) const {
+                return !(*this < instance) && !(instance < *this);
+            }
+
+            bool operator<(const Interval& instance) const {
+                return this->_low < instance._low || (!(instance._low < this->_low) && this->_high < instance._high);
+            }
+
+            bool operator>(const Interval& instance) const {
+                return instance < *this;
+            }
+
+            bool overlaps(const T& low, const T& high) const {
+                return !(high < this->_low) && !(this->_high < low);
+            }
+
+            template<typename Writer>
+            void dump(Writer& writer) const {
+                writer << '[' << this->_low << ", " << this->_high << ']';
+            }
+        };
+
+        template<typename Writer, typename T>
+        Writer& operator<<(Writer& writer, const Interval<T>& instance) {
+            instance.dump(writer);
+            return writer;
+        }
+
+        //NOTICE: largest _high in the subtree for Comparable = Interval<T>, enables overlap() and stab();
+        //nil keeps the lowest T and never takes part in a maximum, T needs std::numeric_limits
+        template<typename T>
+        struct RedBlackIntervalMax {
+            T _max;
+
+            RedBlackIntervalMax(): _max(std::numeric_limits<T>::lowest()) {}
+
+            template<typename Node>
+            static void update(Node* node) {
+                node->_max = node->_data._high;
+                if(node->_max < node->_leftChild->_max) node->_max = node->_leftChild->_max;
+                if(node->_max < node->_rightChild->_max) node->_max = node->_rightChild->_max;
+            }
+        };
+
+        template<typename Comparable, typename Augment = RedBlackNoAugment>
+        struct RedBlackNode: public Augment {
             Comparable _data;
             RedBlackColor _color;
             RedBlackNode* _parent;
@@ -87,77 +165,96 @@ namespace cclib
             // }
         };
 
-        template<typename Comparable>
+        //NOTICE: the tree's nil node doubles as the header: its left and right children are the leftmost and rightmost nodes,
+        //an iterator on nil is past the end, so begin() and end() are O(1) and a full walk is amortized O(1) per step;
+        //Reverse = true walks from the largest value down, its end is nil as well
+        template<typename Comparable, typename Augment = RedBlackNoAugment, bool Reverse = false>
         class RedBlackTreeIterator {
             public:
-                typedef RedBlackTreeIterator<Comparable> _Self;
+                typedef RedBlackTreeIterator<Comparable, Augment, Reverse> _Self;
 
             public:
-                RedBlackTreeIterator(RedBlackNode<Comparable>* node, RedBlackNode<Comparable>* nil) {
+                RedBlackTreeIterator(): _M_node(CC_NULL), _M_Nil(CC_NULL) {}
+
+                RedBlackTreeIterator(RedBlackNode<Comparable, Augment>* node, RedBlackNode<Comparable, Augment>* nil) {
                     _M_node = node;
                     _M_Nil = nil;
                 }
 
-                Comparable operator*() {
-                    return  CC_NULL == _M_node ? CC_NULL : _M_node->_data;
+                const Comparable& operator*() const {
+                    return _M_node->_data;
+                }
+
+                const Comparable* operator->() const {
+                    return &_M_node->_data;
+                }
+
+                _Self& operator++() {
+                    Reverse ? decrement() : increment();
+                    return *this;
                 }
 
                 _Self operator++(int) {
-                    increment();
+                    _Self temp = *this;
+                    Reverse ? decrement() : increment();
+                    return temp;
+                }
+
+                _Self& operator--() {
+                    Reverse ? increment() : decrement();
                     return *this;
                 }
 
-                _Self operator++() {
+                _Self operator--(int) {
                     _Self temp = *this;
-                    increment();
+                    Reverse ? increment() : decrement();
                     return temp;
                 }
 
+                bool operator==(const _Self& instance) const {
+                    return _M_node == instance._M_node;
+                }
+
+                bool operator!=(const _Self& instance) const {
+                    return _M_node != instance._M_node;
+                }
+
+                RedBlackNode<Comparable, Augment>* node() const {
+                    return _M_node;
+                }
+
+                //NOTICE: to the next larger value, past the largest is nil, after nil comes the smallest
                 void increment()
                 {
-                    if (_M_node->_rightChild != _M_Nil) {
+                    if(_M_node == _M_Nil) {
+                        _M_node = _M_Nil->_leftChild;
+                    } else if(_M_node->_rightChild != _M_Nil) {
                         _M_node = _M_node->_rightChild;
-                        while (_M_node->_leftChild != _M_Nil) {
+                        while(_M_node->_leftChild != _M_Nil) {
                             _M_node = _M_node->_leftChild;
                         }
                     } else {
-                        RedBlackNode<Comparable>* parent = _M_node->_parent;
-                        while (_M_node == parent->_rightChild) {
+                        RedBlackNode<Comparable, Augment>* parent = _M_node->_parent;
+                        while(parent != _M_Nil && _M_node == parent->_rightChild) {
                             _M_node = parent;
                             parent = parent->_parent;
                         }
-
-                        if (_M_node->_rightChild != parent) {
-                            _M_node = parent;
-                        }
+                        _M_node = parent;
                     }
                 }
 
-                _Self operator--(int) {
-                    decrement();
-                    return *this;
-                }
-
-                _Self operator--() {
-                    _Self temp = *this;
-                    decrement();
-                    return temp;
-                }
-
                 void decrement()
                 {
-                    if (_M_node->_color == EN_Red &&
-                        _M_node->grandParent() == _M_node) {    //TODO: case 1?
-                        _M_node = _M_node->_rightChild;
-                    } else if (_M_node->_leftChild != _M_Nil) {
-                        RedBlackNode<Comparable>* leftNode = _M_node->_leftChild;
-                        while (leftNode->_rightChild != _M_Nil) {
-                            leftNode = leftNode->_rightChild;
+                    if(_M_node == _M_Nil) {
+                        _M_node = _M_Nil->_rightChild;
+                    } else if(_M_node->_leftChild != _M_Nil) {
+                        _M_node = _M_node->_leftChild;
+                        while(_M_node->_rightChild != _M_Nil) {
+                            _M_node = _M_node->_rightChild;
                         }
-                        _M_node = leftNode;
                     } else {
-                        RedBlackNode<Comparable>* parent = _M_node->_parent;
-                        while (_M_node == parent->_leftChild) {
+                        RedBlackNode<Comparable, Augment>* parent = _M_node->_parent;
+                        while(parent != _M_Nil && _M_node == parent->_leftChild) {
                             _M_node = parent;
                             parent = parent->_parent;
                         }
@@ -166,17 +263,29 @@ namespace cclib
                 }
 
             private:
-                RedBlackNode<Comparable> *_M_node, *_M_Nil;
+                RedBlackNode<Comparable, Augment> *_M_node, *_M_Nil;
         };
 
-        template<typename Comparable>
+        //NOTICE: a fork policy runs two independent pieces of a set operation, invoke(left, right) returns once both are done;
+        //this one runs them one after the other, the tree header needs no threads
+        struct RedBlackSerialFork {
+            template<typename Left, typename Right>
+            static void invoke(const Left& left, const Right& right) {
+                left();
+                right();
+            }
+        };
+
+        template<typename Comparable, typename Augment = RedBlackNoAugment, typename Fork = RedBlackSerialFork>
         class RedBlackTree {
             public:
-                typedef RedBlackTreeIterator<Comparable> iterator;
+                typedef RedBlackTreeIterator<Comparable, Augment> iterator;
+                typedef RedBlackTreeIterator<Comparable, Augment, true> reverse_iterator;
+                typedef RedBlackNode<Comparable, Augment> Node;
 
             public:
                 RedBlackTree(): _size(0), _M_header(CC_NULL), _M_Nil(CC_NULL) {
-                    this->_M_Nil = new RedBlackNode<Comparable>();
+                    this->_M_Nil = new RedBlackNode<Comparable, Augment>();
                     this->_M_header = _M_Nil;
                     this->_M_header->_parent = _M_Nil;
                     this->_M_header->_leftChild = _M_Nil;
@@ -186,21 +295,68 @@ namespace cclib
                 // RedBlackTree(const RedBlackTree& instance) {}
                 ~RedBlackTree() {
                     clear();
+                    delete this->_M_Nil;
                 }
 
                 // const RedBlackTree& operator=(const RedBlackTree& instance) {}
-                RedBlackNode<Comparable>* nil() const {
+                RedBlackNode<Comparable, Augment>* nil() const {
                     return this->_M_Nil;
                 }
 
-                iterator begin() {
-                    RedBlackNode<Comparable>* minNode = findMin(_M_header);
-                    return iterator(minNode, _M_Nil);
+                iterator begin() const {
+                    return iterator(_M_Nil->_leftChild, _M_Nil);
+                }
+
+                iterator end() const {
+                    return iterator(_M_Nil, _M_Nil);
+                }
+
+                reverse_iterator rbegin() const {
+                    return reverse_iterator(_M_Nil->_rightChild, _M_Nil);
+                }
+
+                reverse_iterator rend() const {
+                    return reverse_iterator(_M_Nil, _M_Nil);
                 }
 
-                iterator end() {
-                    RedBlackNode<Comparable>* maxNode = findMax(_M_header);
-                    return iterator(maxNode, _M_Nil);
+                //NOTICE: the first value not less than data, end() when there is none
+                iterator lowerBound(const Comparable& data) const {
+                    RedBlackNode<Comparable, Augment>* result = _M_Nil;
+                    for(RedBlackNode<Comparable, Augment>* node = _M_header; _M_Nil != node;) {
+                        if(node->_data < data) {
+                            node = node->_rightChild;
+                        } else {
+                            result = node;
+                            node = node->_leftChild;
+                        }
+                    }
+                    return iterator(result, _M_Nil);
+                }
+
+                //NOTICE: the first value greater than data, end() when there is none
+                iterator upperBound(const Comparable& data) const {
+                    RedBlackNode<Comparable, Augment>* result = _M_Nil;
+                    for(RedBlackNode<Comparable, Augment>* node = _M_header; _M_Nil != node;) {
+                        if(data < node->_data) {
+                            result = node;
+                            node = node->_leftChild;
+                        } else {
+                            node = node->_rightChild;
+                        }
+                    }
+                    return iterator(result, _M_Nil);
+                }
+
+                //NOTICE: calls visitor(value) for every value in [low, high) in order, returns how many were visited;
+                //one descent to low, then one iterator step per value
+                template<typename Visitor>
+                cc_size_t scan(const Comparable& low, const Comparable& high, Visitor visitor) const {
+                    cc_size_t count = 0;
+                    for(iterator itr = lowerBound(low); itr != end() && *itr < high; ++itr) {
+                        visitor(*itr);
+                        ++count;
+                    }
+                    return count;
                 }
 
                 bool empty() const {
@@ -224,9 +380,25 @@ namespace cclib
 
                 void printHeader() {}
 
-                void remove(RedBlackNode<Comparable>*& node) {
-                    RedBlackNode<Comparable>* replaceNode = _M_Nil;
-                    RedBlackNode<Comparable>* realRemoveNode = node;
+                //NOTICE: writes the values in order as {a, b, c}, writer is str::Writer or anything with operator<< for Comparable
+                template<typename Writer>
+                void dump(Writer& writer) const {
+                    bool first = true;
+                    writer << '{';
+                    dump(writer, this->_M_header, first);
+                    writer << '}';
+                }
+
+                void remove(RedBlackNode<Comparable, Augment>* node) {
+                    if(node == _M_Nil->_leftChild) {    //NOTICE: the leftmost node has no left child
+                        _M_Nil->_leftChild = _M_Nil == node->_rightChild ? node->_parent : findMin(node->_rightChild);
+                    }
+                    if(node == _M_Nil->_rightChild) {
+                        _M_Nil->_rightChild = _M_Nil == node->_leftChild ? node->_parent : findMax(node->_leftChild);
+                    }
+
+                    RedBlackNode<Comparable, Augment>* replaceNode = _M_Nil;
+                    RedBlackNode<Comparable, Augment>* realRemoveNode = node;
                     RedBlackColor removeColor = realRemoveNode->_color;
                     if(node->_leftChild == _M_Nil) {
                         replaceNode = node->_rightChild;
@@ -237,6 +409,7 @@ namespace cclib
                     } else {
                         realRemoveNode = findMin(node->_rightChild);
                         removeColor = realRemoveNode->_color;
+                        replaceNode = realRemoveNode->_rightChild;
                         if(realRemoveNode->_parent == node) {
                             replaceNode->_parent = realRemoveNode;
                         } else {
@@ -248,32 +421,177 @@ namespace cclib
                         realRemoveNode->_leftChild = node->_leftChild;
                         realRemoveNode->_leftChild->_parent = realRemoveNode;
                         realRemoveNode->_color = node->_color;
-                        if(EN_Black == removeColor) {
-                            deleteFixUp(replaceNode);
-                        }
                     }
+                    //NOTICE: every subtree that lost a node lies on the path up from the replacement
+                    updatePath(replaceNode->_parent);
+                    if(EN_Black == removeColor) {
+                        deleteFixUp(replaceNode);
+                    }
+                    delete node;
                     --_size;
                     return;
                 }
 
                 bool insert(const Comparable& data) {
-                    RedBlackNode<Comparable>* node = new RedBlackNode<Comparable>(data, EN_Red, _M_Nil, _M_Nil, _M_Nil);
+                    RedBlackNode<Comparable, Augment>* node = new RedBlackNode<Comparable, Augment>(data, EN_Red, _M_Nil, _M_Nil, _M_Nil);
                     bool result = false;
                     result = insert(node);
 
                     if(result) {
+                        updatePath(node);
                         insertFixUp(node);
+                    } else {
+                        delete node;
                     }
 
                     return result;
                 }
 
-                RedBlackNode<Comparable>* find(const Comparable& data) {
+                RedBlackNode<Comparable, Augment>* find(const Comparable& data) {
                     return find(data, this->_M_header);
                 }
 
+                //NOTICE: rank(), select() and rangeCount() need Augment = RedBlackOrderStatistic
+                //number of values less than data, data need not be in the tree
+                cc_size_t rank(const Comparable& data) const {
+                    cc_size_t result = 0;
+                    const RedBlackNode<Comparable, Augment>* node = this->_M_header;
+                    while(_M_Nil != node) {
+                        if(node->_data < data) {
+                            result += node->_leftChild->_count + 1;
+                            node = node->_rightChild;
+                        } else {
+                            node = node->_leftChild;
+                        }
+                    }
+                    return result;
+                }
+
+                //NOTICE: the index-th smallest value counting from 0, nil() when index >= size()
+                RedBlackNode<Comparable, Augment>* select(cc_size_t index) const {
+                    RedBlackNode<Comparable, Augment>* node = this->_M_header;
+                    while(_M_Nil != node) {
+                        cc_size_t leftCount = node->_leftChild->_count;
+                        if(index < leftCount) {
+                            node = node->_leftChild;
+                        } else if(index == leftCount) {
+                            return node;
+                        } else {
+                            index -= leftCount + 1;
+                            node = node->_rightChild;
+                        }
+                    }
+                    return _M_Nil;
+                }
+
+                //NOTICE: number of values in [low, high)
+                cc_size_t rangeCount(const Comparable& low, const Comparable& high) const {
+                    if(!(low < high)) return 0;
+                    return rank(high) - rank(low);
+                }
+
+                //NOTICE: overlap() and stab() need Augment = RedBlackIntervalMax, see IntervalTree;
+                //calls visitor(interval) in order for every interval meeting [low, high], returns how many;
+                //a subtree whose largest end is below low is skipped, and so is everything starting after high
+                template<typename T, typename Visitor>
+                cc_size_t overlap(const T& low, const T& high, Visitor visitor) const {
+                    return overlap(this->_M_header, low, high, visitor);
+                }
+
+                //NOTICE: the intervals containing point
+                template<typename T, typename Visitor>
+                cc_size_t stab(const T& point, Visitor visitor) const {
+                    return overlap(this->_M_header, point, point, visitor);
+                }
+
+                //NOTICE: join based set operations (Blelloch, Ferizovic and Sun, Just Join for Parallel Ordered Sets);
+                //all of them are built on join(left, node, right), which links two trees around a middle node in O(height difference),
+                //so combining m values with n costs O(m log(n / m + 1)) instead of m inserts or removes,
+                //and the two halves of every level go to Fork once they are large;
+                //other must be another tree, its nodes move into this one (or are deleted) and it is left empty
+                void unionWith(RedBlackTree& other) {
+                    if(this == &other) return;
+
+                    cc_size_t otherSize = other._size;
+                    Node* root = takeNodes(other);
+                    int height = 0;
+                    cc_size_t duplicates = 0;
+                    root = unionTree(_M_header, blackHeight(_M_header), root, blackHeight(root), height, duplicates);
+                    setRoot(root, _size + otherSize - duplicates);
+                }
+
+                //NOTICE: deletes every node of both trees that is not in the result, O(n + m) in the worst case
+                void intersectWith(RedBlackTree& other) {
+                    if(this == &other) return;
+
+                    Node* root = takeNodes(other);
+                    int height = 0;
+                    cc_size_t kept = 0;
+                    root = intersectTree(_M_header, blackHeight(_M_header), root, blackHeight(root), height, kept);
+                    setRoot(root, kept);
+                }
+
+                //NOTICE: removes the values of other from this tree
+                void differenceWith(RedBlackTree& other) {
+                    if(this == &other) {
+                        clear();
+                        return;
+                    }
+
+                    Node* root = takeNodes(other);
+                    int height = 0;
+                    cc_size_t removed = 0;
+                    root = differenceTree(_M_header, blackHeight(_M_header), root, blackHeight(root), height, removed);
+                    setRoot(root, _size - removed);
+                }
+
+                //NOTICE: moves the values not less than key into right, which is emptied first;
+                //cutting the tree is O(log n), but every tree has its own nil and each moved node is visited once to change it
+                void split(const Comparable& key, RedBlackTree& right) {
+                    if(this == &right) return;
+                    right.clear();
+
+                    Node* left = _M_Nil;
+                    Node* rightRoot = _M_Nil;
+                    int leftHeight = 0, rightHeight = 0;
+                    Node* found = splitTree(_M_header, blackHeight(_M_header), key, left, leftHeight, rightRoot, rightHeight);
+                    if(_M_Nil != found) {
+                        rightRoot = joinTree(_M_Nil, 0, found, rightRoot, rightHeight, rightHeight);
+                    }
+
+                    cc_size_t moved = moveNodes(rightRoot, _M_Nil, right._M_Nil, rightHeight);
+                    setRoot(left, _size - moved);
+                    right.setRoot(rightRoot, moved);
+                }
+
             private:
-                RedBlackNode<Comparable>* find(const Comparable& data, RedBlackNode<Comparable>*& root) {
+                template<typename Writer>
+                void dump(Writer& writer, const RedBlackNode<Comparable, Augment>* root, bool& first) const {
+                    if(_M_Nil == root) return;
+
+                    dump(writer, root->_leftChild, first);
+                    if(!first) writer << ", ";
+                    writer << root->_data;
+                    first = false;
+                    dump(writer, root->_rightChild, first);
+                }
+
+                template<typename T, typename Visitor>
+                cc_size_t overlap(const Node* node, const T& low, const T& high, Visitor& visitor) const {
+                    cc_size_t count = 0;
+                    while(_M_Nil != node && !(node->_max < low)) {
+                        count += overlap(node->_leftChild, low, high, visitor);
+                        if(high < node->_data._low) break;  //NOTICE: the right subtree starts even later
+                        if(!(node->_data._high < low)) {
+                            visitor(node->_data);
+                            ++count;
+                        }
+                        node = node->_rightChild;
+                    }
+                    return count;
+                }
+
+                RedBlackNode<Comparable, Augment>* find(const Comparable& data, RedBlackNode<Comparable, Augment>*& root) {
                     if(_M_Nil == root) {   //not found
                         return _M_Nil;
                     }
@@ -287,7 +605,7 @@ namespace cclib
                     }
                 }
 
-                RedBlackNode<Comparable>* findMin(RedBlackNode<Comparable>* root) const {
+                RedBlackNode<Comparable, Augment>* findMin(RedBlackNode<Comparable, Augment>* root) const {
                     if(_M_Nil == root) {
                         return _M_Nil;
                     }
@@ -299,7 +617,7 @@ namespace cclib
                     return root;
                 }
 
-                RedBlackNode<Comparable>* findMax(RedBlackNode<Comparable>* root) const {
+                RedBlackNode<Comparable, Augment>* findMax(RedBlackNode<Comparable, Augment>* root) const {
                     if(_M_Nil == root) {
                         return _M_Nil;
                     }
@@ -311,15 +629,21 @@ namespace cclib
                     return root;
                 }
 
-                void remove(const Comparable& data, RedBlackNode<Comparable>*& root) {
-                    RedBlackNode<Comparable>* node = find(data, root);
+                void remove(const Comparable& data, RedBlackNode<Comparable, Augment>*& root) {
+                    RedBlackNode<Comparable, Augment>* node = find(data, root);
 
                     if(_M_Nil == node) return;
 
                     remove(node);
                 }
 
-                void transplant(RedBlackNode<Comparable>* originalNode, RedBlackNode<Comparable>* replaceNode) {
+                void updatePath(RedBlackNode<Comparable, Augment>* node) {
+                    for(; _M_Nil != node; node = node->_parent) {
+                        Augment::update(node);
+                    }
+                }
+
+                void transplant(RedBlackNode<Comparable, Augment>* originalNode, RedBlackNode<Comparable, Augment>* replaceNode) {
                     if(_M_Nil == originalNode->_parent) {
                         _M_header = replaceNode;
                     } else if(EN_Left == originalNode->direction()) {
@@ -331,10 +655,10 @@ namespace cclib
                     replaceNode->_parent = originalNode->_parent;
                 }
 
-                void deleteFixUp(RedBlackNode<Comparable>*& node) {
+                void deleteFixUp(RedBlackNode<Comparable, Augment>*& node) {
                     while(node != _M_header && node->_color == EN_Black) {
                         if(EN_Left == node->direction()) {    //case 1
-                            RedBlackNode<Comparable>* uncle = node->_parent->_rightChild;
+                            RedBlackNode<Comparable, Augment>* uncle = node->_parent->_rightChild;
                             if(uncle->_color == EN_Red) {
                                 uncle->_color = EN_Black;
                                 node->_parent->_color = EN_Red;
@@ -359,7 +683,7 @@ namespace cclib
                                 node = _M_header;
                             }
                         } else {    //FIXME: the same with left?
-                            RedBlackNode<Comparable>* uncle = node->_parent->_leftChild;
+                            RedBlackNode<Comparable, Augment>* uncle = node->_parent->_leftChild;
                             if(uncle->_color == EN_Red) {
                                 uncle->_color = EN_Black;
                                 node->_parent->_color = EN_Red;
@@ -375,7 +699,7 @@ namespace cclib
                                 uncle->_rightChild->_color = EN_Black;
                                 uncle->_color = EN_Red;
                                 rotateLeft(uncle);
-                                uncle = node->_parent->_rightChild; //NOTICE: repeat while to case 4
+                                uncle = node->_parent->_leftChild; //NOTICE: repeat while to case 4
                             } else {    //case 4
                                 uncle->_color = node->_parent->_color;
                                 node->_parent->_color = EN_Black;
@@ -388,10 +712,10 @@ namespace cclib
                     node->_color = EN_Black;
                 }
 
-                void insertFixUp(RedBlackNode<Comparable>* node) {
+                void insertFixUp(RedBlackNode<Comparable, Augment>* node) {
                     while(EN_Red == node->_parent->_color) {
                         if(EN_Left == node->_parent->direction()) {
-                            RedBlackNode<Comparable>* uncle = node->grandParent()->_rightChild;
+                            RedBlackNode<Comparable, Augment>* uncle = node->grandParent()->_rightChild;
                             if(EN_Red == uncle->_color) {
                                 node->_parent->_color = EN_Black;
                                 uncle->_color = EN_Black;
@@ -407,7 +731,7 @@ namespace cclib
                             }
 
                         } else {
-                            RedBlackNode<Comparable>* uncle = node->grandParent()->_leftChild;
+                            RedBlackNode<Comparable, Augment>* uncle = node->grandParent()->_leftChild;
                             if(EN_Red == uncle->_color) {
                                 node->_parent->_color = EN_Black;
                                 uncle->_color = EN_Black;
@@ -426,13 +750,22 @@ namespace cclib
                     _M_header->_color = EN_Black;
                 }
 
-                bool insert(RedBlackNode<Comparable>* node) {
-                    RedBlackNode<Comparable>* insertNode = _M_Nil;
-                    RedBlackNode<Comparable>* rootNode = _M_header;
+                bool insert(RedBlackNode<Comparable, Augment>* node) {
+                    RedBlackNode<Comparable, Augment>* insertNode = _M_Nil;
+                    RedBlackNode<Comparable, Augment>* rootNode = _M_header;
+                    bool leftmost = true, rightmost = true;
 
                     while(rootNode != _M_Nil) {
                         insertNode = rootNode;
-                        rootNode = node->_data < rootNode->_data ? rootNode->_leftChild : rootNode->_rightChild;
+                        if(node->_data < rootNode->_data) {
+                            rootNode = rootNode->_leftChild;
+                            rightmost = false;
+                        } else if(rootNode->_data < node->_data) {
+                            rootNode = rootNode->_rightChild;
+                            leftmost = false;
+                        } else {    //NOTICE: an equal value may sit anywhere on the path, not only at the last node
+                            return false;
+                        }
                     }
 
                     node->_parent = insertNode;
@@ -441,18 +774,17 @@ namespace cclib
                         _M_header = node;
                     } else if(node->_data < insertNode->_data) {
                         insertNode->_leftChild = node;
-                    } else if(node->_data > insertNode->_data) {
-                        insertNode->_rightChild = node;
                     } else {
-                        --_size;
-                        return false;
+                        insertNode->_rightChild = node;
                     }
 
+                    if(leftmost) _M_Nil->_leftChild = node;
+                    if(rightmost) _M_Nil->_rightChild = node;
                     return true;
                 }
 
-                void rotateRight(RedBlackNode<Comparable>* y) {
-                    RedBlackNode<Comparable>* x = y->_leftChild;
+                void rotateRight(RedBlackNode<Comparable, Augment>* y) {
+                    RedBlackNode<Comparable, Augment>* x = y->_leftChild;
                     y->_leftChild = x->_rightChild; //1. rotate x child
 
                     if(_M_Nil != x->_rightChild) { //2. rotate child parent
@@ -473,10 +805,13 @@ namespace cclib
                     //5. rotate two node
                     x->_rightChild = y;
                     y->_parent = x;
+
+                    Augment::update(y); //6. y is below x now
+                    Augment::update(x);
                 }
 
-                void rotateLeft(RedBlackNode<Comparable>* x) {
-                    RedBlackNode<Comparable>* y = x->_rightChild;
+                void rotateLeft(RedBlackNode<Comparable, Augment>* x) {
+                    RedBlackNode<Comparable, Augment>* y = x->_rightChild;
                     x->_rightChild = y->_leftChild; //1. rotate y child
 
                     if(_M_Nil != y->_leftChild) {
@@ -496,17 +831,349 @@ namespace cclib
                     //5. rotate two node
                     y->_leftChild = x;  //y child
                     x->_parent = y; //x parent
+
+                    Augment::update(x); //6. x is below y now
+                    Augment::update(y);
+                }
+
+                //NOTICE: set operation helpers, they work on detached subtrees with their black height (black nodes from the root down, nil excluded);
+                //subtrees may have a red root, only setRoot() paints the final root black;
+                //nil is shared by all the threads of one operation, it is read but never written
+
+                //NOTICE: a subtree of black height 8 holds at least 255 values, below that a task costs more than it saves
+                static const int PARALLEL_HEIGHT = 8;
+
+                template<typename Left, typename Right>
+                static void invoke(bool parallel, const Left& left, const Right& right) {
+                    if(parallel) {
+                        Fork::invoke(left, right);
+                    } else {
+                        left();
+                        right();
+                    }
+                }
+
+                int blackHeight(const Node* node) const {
+                    int height = 0;
+                    for(; _M_Nil != node; node = node->_leftChild) {
+                        if(EN_Black == node->_color) ++height;
+                    }
+                    return height;
+                }
+
+                static int childHeight(const Node* node, int height) {
+                    return EN_Black == node->_color ? height - 1 : height;
+                }
+
+                void setRoot(Node* root, cc_size_t size) {
+                    if(_M_Nil != root) {
+                        root->_parent = _M_Nil;
+                        root->_color = EN_Black;
+                    }
+                    _M_header = root;
+                    _size = size;
+                    _M_Nil->_parent = _M_Nil;
+                    _M_Nil->_leftChild = findMin(root);
+                    _M_Nil->_rightChild = findMax(root);
+                }
+
+                //NOTICE: points the nil links under root at nil instead of from, returns the number of nodes
+                static cc_size_t moveNodes(Node*& root, Node* from, Node* nil, int height) {
+                    if(from == root) {
+                        root = nil;
+                        return 0;
+                    }
+
+                    int below = childHeight(root, height);
+                    cc_size_t leftCount = 0, rightCount = 0;
+                    invoke(below >= PARALLEL_HEIGHT,
+                           [&]() { leftCount = moveNodes(root->_leftChild, from, nil, below); },
+                           [&]() { rightCount = moveNodes(root->_rightChild, from, nil, below); });
+                    return leftCount + rightCount + 1;
+                }
+
+                //NOTICE: moves the nodes of the smaller tree to the nil of the larger one, which becomes the nil of this tree;
+                //returns the root of other and leaves other empty
+                Node* takeNodes(RedBlackTree& other) {
+                    Node* root = other._M_header;
+                    if(other._size <= _size) {
+                        moveNodes(root, other._M_Nil, _M_Nil, other.blackHeight(root));
+                    } else {
+                        moveNodes(_M_header, _M_Nil, other._M_Nil, blackHeight(_M_header));
+                        Node* nil = _M_Nil;
+                        _M_Nil = other._M_Nil;
+                        other._M_Nil = nil;
+                    }
+                    other.setRoot(other._M_Nil, 0);
+                    return root;
+                }
+
+                void disposeTree(Node* root, int height) {
+                    if(_M_Nil == root) return;
+
+                    int below = childHeight(root, height);
+                    Node* leftChild = root->_leftChild;
+                    Node* rightChild = root->_rightChild;
+                    delete root;
+                    invoke(below >= PARALLEL_HEIGHT,
+                           [&]() { disposeTree(leftChild, below); },
+                           [&]() { disposeTree(rightChild, below); });
+                }
+
+                Node* link(Node* node, Node* left, Node* right, RedBlackColor color) {
+                    node->_leftChild = left;
+                    node->_rightChild = right;
+                    node->_color = color;
+                    if(_M_Nil != left) left->_parent = node;
+                    if(_M_Nil != right) right->_parent = node;
+                    Augment::update(node);
+                    return node;
+                }
+
+                //NOTICE: leftHeight >= rightHeight; walks down the right spine of left to a black node of rightHeight, node takes its place as red;
+                //a red node under a red one is rotated away on the way back up, only a red root with a red right child can be left over
+                Node* joinRight(Node* left, int leftHeight, Node* node, Node* right, int rightHeight) {
+                    if(EN_Black == left->_color && leftHeight == rightHeight) {
+                        return link(node, left, right, EN_Red);
+                    }
+
+                    Node* child = joinRight(left->_rightChild, childHeight(left, leftHeight), node, right, rightHeight);
+                    left->_rightChild = child;
+                    child->_parent = left;
+                    if(EN_Black == left->_color && EN_Red == child->_color && EN_Red == child->_rightChild->_color) {
+                        child->_rightChild->_color = EN_Black;
+                        left->_rightChild = child->_leftChild;
+                        if(_M_Nil != child->_leftChild) child->_leftChild->_parent = left;
+                        Augment::update(left);
+                        child->_leftChild = left;
+                        left->_parent = child;
+                        Augment::update(child);
+                        return child;
+                    }
+                    Augment::update(left);
+                    return left;
+                }
+
+                Node* joinLeft(Node* left, int leftHeight, Node* node, Node* right, int rightHeight) {
+                    if(EN_Black == right->_color && leftHeight == rightHeight) {
+                        return link(node, left, right, EN_Red);
+                    }
+
+                    Node* child = joinLeft(left, leftHeight, node, right->_leftChild, childHeight(right, rightHeight));
+                    right->_leftChild = child;
+                    child->_parent = right;
+                    if(EN_Black == right->_color && EN_Red == child->_color && EN_Red == child->_leftChild->_color) {
+                        child->_leftChild->_color = EN_Black;
+                        right->_leftChild = child->_rightChild;
+                        if(_M_Nil != child->_rightChild) child->_rightChild->_parent = right;
+                        Augment::update(right);
+                        child->_rightChild = right;
+                        right->_parent = child;
+                        Augment::update(child);
+                        return child;
+                    }
+                    Augment::update(right);
+                    return right;
+                }
+
+                //NOTICE: every value of left < node < every value of right, height is the black height of the result
+                Node* joinTree(Node* left, int leftHeight, Node* node, Node* right, int rightHeight, int& height) {
+                    if(leftHeight > rightHeight) {
+                        Node* root = joinRight(left, leftHeight, node, right, rightHeight);
+                        height = leftHeight;
+                        if(EN_Red == root->_color && EN_Red == root->_rightChild->_color) {
+                            root->_color = EN_Black;
+                            ++height;
+                        }
+                        return root;
+                    }
+                    if(rightHeight > leftHeight) {
+                        Node* root = joinLeft(left, leftHeight, node, right, rightHeight);
+                        height = rightHeight;
+                        if(EN_Red == root->_color && EN_Red == root->_leftChild->_color) {
+                            root->_color = EN_Black;
+                            ++height;
+                        }
+                        return root;
+                    }
+
+                    if(EN_Black == left->_color && EN_Black == right->_color) {
+                        height = leftHeight;
+                        return link(node, left, right, EN_Red);
+                    }
+                    height = leftHeight + 1;
+                    return link(node, left, right, EN_Black);
+                }
+
+                //NOTICE: cuts root into the values less than key and the values greater than key, returns the node equal to key or nil
+                Node* splitTree(Node* root, int height, const Comparable& key, Node*& left, int& leftHeight, Node*& right, int& rightHeight) {
+                    if(_M_Nil == root) {
+                        left = right = _M_Nil;
+                        leftHeight = rightHeight = 0;
+                        return _M_Nil;
+                    }
+
+                    int below = childHeight(root, height);
+                    Node* leftChild = root->_leftChild;
+                    Node* rightChild = root->_rightChild;
+                    if(key < root->_data) {
+                        Node* found = splitTree(leftChild, below, key, left, leftHeight, right, rightHeight);
+                        right = joinTree(right, rightHeight, root, rightChild, below, rightHeight);
+                        return found;
+                    }
+                    if(root->_data < key) {
+                        Node* found = splitTree(rightChild, below, key, left, leftHeight, right, rightHeight);
+                        left = joinTree(leftChild, below, root, left, leftHeight, leftHeight);
+                        return found;
+                    }
+
+                    left = leftChild;
+                    right = rightChild;
+                    leftHeight = rightHeight = below;
+                    return root;
+                }
+
+                //NOTICE: takes the largest node out of root, rest is what is left
+                Node* splitLast(Node* root, int height, Node*& rest, int& restHeight) {
+                    int below = childHeight(root, height);
+                    Node* leftChild = root->_leftChild;
+                    if(_M_Nil == root->_rightChild) {
+                        rest = leftChild;
+                        restHeight = below;
+                        return root;
+                    }
+
+                    Node* last = splitLast(root->_rightChild, below, rest, restHeight);
+                    rest = joinTree(leftChild, below, root, rest, restHeight, restHeight);
+                    return last;
+                }
+
+                //NOTICE: join without a middle node, every value of left < every value of right
+                Node* concatTree(Node* left, int leftHeight, Node* right, int rightHeight, int& height) {
+                    if(_M_Nil == left) {
+                        height = rightHeight;
+                        return right;
+                    }
+
+                    Node* rest = _M_Nil;
+                    int restHeight = 0;
+                    Node* last = splitLast(left, leftHeight, rest, restHeight);
+                    return joinTree(rest, restHeight, last, right, rightHeight, height);
+                }
+
+                //NOTICE: split b by the root of a, unite the two sides in parallel, join them back around the root of a
+                Node* unionTree(Node* a, int aHeight, Node* b, int bHeight, int& height, cc_size_t& duplicates) {
+                    if(_M_Nil == a) {
+                        height = bHeight;
+                        return b;
+                    }
+                    if(_M_Nil == b) {
+                        height = aHeight;
+                        return a;
+                    }
+
+                    Node* less = _M_Nil;
+                    Node* greater = _M_Nil;
+                    int lessHeight = 0, greaterHeight = 0;
+                    Node* found = splitTree(b, bHeight, a->_data, less, lessHeight, greater, greaterHeight);
+                    if(_M_Nil != found) {
+                        delete found;
+                        ++duplicates;
+                    }
+
+                    int below = childHeight(a, aHeight);
+                    Node* aLeft = a->_leftChild;
+                    Node* aRight = a->_rightChild;
+                    Node* left = _M_Nil;
+                    Node* right = _M_Nil;
+                    int leftHeight = 0, rightHeight = 0;
+                    cc_size_t rightDuplicates = 0;
+                    invoke(below >= PARALLEL_HEIGHT && bHeight >= PARALLEL_HEIGHT,
+                           [&]() { left = unionTree(aLeft, below, less, lessHeight, leftHeight, duplicates); },
+                           [&]() { right = unionTree(aRight, below, greater, greaterHeight, rightHeight, rightDuplicates); });
+                    duplicates += rightDuplicates;
+                    return joinTree(left, leftHeight, a, right, rightHeight, height);
+                }
+
+                Node* intersectTree(Node* a, int aHeight, Node* b, int bHeight, int& height, cc_size_t& kept) {
+                    if(_M_Nil == a || _M_Nil == b) {
+                        disposeTree(a, aHeight);
+                        disposeTree(b, bHeight);
+                        height = 0;
+                        return _M_Nil;
+                    }
+
+                    Node* less = _M_Nil;
+                    Node* greater = _M_Nil;
+                    int lessHeight = 0, greaterHeight = 0;
+                    Node* found = splitTree(b, bHeight, a->_data, less, lessHeight, greater, greaterHeight);
+
+                    int below = childHeight(a, aHeight);
+                    Node* aLeft = a->_leftChild;
+                    Node* aRight = a->_rightChild;
+                    Node* left = _M_Nil;
+                    Node* right = _M_Nil;
+                    int leftHeight = 0, rightHeight = 0;
+                    cc_size_t rightKept = 0;
+                    invoke(below >= PARALLEL_HEIGHT && bHeight >= PARALLEL_HEIGHT,
+                           [&]() { left = intersectTree(aLeft, below, less, lessHeight, leftHeight, kept); },
+                           [&]() { right = intersectTree(aRight, below, greater, greaterHeight, rightHeight, rightKept); });
+                    kept += rightKept;
+
+                    if(_M_Nil != found) {
+                        delete found;
+                        ++kept;
+                        return joinTree(left, leftHeight, a, right, rightHeight, height);
+                    }
+                    delete a;
+                    return concatTree(left, leftHeight, right, rightHeight, height);
+                }
+
+                //NOTICE: a without the values of b, split a by the root of b
+                Node* differenceTree(Node* a, int aHeight, Node* b, int bHeight, int& height, cc_size_t& removed) {
+                    if(_M_Nil == a) {
+                        disposeTree(b, bHeight);
+                        height = 0;
+                        return _M_Nil;
+                    }
+                    if(_M_Nil == b) {
+                        height = aHeight;
+                        return a;
+                    }
+
+                    Node* less = _M_Nil;
+                    Node* greater = _M_Nil;
+                    int lessHeight = 0, greaterHeight = 0;
+                    Node* found = splitTree(a, aHeight, b->_data, less, lessHeight, greater, greaterHeight);
+                    if(_M_Nil != found) {
+                        delete found;
+                        ++removed;
+                    }
+
+                    int below = childHeight(b, bHeight);
+                    Node* bLeft = b->_leftChild;
+                    Node* bRight = b->_rightChild;
+                    delete b;
+                    Node* left = _M_Nil;
+                    Node* right = _M_Nil;
+                    int leftHeight = 0, rightHeight = 0;
+                    cc_size_t rightRemoved = 0;
+                    invoke(below >= PARALLEL_HEIGHT && aHeight >= PARALLEL_HEIGHT,
+                           [&]() { left = differenceTree(less, lessHeight, bLeft, below, leftHeight, removed); },
+                           [&]() { right = differenceTree(greater, greaterHeight, bRight, below, rightHeight, rightRemoved); });
+                    removed += rightRemoved;
+                    return concatTree(left, leftHeight, right, rightHeight, height);
                 }
 
                 //DEPRECATED:
-                void deleteNode(RedBlackNode<Comparable>*& node) {
+                void deleteNode(RedBlackNode<Comparable, Augment>*& node) {
                     // node->_data.~Comparable();  //TODO: destruct?
                     delete node;
                     node = _M_Nil;
                 }
 
                 //DEPRECATED:
-                void removeFixUp(RedBlackNode<Comparable>*& node) {
+                void removeFixUp(RedBlackNode<Comparable, Augment>*& node) {
                     if(_M_Nil == node) {
                         --_size;
                         return;
@@ -526,7 +1193,7 @@ namespace cclib
                     }
 
                     if(EN_Left == node->direction()) {
-                        RedBlackNode<Comparable>* uncle = node->uncle();
+                        RedBlackNode<Comparable, Augment>* uncle = node->uncle();
                         if(EN_Red == uncle->_color) {
                             uncle->_color = EN_Black;
                             node->_parent->_color = EN_Red;
@@ -542,12 +1209,116 @@ namespace cclib
 
             private:
                 cc_size_t _size;
-                RedBlackNode<Comparable> *_M_header;
-                RedBlackNode<Comparable> *_M_Nil;
+                RedBlackNode<Comparable, Augment> *_M_header;
+                RedBlackNode<Comparable, Augment> *_M_Nil;
+        };
+
+        //NOTICE: red black tree of closed intervals keeping the largest end of every subtree
+        template<typename T>
+        using IntervalTree = RedBlackTree<Interval<T>, RedBlackIntervalMax<T> >;
+
+        //NOTICE: a balancing policy is a base class of BinaryNode, update() refreshes its field after a rotation,
+        //balance() repairs root on the way back up from every recursive insert and remove
+        struct BinaryNoBalance {
+            template<typename Node>
+            static void update(Node*) {}
+
+            template<typename Node>
+            static void balance(Node*&) {}
+        };
+
+        //NOTICE: root is replaced by its left child, which gets root as right child
+        template<typename Node>
+        void rotateWithLeftChild(Node*& root) {
+            Node* child = root->_leftChild;
+            root->_leftChild = child->_rightChild;
+            child->_rightChild = root;
+            Node::update(root);
+            Node::update(child);
+            root = child;
+        }
+
+        template<typename Node>
+        void rotateWithRightChild(Node*& root) {
+            Node* child = root->_rightChild;
+            root->_rightChild = child->_leftChild;
+            child->_leftChild = root;
+            Node::update(root);
+            Node::update(child);
+            root = child;
+        }
+
+        //NOTICE: randomized treap, every node draws a random priority and no child has a smaller one than its parent,
+        //so the shape is that of a random insertion order whatever the real order was, expected depth O(log n);
+        //removal copies the successor up and splices out a node with one child, which keeps the heap order as it is
+        struct BinaryTreapBalance {
+            uint32_t _priority;
+
+            BinaryTreapBalance(): _priority(nextPriority()) {}
+
+            template<typename Node>
+            static void update(Node*) {}
+
+            template<typename Node>
+            static void balance(Node*& root) {
+                if(CC_NULL == root) return;
+
+                if(CC_NULL != root->_leftChild && root->_leftChild->_priority < root->_priority) {
+                    rotateWithLeftChild(root);
+                } else if(CC_NULL != root->_rightChild && root->_rightChild->_priority < root->_priority) {
+                    rotateWithRightChild(root);
+                }
+            }
+
+            //COMMENT: per-thread xorshift, trees on different threads draw priorities without sharing a state
+            static uint32_t nextPriority() {
+                static thread_local uint32_t state = (uint32_t)(uintptr_t)&state | 1;
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                return state;
+            }
+        };
+
+        //NOTICE: AVL, the heights of the two subtrees of any node differ by at most one, depth below 1.44 log n
+        struct BinaryAVLBalance {
+            int _height;
+
+            BinaryAVLBalance(): _height(1) {}
+
+            template<typename Node>
+            static int height(const Node* node) {
+                return CC_NULL == node ? 0 : node->_height;
+            }
+
+            template<typename Node>
+            static void update(Node* node) {
+                int left = height(node->_leftChild), right = height(node->_rightChild);
+                node->_height = (left > right ? left : right) + 1;
+            }
+
+            template<typename Node>
+            static void balance(Node*& root) {
+                if(CC_NULL == root) return;
+
+                if(height(root->_leftChild) - height(root->_rightChild) > 1) {
+                    if(height(root->_leftChild->_leftChild) < height(root->_leftChild->_rightChild)) {
+                        rotateWithRightChild(root->_leftChild); //NOTICE: double rotation
+                    }
+                    rotateWithLeftChild(root);
+                } else if(height(root->_rightChild) - height(root->_leftChild) > 1) {
+                    if(height(root->_rightChild->_rightChild) < height(root->_rightChild->_leftChild)) {
+                        rotateWithLeftChild(root->_rightChild);
+                    }
+                    rotateWithRightChild(root);
+                } else {
+                    update(root);
+                }
+            }
         };
 
-        template<typename Comparable>
-        struct BinaryNode {
+        template<typename Comparable, typename Balance = BinaryNoBalance>
+        struct BinaryNode: public Balance {
             Comparable _data;
             BinaryNode* _leftChild;
             BinaryNode* _rightChild;
@@ -555,7 +1326,7 @@ namespace cclib
             : _data(data), _leftChild(leftChild), _rightChild(rightChild) {}
         };
 
-        template<typename Comparable>
+        template<typename Comparable, typename Balance = BinaryNoBalance>
         class BinarySearchTree {
             public:
                 BinarySearchTree(): _size(0), _M_node(CC_NULL) {}
@@ -565,11 +1336,11 @@ namespace cclib
                 }
 
             public:
-                bool contains(const Comparable& data) {
-                    return preOrderTraversalHandle(data, this->_M_node);
+                bool contains(const Comparable& data) const {
+                    return CC_NULL != findNode(data);
                 }
 
-                BinaryNode<Comparable>* begin() {
+                BinaryNode<Comparable, Balance>* begin() {
                     return this->_M_node;
                 }
 
@@ -579,11 +1350,13 @@ namespace cclib
                 }
 
                 bool remove(const Comparable& data) {
-                    remove(data, this->_M_node);
+                    return remove(data, this->_M_node);
                 }
 
-                Comparable find(const Comparable& key) {  //TODO: change to callback
-                    return find(key, this->_M_node);
+                //NOTICE: Comparable() when key is not in the tree, see contains()
+                Comparable find(const Comparable& key) const {  //TODO: change to callback
+                    const BinaryNode<Comparable, Balance>* node = findNode(key);
+                    return CC_NULL == node ? Comparable() : node->_data;
                 }
 
                 cc_size_t size() {
@@ -595,42 +1368,71 @@ namespace cclib
                 }
 
                 bool clear() {
-                    clear(this->_M_node);
+                    return clear(this->_M_node);
+                }
+
+                //NOTICE: writes the values in order as {a, b, c}
+                template<typename Writer>
+                void dump(Writer& writer) const {
+                    bool first = true;
+                    writer << '{';
+                    dump(writer, this->_M_node, first);
+                    writer << '}';
                 }
 
             private:
-                bool clear(BinaryNode<Comparable>*& root) {
+                template<typename Writer>
+                void dump(Writer& writer, const BinaryNode<Comparable, Balance>* root, bool& first) const {
+                    if(CC_NULL == root) return;
+
+                    dump(writer, root->_leftChild, first);
+                    if(!first) writer << ", ";
+                    writer << root->_data;
+                    first = false;
+                    dump(writer, root->_rightChild, first);
+                }
+
+                bool clear(BinaryNode<Comparable, Balance>*& root) {
                     if(CC_NULL == root) {
                         return true;
                     }
 
-                    remove(root->_data, root);
-                    return clear(root);
+                    clear(root->_leftChild);
+                    clear(root->_rightChild);
+                    delete root;
+                    root = CC_NULL;
+                    --_size;
+                    return true;
                 }
 
-                bool remove(const Comparable& data, BinaryNode<Comparable>*& root) {
+                bool remove(const Comparable& data, BinaryNode<Comparable, Balance>*& root) {
                     if(CC_NULL == root) {   //not found
                         return false;
                     }
 
+                    bool result = true;
                     if(data < root->_data) {
-                        remove(data, root->_leftChild);
-                    } else if(data > root->_data) {
-                        remove(data, root->_rightChild);
-                    } else if(data == root->_data && root->_leftChild != CC_NULL && root->_rightChild != CC_NULL) {
+                        result = remove(data, root->_leftChild);
+                    } else if(root->_data < data) {
+                        result = remove(data, root->_rightChild);
+                    } else if(root->_leftChild != CC_NULL && root->_rightChild != CC_NULL) {
                         // root->_data.~Comparable();  //NOTICE: destruct?
                         root->_data = findMin(root->_rightChild)->_data;
-                        remove(root->_data, root->_rightChild);
-                    } else {    //data == root->_data && (root->_leftChild != CC_NULL || root->_rightChild != CC_NULL)
-                        BinaryNode<Comparable>* temp = root;
+                        result = remove(root->_data, root->_rightChild);
+                    } else {    //data == root->_data && (root->_leftChild == CC_NULL || root->_rightChild == CC_NULL)
+                        BinaryNode<Comparable, Balance>* temp = root;
                         root = root->_leftChild != CC_NULL ? root->_leftChild : root->_rightChild;
                         delete temp;    //NOTICE: delete?
                         --_size;
                         return true;
                     }
+
+                    Balance::balance(root);
+                    return result;
                 }
 
-                BinaryNode<Comparable>* findMin(BinaryNode<Comparable>*& root) const {
+                //NOTICE: root is a copy, walking it must not relink the caller's child pointer
+                BinaryNode<Comparable, Balance>* findMin(BinaryNode<Comparable, Balance>* root) const {
                     IS_POINT_NULL_POINT(root);
 
                     while(root->_leftChild != CC_NULL) {
@@ -640,7 +1442,7 @@ namespace cclib
                     return root;
                 }
 
-                BinaryNode<Comparable>* findMax(BinaryNode<Comparable>*& root) const {
+                BinaryNode<Comparable, Balance>* findMax(BinaryNode<Comparable, Balance>* root) const {
                     IS_POINT_NULL_POINT(root);
 
                     while(root->_rightChild != CC_NULL) {
@@ -650,23 +1452,22 @@ namespace cclib
                     return root;
                 }
 
-                Comparable find(const Comparable& key, BinaryNode<Comparable>*& root) {
-                    IS_POINT_NULL_POINT(root);
-
-                    if(key == root->_data) {
-                        return root->_data;
-                    }
-                    if(CC_NULL != root->_leftChild) {
-                        return find(key, root->_leftChild);
-                    }
-                    if(CC_NULL != root->_rightChild) {
-                        return find(key, root->_rightChild);
+                //NOTICE: one descent by key, O(depth)
+                const BinaryNode<Comparable, Balance>* findNode(const Comparable& key) const {
+                    const BinaryNode<Comparable, Balance>* root = this->_M_node;
+                    while(CC_NULL != root) {
+                        if(key < root->_data) {
+                            root = root->_leftChild;
+                        } else if(root->_data < key) {
+                            root = root->_rightChild;
+                        } else {
+                            return root;
+                        }
                     }
-
                     return CC_NULL;
                 }
 
-                bool preOrderTraversalHandle(const Comparable& data, const BinaryNode<Comparable>* root) {
+                bool preOrderTraversalHandle(const Comparable& data, const BinaryNode<Comparable, Balance>* root) {
                     IS_POINT_NULL_POINT(root);
 
                     if(data == root->_data)
@@ -679,7 +1480,7 @@ namespace cclib
                     return false;
                 }
 
-                bool inOrderTraversalHandle(const Comparable& data, const BinaryNode<Comparable>* root) {
+                bool inOrderTraversalHandle(const Comparable& data, const BinaryNode<Comparable, Balance>* root) {
                     IS_POINT_NULL_POINT(root);
 
                     if(CC_NULL != root->_leftChild)
@@ -692,7 +1493,7 @@ namespace cclib
                     return false;
                 }
 
-                bool postOrderTraversalHandle(const Comparable& data, const BinaryNode<Comparable>* root) {
+                bool postOrderTraversalHandle(const Comparable& data, const BinaryNode<Comparable, Balance>* root) {
                     IS_POINT_NULL_POINT(root);
 
                     if(CC_NULL != root->_leftChild)
@@ -705,28 +1506,30 @@ namespace cclib
                     return false;
                 }
 
-                bool insert(const Comparable& data, BinaryNode<Comparable>*& root) {
+                bool insert(const Comparable& data, BinaryNode<Comparable, Balance>*& root) {
                     bool result = true;
 
                     if(CC_NULL == root) {
-                        root = new BinaryNode<Comparable>(data, CC_NULL, CC_NULL);
+                        root = new BinaryNode<Comparable, Balance>(data, CC_NULL, CC_NULL);
                         ++_size;
+                        return result;
                     }
                     else if(data < root->_data) {
-                        insert(data, root->_leftChild);
+                        result = insert(data, root->_leftChild);
                     }
-                    else if(data > root->_data) {
-                        insert(data, root->_rightChild);
+                    else if(root->_data < data) {
+                        result = insert(data, root->_rightChild);
                     }
                     else    //NOTICE: duplicate data, do nothing
                         result = false;
 
+                    Balance::balance(root);
                     return result;
                 }
 
             private:
                 cc_size_t _size;
-                BinaryNode<Comparable>* _M_node;
+                BinaryNode<Comparable, Balance>* _M_node;
         };
     } // namespace adt
 } // namespace cclib
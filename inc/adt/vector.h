@@ -94,6 +94,10 @@ namespace cclib {
                     return *(_M_array + index);
                 }
 
+                const T& operator[] (cc_size_t index) const {
+                    return *(_M_array + index);
+                }
+
                 Iterator begin() {
                     return _M_array;
                 }
@@ -118,6 +122,17 @@ namespace cclib {
                     return 0 == _storage_count ? true : false;
                 }
 
+                //NOTICE: writes [a, b, c], writer is str::Writer or anything with operator<< for T
+                template<typename Writer>
+                void dump(Writer& writer) const {
+                    writer << '[';
+                    for(cc_size_t i = 0; i < _storage_count; i++) {
+                        if(0 != i) writer << ", ";
+                        writer << _M_array[i];
+                    }
+                    writer << ']';
+                }
+
                 bool push_back(const T& data) {
                     if(_size == _storage_count) {
                         doubleExpansion();
@@ -153,21 +168,13 @@ namespace cclib {
                         doubleExpansion();
                     }
 
-                    T* temp = new T[_size]();
-                    for(int i = 0; i < index; i++) {
-                        temp[i] = _M_array[i];
-                    }
-
-                    temp[index] = data;
-
-                    for(int i = index; i < _storage_count; i++) {
-                        temp[i + 1] = _M_array[i];
+                    //NOTICE: shift the tail in place, a new array only when full
+                    for(int i = _storage_count; i > index; i--) {
+                        _M_array[i] = _M_array[i - 1];
                     }
+                    _M_array[index] = data;
                     ++_storage_count;
 
-                    delete[] _M_array;
-                    _M_array = temp;
-
                     return true;
                 }
 
@@ -177,9 +184,9 @@ namespace cclib {
                 }
 
                 bool earse(cc_size_t index) {
-                    if(index > _storage_count) return false;
+                    if(index >= _storage_count) return false;
 
-                    for(int i = index; i < _size - 1; i++) {
+                    for(cc_size_t i = index; i + 1 < _storage_count; i++) {
                         _M_array[i] = _M_array[i + 1];
                     }
 
@@ -188,6 +195,31 @@ namespace cclib {
                     return true;
                 }
 
+                //NOTICE: grows the storage to hold capacity elements without another expansion, size() does not change
+                bool reserve(cc_size_t capacity) {
+                    if(capacity <= _size) return true;
+
+                    T* temp = new T[capacity]();
+                    for(cc_size_t i = 0; i < _storage_count; i++) {
+                        temp[i] = _M_array[i];
+                    }
+                    delete[] _M_array;
+                    _M_array = temp;
+                    _size = capacity;
+                    return true;
+                }
+
+                void swap(Vector<T>& instance) {
+                    cc_size_t size = _size, storageCount = _storage_count;
+                    T* array = _M_array;
+                    _size = instance._size;
+                    _storage_count = instance._storage_count;
+                    _M_array = instance._M_array;
+                    instance._size = size;
+                    instance._storage_count = storageCount;
+                    instance._M_array = array;
+                }
+
             private:
                 void doubleExpansion() {
                     _size = 2 * _size + 1;
@@ -0,0 +1,341 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: 64 bit non-cryptographic hashing
+ * hashBytes() is wyhash for short and medium input: 128 bit multiply-fold of 16 or 48 bytes per step;
+ * from HASH_LONG_INPUT bytes on it switches to XXH3 style stripes: eight 64 bit lanes, each adds the
+ * 32 x 32 bit product of its keyed data and its neighbour's raw data, a scramble every 1KB,
+ * the lanes are vector adds and multiplies with SSE2 / AVX2 and the same arithmetic without them,
+ * so the value never depends on the instruction set (the plain loop is slower than wyhash, the vector ones
+ * catch up at about 4KB with SSE2 and run 1.5x - 2x faster with AVX2, hence the threshold);
+ * every function takes a seed, use processSeed() where keys come from outside (hash flooding);
+ * Hash<T> is the functor for containers: integers, floating point, String, StringView and Pair.
+************************/
+#ifndef CCLIB_ALGORITHM_HASH_H
+#define CCLIB_ALGORITHM_HASH_H
+
+#include "./../../../cclib-common/inc/base/common_define.h"
+#include "./../../str/string.h"
+#include "./../../str/string_view.h"
+#include "./../../adt/pair.h"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace cclib {
+    namespace algorithm {
+        static const cc_size_t HASH_LONG_INPUT = 4096;
+
+        namespace detail {
+            static const uint64_t HASH_SECRET[4] = {0x2D358DCCAA6C78A5ULL, 0x8BB84B93962EACC9ULL, 0x4B33A62ED433D4A3ULL, 0x4D5A2DA51DE1AA47ULL};
+            static const uint64_t HASH_PRIME32 = 0x9E3779B1ULL;
+            static const cc_size_t HASH_STRIPE = 64;
+            static const cc_size_t HASH_STRIPES_PER_BLOCK = 16;
+
+            //COMMENT: 64 x 64 -> 128 bit product, low half in low, high half in high
+            inline void multiply128(uint64_t& low, uint64_t& high) {
+                #if defined(__SIZEOF_INT128__)
+                __uint128_t product = (__uint128_t)low * high;
+                low = (uint64_t)product;
+                high = (uint64_t)(product >> 64);
+                #else
+                uint64_t aHigh = low >> 32, aLow = (uint32_t)low, bHigh = high >> 32, bLow = (uint32_t)high;
+                uint64_t highHigh = aHigh * bHigh, highLow = aHigh * bLow, lowHigh = aLow * bHigh, lowLow = aLow * bLow;
+                uint64_t middle = (lowLow >> 32) + (uint32_t)highLow + (uint32_t)lowHigh;
+                low = (middle << 32) | (uint32_t)lowLow;
+                high = highHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+                #endif
+            }
+
+            inline uint64_t fold(uint64_t a, uint64_t b) {
+                multiply128(a, b);
+                return a ^ b;
+            }
+
+            inline uint64_t read64(const unsigned char* p) {
+                uint64_t value;
+                memcpy(&value, p, sizeof(value));
+                #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                value = __builtin_bswap64(value);
+                #endif
+                return value;
+            }
+
+            inline uint64_t read32(const unsigned char* p) {
+                uint32_t value;
+                memcpy(&value, p, sizeof(value));
+                #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                value = __builtin_bswap32(value);
+                #endif
+                return value;
+            }
+
+            //NOTICE: one to three bytes, the first, the middle and the last cover every byte
+            inline uint64_t read3(const unsigned char* p, cc_size_t length) {
+                return ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+            }
+
+            //COMMENT: lane i += (data[i] ^ key[i]).low32 * (data[i] ^ key[i]).high32 + data[i ^ 1]
+            inline void accumulateStripe(uint64_t* accumulator, const unsigned char* data, const uint64_t* key) {
+                #if defined(__AVX2__)
+                for(cc_size_t i = 0; i < 8; i += 4) {
+                    __m256i lanes = _mm256_loadu_si256((const __m256i*)(data + 8 * i));
+                    __m256i keyed = _mm256_xor_si256(lanes, _mm256_loadu_si256((const __m256i*)(key + i)));
+                    __m256i product = _mm256_mul_epu32(keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+                    __m256i swapped = _mm256_shuffle_epi32(lanes, _MM_SHUFFLE(1, 0, 3, 2));
+                    __m256i* target = (__m256i*)(accumulator + i);
+                    _mm256_storeu_si256(target, _mm256_add_epi64(_mm256_loadu_si256(target), _mm256_add_epi64(product, swapped)));
+                }
+                #elif defined(__SSE2__)
+                for(cc_size_t i = 0; i < 8; i += 2) {
+                    __m128i lanes = _mm_loadu_si128((const __m128i*)(data + 8 * i));
+                    __m128i keyed = _mm_xor_si128(lanes, _mm_loadu_si128((const __m128i*)(key + i)));
+                    __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+                    __m128i swapped = _mm_shuffle_epi32(lanes, _MM_SHUFFLE(1, 0, 3, 2));
+                    __m128i* target = (__m128i*)(accumulator + i);
+                    _mm_storeu_si128(target, _mm_add_epi64(_mm_loadu_si128(target), _mm_add_epi64(product, swapped)));
+                }
+                #else
+                for(cc_size_t i = 0; i < 8; i++) {
+                    uint64_t lane = read64(data + 8 * i);
+                    uint64_t keyed = lane ^ key[i];
+                    accumulator[i ^ 1] += lane;
+                    accumulator[i] += (keyed & 0xFFFFFFFFULL) * (keyed >> 32);
+                }
+                #endif
+            }
+
+            //COMMENT: lane = (lane ^ lane >> 47 ^ key) * PRIME32, keeps the high bits flowing into the next block
+            inline void scramble(uint64_t* accumulator, const uint64_t* key) {
+                #if defined(__SSE2__)
+                __m128i prime = _mm_set1_epi32((int)HASH_PRIME32);
+                for(cc_size_t i = 0; i < 8; i += 2) {
+                    __m128i* target = (__m128i*)(accumulator + i);
+                    __m128i lanes = _mm_loadu_si128(target);
+                    lanes = _mm_xor_si128(_mm_xor_si128(lanes, _mm_srli_epi64(lanes, 47)), _mm_loadu_si128((const __m128i*)(key + i)));
+                    __m128i low = _mm_mul_epu32(lanes, prime);
+                    __m128i high = _mm_mul_epu32(_mm_srli_epi64(lanes, 32), prime);
+                    _mm_storeu_si128(target, _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+                }
+                #else
+                for(cc_size_t i = 0; i < 8; i++) {
+                    uint64_t lane = accumulator[i];
+                    accumulator[i] = (lane ^ (lane >> 47) ^ key[i]) * HASH_PRIME32;
+                }
+                #endif
+            }
+
+            //NOTICE: the SIMD loads are little endian, the long path is defined on little endian data only
+            inline uint64_t hashLong(const unsigned char* p, cc_size_t length, uint64_t seed) {
+                uint64_t stripeKey[8], scrambleKey[8];
+                for(cc_size_t i = 0; i < 8; i++) {
+                    stripeKey[i] = fold(seed ^ HASH_SECRET[i & 3], HASH_SECRET[(i + 1) & 3] + i);
+                    scrambleKey[i] = fold(stripeKey[i] ^ HASH_SECRET[(i + 2) & 3], seed + i);
+                }
+
+                uint64_t accumulator[8] = {HASH_PRIME32, HASH_SECRET[0], HASH_SECRET[1], HASH_SECRET[2],
+                                           HASH_SECRET[3], ~HASH_SECRET[0], ~HASH_SECRET[1], HASH_PRIME32};
+                const cc_size_t blockSize = HASH_STRIPE * HASH_STRIPES_PER_BLOCK;
+                const unsigned char* last = p + length;
+                for(; last - p > (ptrdiff_t)blockSize; p += blockSize) {
+                    for(cc_size_t s = 0; s < HASH_STRIPES_PER_BLOCK; s++) {
+                        accumulateStripe(accumulator, p + s * HASH_STRIPE, stripeKey);
+                    }
+                    scramble(accumulator, scrambleKey);
+                }
+                for(; last - p > (ptrdiff_t)HASH_STRIPE; p += HASH_STRIPE) {
+                    accumulateStripe(accumulator, p, stripeKey);
+                }
+                //NOTICE: the final stripe is the last 64 bytes of the input, it may overlap the previous one
+                accumulateStripe(accumulator, last - HASH_STRIPE, scrambleKey);
+
+                uint64_t result = (uint64_t)length * 0x9E3779B97F4A7C15ULL;
+                for(cc_size_t i = 0; i < 8; i += 2) {
+                    result += fold(accumulator[i] ^ stripeKey[i], accumulator[i + 1] ^ scrambleKey[i + 1]);
+                }
+                return fold(result ^ HASH_SECRET[0], result ^ seed ^ HASH_SECRET[1]);
+            }
+        }   //namespace detail
+
+        //COMMENT: splitmix64 finalizer, a bijection, every input bit reaches every output bit
+        inline uint64_t mix64(uint64_t value) {
+            value ^= value >> 30;
+            value *= 0xBF58476D1CE4E5B9ULL;
+            value ^= value >> 27;
+            value *= 0x94D049BB133111EBULL;
+            value ^= value >> 31;
+            return value;
+        }
+
+        inline uint32_t mix32(uint32_t value) {
+            value ^= value >> 16;
+            value *= 0x7FEB352DU;
+            value ^= value >> 15;
+            value *= 0x846CA68BU;
+            value ^= value >> 16;
+            return value;
+        }
+
+        //NOTICE: order matters, hashCombine(a, b) != hashCombine(b, a)
+        inline uint64_t hashCombine(uint64_t seed, uint64_t value) {
+            return detail::fold(seed ^ detail::HASH_SECRET[0], value ^ detail::HASH_SECRET[1]);
+        }
+
+        inline uint64_t hashBytes(const void* data, cc_size_t length, uint64_t seed = 0) {
+            const unsigned char* p = static_cast<const unsigned char*>(data);
+            const uint64_t* secret = detail::HASH_SECRET;
+            #if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__
+            if(length >= HASH_LONG_INPUT) return detail::hashLong(p, length, seed);
+            #endif
+
+            seed ^= detail::fold(seed ^ secret[0], secret[1]);
+            uint64_t a = 0, b = 0;
+            if(length <= 16) {
+                if(length >= 4) {
+                    //COMMENT: two overlapping pairs of 4 byte reads cover 4..16 bytes
+                    cc_size_t step = (length >> 3) << 2;
+                    a = (detail::read32(p) << 32) | detail::read32(p + step);
+                    b = (detail::read32(p + length - 4) << 32) | detail::read32(p + length - 4 - step);
+                } else if(length > 0) {
+                    a = detail::read3(p, length);
+                }
+            } else {
+                cc_size_t rest = length;
+                if(rest > 48) {
+                    //COMMENT: three independent chains, the multiplies overlap in the pipeline
+                    uint64_t seed1 = seed, seed2 = seed;
+                    do {
+                        seed = detail::fold(detail::read64(p) ^ secret[1], detail::read64(p + 8) ^ seed);
+                        seed1 = detail::fold(detail::read64(p + 16) ^ secret[2], detail::read64(p + 24) ^ seed1);
+                        seed2 = detail::fold(detail::read64(p + 32) ^ secret[3], detail::read64(p + 40) ^ seed2);
+                        p += 48;
+                        rest -= 48;
+                    } while(rest > 48);
+                    seed ^= seed1 ^ seed2;
+                }
+                while(rest > 16) {
+                    seed = detail::fold(detail::read64(p) ^ secret[1], detail::read64(p + 8) ^ seed);
+                    p += 16;
+                    rest -= 16;
+                }
+                a = detail::read64(p + rest - 16);
+                b = detail::read64(p + rest - 8);
+            }
+
+            a ^= secret[1];
+            b ^= seed;
+            detail::multiply128(a, b);
+            return detail::fold(a ^ secret[0] ^ length, b ^ secret[1]);
+        }
+
+        //NOTICE: random per process, derived once from the clock and addresses (ASLR)
+        inline uint64_t processSeed() {
+            static const uint64_t seed = mix64((uint64_t)time(CC_NULL) ^ mix64((uint64_t)(size_t)&seed) ^ (uint64_t)clock() << 32);
+            return seed;
+        }
+
+        template<typename T>
+        struct Hash;
+
+        //COMMENT: one fold for every integer type, the seed goes into the other operand
+        #define CCLIB_HASH_INTEGER(Type) \
+        template<> \
+        struct Hash<Type> { \
+            uint64_t _seed; \
+            explicit Hash(uint64_t seed = 0): _seed(seed) {} \
+            uint64_t operator()(Type value) const { \
+                return detail::fold((uint64_t)value ^ detail::HASH_SECRET[0], _seed ^ detail::HASH_SECRET[1]); \
+            } \
+        };
+
+        CCLIB_HASH_INTEGER(bool)
+        CCLIB_HASH_INTEGER(char)
+        CCLIB_HASH_INTEGER(signed char)
+        CCLIB_HASH_INTEGER(unsigned char)
+        CCLIB_HASH_INTEGER(short)
+        CCLIB_HASH_INTEGER(unsigned short)
+        CCLIB_HASH_INTEGER(int)
+        CCLIB_HASH_INTEGER(unsigned int)
+        CCLIB_HASH_INTEGER(long)
+        CCLIB_HASH_INTEGER(unsigned long)
+        CCLIB_HASH_INTEGER(long long)
+        CCLIB_HASH_INTEGER(unsigned long long)
+        #undef CCLIB_HASH_INTEGER
+
+        //NOTICE: 0.0 and -0.0 compare equal and hash equal, NaN never finds itself anyway
+        template<>
+        struct Hash<double> {
+            uint64_t _seed;
+            explicit Hash(uint64_t seed = 0): _seed(seed) {}
+            uint64_t operator()(double value) const {
+                uint64_t bits = 0;
+                if(0.0 != value) memcpy(&bits, &value, sizeof(bits));
+                return Hash<uint64_t>(_seed)(bits);
+            }
+        };
+
+        template<>
+        struct Hash<float> {
+            uint64_t _seed;
+            explicit Hash(uint64_t seed = 0): _seed(seed) {}
+            uint64_t operator()(float value) const {
+                return Hash<double>(_seed)(value);
+            }
+        };
+
+        template<typename T>
+        struct Hash<T*> {
+            uint64_t _seed;
+            explicit Hash(uint64_t seed = 0): _seed(seed) {}
+            uint64_t operator()(const T* value) const {
+                return Hash<uint64_t>(_seed)((uint64_t)(size_t)value);
+            }
+        };
+
+        template<>
+        struct Hash<str::StringView> {
+            uint64_t _seed;
+            explicit Hash(uint64_t seed = 0): _seed(seed) {}
+            uint64_t operator()(const str::StringView& value) const {
+                return hashBytes(value.data(), value.size(), _seed);
+            }
+        };
+
+        //NOTICE: equal to the hash of a StringView over the same bytes, so either can look up the other
+        template<>
+        struct Hash<str::String> {
+            uint64_t _seed;
+            explicit Hash(uint64_t seed = 0): _seed(seed) {}
+            uint64_t operator()(const str::String& value) const {
+                return hashBytes(value.data(), value.size(), _seed);
+            }
+        };
+
+        //NOTICE: the key only, Pair::operator== compares the key only and equal pairs must hash alike
+        template<typename _Key, typename _Value>
+        struct Hash<adt::Pair<_Key, _Value> > {
+            uint64_t _seed;
+            explicit Hash(uint64_t seed = 0): _seed(seed) {}
+            uint64_t operator()(const adt::Pair<_Key, _Value>& value) const {
+                return Hash<_Key>(_seed)(value._key);
+            }
+        };
+    }   //namespace algorithm
+}   //namespace cclib
+
+#endif //CCLIB_ALGORITHM_HASH_H
@@ -0,0 +1,51 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Parallel red black tree set operations
+ * ParallelRedBlackTree is a RedBlackTree whose unionWith(), intersectWith(), differenceWith() and split()
+ * hand the two halves of every large subtree to ThreadPool::instance();
+ * kept out of adt/tree.h, so a plain RedBlackTree pulls in no threads and no pool.
+************************/
+#ifndef CCLIB_ALGORITHM_PARALLEL_TREE_H
+#define CCLIB_ALGORITHM_PARALLEL_TREE_H
+
+#include "./../../../cclib-common/inc/base/common_define.h"
+#include "./../../adt/tree.h"
+#include "thread_pool.h"
+#include <thread>
+
+namespace cclib {
+    namespace algorithm {
+        struct RedBlackParallelFork {
+            //NOTICE: on a single core the pool thread and the waiting caller only take turns, measured twice as slow as one thread
+            static bool multiCore() {
+                static const bool result = std::thread::hardware_concurrency() > 1;
+                return result;
+            }
+
+            template<typename Left, typename Right>
+            static void invoke(const Left& left, const Right& right) {
+                if(multiCore()) {
+                    parallelInvoke(left, right);
+                } else {
+                    left();
+                    right();
+                }
+            }
+        };
+
+        template<typename Comparable, typename Augment = adt::RedBlackNoAugment>
+        using ParallelRedBlackTree = adt::RedBlackTree<Comparable, Augment, RedBlackParallelFork>;
+    } // namespace algorithm
+} // namespace cclib
+
+#endif //CCLIB_ALGORITHM_PARALLEL_TREE_H
@@ -0,0 +1,526 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Work-stealing thread pool
+ * every worker owns a Chase-Lev deque: the owner pushes and takes at the bottom (LIFO, cache warm),
+ * idle workers steal from the top (FIFO, the biggest pieces of a divide-and-conquer job);
+ * threads outside the pool submit through a shared injection queue;
+ * a thread waiting for a task (future.get(), the join of parallelInvoke) runs other tasks meanwhile,
+ * so nested fork/join never blocks a worker and never needs extra threads;
+ * ThreadPool::instance() is one process-wide pool, algorithms share it instead of creating their own threads.
+************************/
+#ifndef CCLIB_ALGORITHM_THREAD_POOL_H
+#define CCLIB_ALGORITHM_THREAD_POOL_H
+
+#include "./../../../cclib-common/inc/base/common_define.h"
+#include "./../../adt/concurrent.h"
+#include "./../../adt/deque.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace cclib {
+    namespace algorithm {
+        struct Task {
+            typedef void (*RunFunction)(Task*);
+
+            RunFunction _run;
+            std::atomic<bool> _done;
+
+            explicit Task(RunFunction run): _run(run), _done(false) {}
+
+            //NOTICE: the task may delete itself in _run, do not touch it afterwards
+            void execute() {
+                _run(this);
+            }
+        };
+
+        class ChaseLevDeque {
+            public:
+                explicit ChaseLevDeque(long long capacity = 256): _M_top(0), _M_bottom(0), _M_array(new Array(capacity)) {
+                    _M_retired.push_back(_M_array.load());
+                }
+
+                ~ChaseLevDeque() {
+                    for(cc_size_t i = 0; i < _M_retired.size(); i++) {
+                        delete _M_retired[i];
+                    }
+                }
+
+            private:
+                ChaseLevDeque(const ChaseLevDeque& instance);
+                ChaseLevDeque& operator=(const ChaseLevDeque& instance);
+
+            public:
+                //NOTICE: owner thread only
+                void push(Task* task) {
+                    long long bottom = _M_bottom.load(std::memory_order_relaxed);
+                    long long top = _M_top.load(std::memory_order_acquire);
+                    Array* array = _M_array.load(std::memory_order_relaxed);
+                    if(bottom - top > array->_capacity - 1) {
+                        array = grow(array, top, bottom);
+                    }
+                    array->put(bottom, task);
+                    _M_bottom.store(bottom + 1, std::memory_order_release);
+                }
+
+                //NOTICE: owner thread only
+                Task* take() {
+                    long long bottom = _M_bottom.load(std::memory_order_relaxed) - 1;
+                    Array* array = _M_array.load(std::memory_order_relaxed);
+                    _M_bottom.store(bottom, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    long long top = _M_top.load(std::memory_order_relaxed);
+
+                    Task* task = CC_NULL;
+                    if(top <= bottom) {
+                        task = array->get(bottom);
+                        if(top == bottom) {
+                            //COMMENT: last element, race the thieves for it
+                            if(!_M_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                                task = CC_NULL;
+                            }
+                            _M_bottom.store(bottom + 1, std::memory_order_relaxed);
+                        }
+                    } else {
+                        _M_bottom.store(bottom + 1, std::memory_order_relaxed);
+                    }
+                    return task;
+                }
+
+                //NOTICE: any thread
+                Task* steal() {
+                    long long top = _M_top.load(std::memory_order_acquire);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    long long bottom = _M_bottom.load(std::memory_order_acquire);
+                    if(top >= bottom) return CC_NULL;
+
+                    Array* array = _M_array.load(std::memory_order_acquire);
+                    Task* task = array->get(top);
+                    if(!_M_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                        return CC_NULL;
+                    }
+                    return task;
+                }
+
+                bool empty() const {
+                    return _M_bottom.load(std::memory_order_relaxed) <= _M_top.load(std::memory_order_relaxed);
+                }
+
+            private:
+                struct Array {
+                    long long _capacity;
+                    std::atomic<Task*>* _M_buffer;
+
+                    explicit Array(long long capacity): _capacity(capacity), _M_buffer(new std::atomic<Task*>[capacity]) {}
+                    ~Array() {
+                        delete[] _M_buffer;
+                    }
+
+                    Task* get(long long index) {
+                        return _M_buffer[index & (_capacity - 1)].load(std::memory_order_relaxed);
+                    }
+
+                    void put(long long index, Task* task) {
+                        _M_buffer[index & (_capacity - 1)].store(task, std::memory_order_relaxed);
+                    }
+                };
+
+                //NOTICE: a thief may still read the old array, it is kept until the deque dies
+                Array* grow(Array* array, long long top, long long bottom) {
+                    Array* temp = new Array(2 * array->_capacity);
+                    for(long long i = top; i < bottom; i++) {
+                        temp->put(i, array->get(i));
+                    }
+                    _M_retired.push_back(temp);
+                    _M_array.store(temp, std::memory_order_release);
+                    return temp;
+                }
+
+            private:
+                //NOTICE: padding instead of alignas, the deques are heap allocated and C++11 new ignores over-alignment
+                std::atomic<long long> _M_top;
+                char _M_padding[CC_CACHE_LINE_SIZE - sizeof(std::atomic<long long>)];
+                std::atomic<long long> _M_bottom;
+                std::atomic<Array*> _M_array;
+                std::vector<Array*> _M_retired;
+        };
+
+        template<typename R>
+        struct TaskResult {
+            R _value;
+
+            template<typename Function>
+            void run(Function& function) {
+                _value = function();
+            }
+
+            R get() {
+                return std::move(_value);
+            }
+        };
+
+        template<>
+        struct TaskResult<void> {
+            template<typename Function>
+            void run(Function& function) {
+                function();
+            }
+
+            void get() {}
+        };
+
+        class ThreadPool;
+
+        template<typename R>
+        class TaskFuture {
+            public:
+                struct State {
+                    std::atomic<bool> _done;
+                    TaskResult<R> _result;
+                    std::exception_ptr _exception;
+
+                    State(): _done(false) {}
+                };
+
+            public:
+                TaskFuture(): _M_pool(CC_NULL) {}
+                TaskFuture(ThreadPool* pool, const std::shared_ptr<State>& state): _M_pool(pool), _M_state(state) {}
+
+                bool ready() const {
+                    return _M_state->_done.load(std::memory_order_acquire);
+                }
+
+                //NOTICE: runs other tasks while waiting, calling it from a worker does not deadlock the pool
+                R get();
+
+            private:
+                ThreadPool* _M_pool;
+                std::shared_ptr<State> _M_state;
+        };
+
+        class ThreadPool {
+            public:
+                //NOTICE: threadCount 0 means one less than the cores, the waiting caller is the last one
+                explicit ThreadPool(cc_size_t threadCount = 0): _stop(false), _M_signal(0), _M_sleepers(0) {
+                    if(0 == threadCount) {
+                        cc_size_t cores = std::thread::hardware_concurrency();
+                        threadCount = cores > 1 ? cores - 1 : 1;
+                    }
+
+                    for(cc_size_t i = 0; i < threadCount; i++) {
+                        _M_deques.push_back(new ChaseLevDeque());
+                    }
+                    for(cc_size_t i = 0; i < threadCount; i++) {
+                        _M_threads.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+                    }
+                }
+
+                ~ThreadPool() {
+                    {
+                        std::lock_guard<std::mutex> guard(_M_sleepMutex);
+                        _stop.store(true);
+                        _M_signal.fetch_add(1);
+                    }
+                    _M_sleepCondition.notify_all();
+
+                    for(cc_size_t i = 0; i < _M_threads.size(); i++) {
+                        _M_threads[i].join();
+                    }
+                    for(cc_size_t i = 0; i < _M_deques.size(); i++) {
+                        delete _M_deques[i];
+                    }
+                }
+
+                static ThreadPool& instance() {
+                    static ThreadPool pool;
+                    return pool;
+                }
+
+            private:
+                ThreadPool(const ThreadPool& instance);
+                ThreadPool& operator=(const ThreadPool& instance);
+
+            public:
+                cc_size_t threadCount() const {
+                    return _M_threads.size();
+                }
+
+                //COMMENT: workers plus the thread that waits for the result
+                cc_size_t concurrency() const {
+                    return _M_threads.size() + 1;
+                }
+
+                template<typename Function>
+                TaskFuture<typename std::result_of<Function()>::type> submit(Function function) {
+                    typedef typename std::result_of<Function()>::type R;
+                    std::shared_ptr<typename TaskFuture<R>::State> state = std::make_shared<typename TaskFuture<R>::State>();
+                    schedule(new FunctionTask<Function, R>(std::move(function), state));
+                    return TaskFuture<R>(this, state);
+                }
+
+                //COMMENT: fork right, run left on this thread, then join right
+                template<typename Left, typename Right>
+                void parallelInvoke(const Left& left, const Right& right) {
+                    InvokeTask<Right> task(right);
+                    schedule(&task);
+
+                    std::exception_ptr exception;
+                    try {
+                        left();
+                    } catch(...) {
+                        exception = std::current_exception();
+                    }
+
+                    join(&task);
+                    if(exception) std::rethrow_exception(exception);
+                    if(task._exception) std::rethrow_exception(task._exception);
+                }
+
+                //NOTICE: grain 0 picks one by itself, about 8 pieces per thread so that stealing can balance uneven work
+                template<typename Body>
+                void parallelFor(long long begin, long long end, const Body& body, long long grain = 0) {
+                    if(begin >= end) return;
+
+                    if(grain <= 0) {
+                        grain = (end - begin) / (8 * (long long)concurrency());
+                        if(grain < 1) grain = 1;
+                    }
+                    parallelForRange(begin, end, body, grain);
+                }
+
+                //NOTICE: run one pending task if there is any, used by everyone who has to wait
+                bool runPending() {
+                    Task* task = findTask(currentWorker());
+                    if(CC_NULL == task) return false;
+
+                    task->execute();
+                    return true;
+                }
+
+            private:
+                template<typename Function, typename R>
+                struct FunctionTask : public Task {
+                    Function _function;
+                    std::shared_ptr<typename TaskFuture<R>::State> _M_state;
+
+                    FunctionTask(Function&& function, const std::shared_ptr<typename TaskFuture<R>::State>& state):
+                     Task(&FunctionTask::run), _function(std::move(function)), _M_state(state) {}
+
+                    static void run(Task* base) {
+                        FunctionTask* task = static_cast<FunctionTask*>(base);
+                        try {
+                            task->_M_state->_result.run(task->_function);
+                        } catch(...) {
+                            task->_M_state->_exception = std::current_exception();
+                        }
+                        task->_M_state->_done.store(true, std::memory_order_release);
+                        delete task;
+                    }
+                };
+
+                template<typename Function>
+                struct InvokeTask : public Task {
+                    const Function& _function;
+                    std::exception_ptr _exception;
+
+                    explicit InvokeTask(const Function& function): Task(&InvokeTask::run), _function(function) {}
+
+                    static void run(Task* base) {
+                        InvokeTask* task = static_cast<InvokeTask*>(base);
+                        try {
+                            task->_function();
+                        } catch(...) {
+                            task->_exception = std::current_exception();
+                        }
+                        task->_done.store(true, std::memory_order_release);
+                    }
+                };
+
+                //COMMENT: lazy splitting, a worker only splits again once its previous half has been stolen
+                template<typename Body>
+                void parallelForRange(long long begin, long long end, const Body& body, long long grain) {
+                    if(end - begin > grain && localEmpty()) {
+                        long long middle = begin + (end - begin) / 2;
+                        parallelInvoke([&]() { parallelForRange(begin, middle, body, grain); },
+                                       [&]() { parallelForRange(middle, end, body, grain); });
+                        return;
+                    }
+
+                    for(long long i = begin; i < end; i++) {
+                        body(i);
+                    }
+                }
+
+                struct WorkerContext {
+                    ThreadPool* _M_pool;
+                    cc_size_t _index;
+                };
+
+                static WorkerContext*& currentContext() {
+                    static thread_local WorkerContext* context = CC_NULL;
+                    return context;
+                }
+
+                ChaseLevDeque* currentWorker() {
+                    WorkerContext* context = currentContext();
+                    return CC_NULL != context && this == context->_M_pool ? _M_deques[context->_index] : CC_NULL;
+                }
+
+                bool localEmpty() {
+                    ChaseLevDeque* local = currentWorker();
+                    return CC_NULL == local || local->empty();
+                }
+
+                void schedule(Task* task) {
+                    ChaseLevDeque* local = currentWorker();
+                    if(CC_NULL != local) {
+                        local->push(task);
+                    } else {
+                        std::lock_guard<std::mutex> guard(_M_injectMutex);
+                        _M_inject.push_back(task);
+                    }
+                    wakeOne();
+                }
+
+                void join(Task* task) {
+                    ChaseLevDeque* local = currentWorker();
+                    cclib::adt::Backoff backoff(64);
+                    while(!task->_done.load(std::memory_order_acquire)) {
+                        Task* other = CC_NULL != local ? local->take() : CC_NULL;
+                        if(CC_NULL == other) {
+                            other = findTask(local);
+                        }
+
+                        if(CC_NULL != other) {
+                            other->execute();   //NOTICE: usually the forked task itself, not stolen yet
+                            backoff.reset();
+                        } else {
+                            backoff.pause();
+                        }
+                    }
+                }
+
+                Task* findTask(ChaseLevDeque* local) {
+                    Task* task = CC_NULL;
+                    if(CC_NULL != local) {
+                        task = local->take();
+                        if(CC_NULL != task) return task;
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> guard(_M_injectMutex);
+                        if(!_M_inject.empty()) {
+                            task = _M_inject.front();
+                            _M_inject.pop_front();
+                            return task;
+                        }
+                    }
+
+                    cc_size_t count = _M_deques.size();
+                    cc_size_t start = cclib::adt::threadRandom() % count;
+                    for(cc_size_t i = 0; i < count; i++) {
+                        ChaseLevDeque* victim = _M_deques[(start + i) % count];
+                        if(victim == local) continue;
+
+                        task = victim->steal();
+                        if(CC_NULL != task) return task;
+                    }
+                    return CC_NULL;
+                }
+
+                void wakeOne() {
+                    _M_signal.fetch_add(1);
+                    if(0 != _M_sleepers.load()) {
+                        std::lock_guard<std::mutex> guard(_M_sleepMutex);
+                        _M_sleepCondition.notify_one();
+                    }
+                }
+
+                void workerLoop(cc_size_t index) {
+                    WorkerContext context = {this, index};
+                    currentContext() = &context;
+                    ChaseLevDeque* local = _M_deques[index];
+
+                    while(!_stop.load()) {
+                        unsigned long long signal = _M_signal.load();
+                        Task* task = findTask(local);
+                        for(int spin = 0; CC_NULL == task && spin < IDLE_SPIN; spin++) {
+                            cclib::adt::cpuRelax();
+                            task = findTask(local);
+                        }
+
+                        if(CC_NULL != task) {
+                            task->execute();
+                            continue;
+                        }
+
+                        //COMMENT: nothing found since signal was read, sleep until somebody schedules again
+                        std::unique_lock<std::mutex> lock(_M_sleepMutex);
+                        _M_sleepers.fetch_add(1);
+                        while(signal == _M_signal.load() && !_stop.load()) {
+                            _M_sleepCondition.wait(lock);
+                        }
+                        _M_sleepers.fetch_sub(1);
+                    }
+                    currentContext() = CC_NULL;
+                }
+
+            private:
+                static const int IDLE_SPIN = 64;
+
+                std::atomic<bool> _stop;
+                std::vector<ChaseLevDeque*> _M_deques;
+                std::vector<std::thread> _M_threads;
+
+                std::mutex _M_injectMutex;
+                cclib::adt::Deque<Task*> _M_inject;
+
+                std::mutex _M_sleepMutex;
+                std::condition_variable _M_sleepCondition;
+                std::atomic<unsigned long long> _M_signal;
+                std::atomic<int> _M_sleepers;
+        };
+
+        template<typename R>
+        R TaskFuture<R>::get() {
+            cclib::adt::Backoff backoff(64);
+            while(!ready()) {
+                if(_M_pool->runPending()) {
+                    backoff.reset();
+                } else {
+                    backoff.pause();
+                }
+            }
+
+            if(_M_state->_exception) std::rethrow_exception(_M_state->_exception);
+            return _M_state->_result.get();
+        }
+
+        template<typename Left, typename Right>
+        void parallelInvoke(const Left& left, const Right& right) {
+            ThreadPool::instance().parallelInvoke(left, right);
+        }
+
+        template<typename Body>
+        void parallelFor(long long begin, long long end, const Body& body, long long grain = 0) {
+            ThreadPool::instance().parallelFor(begin, end, body, grain);
+        }
+    } // namespace algorithm
+} // namespace cclib
+
+#endif //CCLIB_ALGORITHM_THREAD_POOL_H
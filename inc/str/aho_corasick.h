@@ -0,0 +1,195 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Aho-Corasick multi-pattern matcher
+ * addPattern() all patterns, build() once, then scan() any number of texts in one pass each;
+ * build() turns the trie plus failure links into a full automaton: one table lookup per text byte, no backtracking;
+ * bytes are mapped to classes first, bytes that occur in no pattern share class 0,
+ * so a row of the table has (distinct pattern bytes + 1) entries instead of 256;
+ * every state keeps the pattern ending there and a link to the next state on its suffix chain that ends a pattern.
+************************/
+#ifndef CCLIB_STR_AHO_CORASICK_H
+#define CCLIB_STR_AHO_CORASICK_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "string_view.h"
+#include <stdint.h>
+#include <vector>
+
+namespace cclib {
+    namespace str {
+        class AhoCorasick {
+            public:
+                static const uint32_t NONE = (uint32_t)-1;
+
+            public:
+                AhoCorasick(): _classCount(1), _built(false) {
+                    memset(_byteClass, 0, sizeof(_byteClass));
+                    _M_states.push_back(State());
+                }
+
+            public:
+                //NOTICE: returns the pattern id reported by scan(), patterns added after build() need another build();
+                //a duplicate pattern is reported with the id of its first copy, an empty pattern never matches
+                cc_size_t addPattern(const StringView& pattern) {
+                    if(pattern.empty()) {
+                        _M_patternSizes.push_back(0);
+                        return _M_patternSizes.size() - 1;
+                    }
+
+                    uint32_t state = 0;
+                    for(cc_size_t i = 0; i < pattern.size(); i++) {
+                        unsigned char byte = (unsigned char)pattern[i];
+                        uint32_t next = child(state, byte);
+                        if(NONE == next) {
+                            next = (uint32_t)_M_states.size();
+                            _M_states.push_back(State());
+                            _M_states[state]._children.push_back(Edge(byte, next));
+                        }
+                        state = next;
+                    }
+
+                    cc_size_t id = _M_patternSizes.size();
+                    _M_patternSizes.push_back(pattern.size());
+                    if(NONE == _M_states[state]._output) {
+                        _M_states[state]._output = (uint32_t)id;
+                    }
+                    _built = false;
+                    return id;
+                }
+
+                void build() {
+                    buildByteClass();
+                    _M_table.assign(_M_states.size() * _classCount, 0);
+
+                    //COMMENT: breadth first, a state's failure target is always finished before the state itself
+                    std::vector<uint32_t> queue;
+                    queue.reserve(_M_states.size());
+                    for(cc_size_t i = 0; i < _M_states[0]._children.size(); i++) {
+                        const Edge& edge = _M_states[0]._children[i];
+                        _M_table[_byteClass[edge._byte]] = edge._state;
+                        _M_states[edge._state]._fail = 0;
+                        queue.push_back(edge._state);
+                    }
+
+                    for(cc_size_t head = 0; head < queue.size(); head++) {
+                        uint32_t state = queue[head];
+                        uint32_t fail = _M_states[state]._fail;
+                        _M_states[state]._outputLink = NONE != _M_states[fail]._output ? fail : _M_states[fail]._outputLink;
+
+                        uint32_t* row = &_M_table[state * _classCount];
+                        const uint32_t* failRow = &_M_table[fail * _classCount];
+                        for(cc_size_t c = 0; c < _classCount; c++) {
+                            row[c] = failRow[c];
+                        }
+                        for(cc_size_t i = 0; i < _M_states[state]._children.size(); i++) {
+                            const Edge& edge = _M_states[state]._children[i];
+                            _M_states[edge._state]._fail = failRow[_byteClass[edge._byte]];
+                            row[_byteClass[edge._byte]] = edge._state;
+                            queue.push_back(edge._state);
+                        }
+                    }
+                    _built = true;
+                }
+
+                //NOTICE: callback(patternId, position) for every match, position is the first byte of the match in text;
+                //no match at all until build() has run after the last addPattern()
+                template<typename Callback>
+                void scan(const StringView& text, Callback callback) const {
+                    if(!_built) return;
+
+                    uint32_t state = 0;
+                    for(cc_size_t i = 0; i < text.size(); i++) {
+                        state = _M_table[state * _classCount + _byteClass[(unsigned char)text[i]]];
+
+                        uint32_t output = NONE != _M_states[state]._output ? state : _M_states[state]._outputLink;
+                        while(NONE != output) {
+                            uint32_t id = _M_states[output]._output;
+                            callback((cc_size_t)id, i + 1 - _M_patternSizes[id]);
+                            output = _M_states[output]._outputLink;
+                        }
+                    }
+                }
+
+                bool containsAny(const StringView& text) const {
+                    if(!_built) return false;
+
+                    uint32_t state = 0;
+                    for(cc_size_t i = 0; i < text.size(); i++) {
+                        state = _M_table[state * _classCount + _byteClass[(unsigned char)text[i]]];
+                        if(NONE != _M_states[state]._output || NONE != _M_states[state]._outputLink) return true;
+                    }
+                    return false;
+                }
+
+                cc_size_t patternCount() const {
+                    return _M_patternSizes.size();
+                }
+
+                cc_size_t stateCount() const {
+                    return _M_states.size();
+                }
+
+                bool built() const {
+                    return _built;
+                }
+
+            private:
+                struct Edge {
+                    unsigned char _byte;
+                    uint32_t _state;
+
+                    Edge(unsigned char byte, uint32_t state): _byte(byte), _state(state) {}
+                };
+
+                struct State {
+                    std::vector<Edge> _children;
+                    uint32_t _fail;
+                    uint32_t _output;
+                    uint32_t _outputLink;
+
+                    State(): _fail(0), _output(NONE), _outputLink(NONE) {}
+                };
+
+                uint32_t child(uint32_t state, unsigned char byte) const {
+                    const std::vector<Edge>& children = _M_states[state]._children;
+                    for(cc_size_t i = 0; i < children.size(); i++) {
+                        if(byte == children[i]._byte) return children[i]._state;
+                    }
+                    return NONE;
+                }
+
+                void buildByteClass() {
+                    memset(_byteClass, 0, sizeof(_byteClass));
+                    _classCount = 1;
+                    for(cc_size_t s = 0; s < _M_states.size(); s++) {
+                        for(cc_size_t i = 0; i < _M_states[s]._children.size(); i++) {
+                            unsigned char byte = _M_states[s]._children[i]._byte;
+                            if(0 == _byteClass[byte]) {
+                                _byteClass[byte] = (uint16_t)_classCount++;
+                            }
+                        }
+                    }
+                }
+
+            private:
+                uint16_t _byteClass[256];
+                cc_size_t _classCount;
+                bool _built;
+                std::vector<State> _M_states;
+                std::vector<cc_size_t> _M_patternSizes;
+                std::vector<uint32_t> _M_table;
+        };
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_AHO_CORASICK_H
@@ -0,0 +1,361 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: number formatting without allocation
+ * toChars(first, last, value) writes into [first, last) and returns one past the last byte written,
+ * or CC_NULL when the text does not fit (nothing useful is left in the buffer then), no '\0' is added;
+ * integers are written two digits at a time from a table of the 100 digit pairs;
+ * floating point uses Grisu2: the result always reads back to the same value (strtod / strtof),
+ * and is the shortest such text for all but a tiny fraction of inputs, where it is one digit longer;
+ * the layout follows JavaScript: 100, 0.001, 1.5e+300, nan, inf.
+************************/
+#ifndef CCLIB_STR_FORMAT_H
+#define CCLIB_STR_FORMAT_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include <stdint.h>
+#include <string.h>
+
+namespace cclib {
+    namespace str {
+        //NOTICE: buffer sizes that always fit, sign included
+        static const cc_size_t INTEGER_CHARS_MAX = 20;
+        static const cc_size_t FLOAT_CHARS_MAX = 25;
+
+        namespace detail {
+            inline const char* digitPairs() {
+                static const char PAIRS[201] =
+                    "0001020304050607080910111213141516171819"
+                    "2021222324252627282930313233343536373839"
+                    "4041424344454647484950515253545556575859"
+                    "6061626364656667686970717273747576777879"
+                    "8081828384858687888990919293949596979899";
+                return PAIRS;
+            }
+
+            inline cc_size_t countDigits(uint64_t value) {
+                cc_size_t count = 1;
+                for(;;) {
+                    if(value < 10) return count;
+                    if(value < 100) return count + 1;
+                    if(value < 1000) return count + 2;
+                    if(value < 10000) return count + 3;
+                    value /= 10000;
+                    count += 4;
+                }
+            }
+
+            //NOTICE: writes backwards, end is one past the last digit
+            inline void writeDigits(char* end, uint64_t value) {
+                const char* pairs = digitPairs();
+                while(value >= 100) {
+                    cc_size_t index = (cc_size_t)(value % 100) * 2;
+                    value /= 100;
+                    *--end = pairs[index + 1];
+                    *--end = pairs[index];
+                }
+                if(value >= 10) {
+                    *--end = pairs[value * 2 + 1];
+                    *--end = pairs[value * 2];
+                } else {
+                    *--end = (char)('0' + value);
+                }
+            }
+
+            inline char* writeUnsigned(char* first, char* last, uint64_t value, bool negative) {
+                cc_size_t length = countDigits(value) + (negative ? 1 : 0);
+                if(last - first < (ptrdiff_t)length) return CC_NULL;
+
+                if(negative) *first = '-';
+                writeDigits(first + length, value);
+                return first + length;
+            }
+
+            //COMMENT: a 64 bit significand and a binary exponent, value = _f * 2^_e
+            struct DiyFp {
+                uint64_t _f;
+                int _e;
+
+                DiyFp(uint64_t f, int e): _f(f), _e(e) {}
+
+                DiyFp operator-(const DiyFp& other) const {
+                    return DiyFp(_f - other._f, _e);
+                }
+
+                //NOTICE: the high 64 bits of the 128 bit product, rounded
+                DiyFp operator*(const DiyFp& other) const {
+                    const uint64_t M32 = 0xFFFFFFFFULL;
+                    uint64_t a = _f >> 32, b = _f & M32, c = other._f >> 32, d = other._f & M32;
+                    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+                    uint64_t middle = (bd >> 32) + (ad & M32) + (bc & M32) + (1ULL << 31);
+                    return DiyFp(ac + (ad >> 32) + (bc >> 32) + (middle >> 32), _e + other._e + 64);
+                }
+
+                DiyFp normalize() const {
+                    int shift = __builtin_clzll(_f);
+                    return DiyFp(_f << shift, _e - shift);
+                }
+            };
+
+            //COMMENT: 10^k for k = -348, -340, ..., 340, normalized to 64 bit significands
+            inline DiyFp cachedPower(int exponent, int& decimalExponent) {
+                static const uint64_t SIGNIFICANDS[] = {
+                        0xFA8FD5A0081C0288ULL, 0xBAAEE17FA23EBF76ULL, 0x8B16FB203055AC76ULL, 0xCF42894A5DCE35EAULL,
+                        0x9A6BB0AA55653B2DULL, 0xE61ACF033D1A45DFULL, 0xAB70FE17C79AC6CAULL, 0xFF77B1FCBEBCDC4FULL,
+                        0xBE5691EF416BD60CULL, 0x8DD01FAD907FFC3CULL, 0xD3515C2831559A83ULL, 0x9D71AC8FADA6C9B5ULL,
+                        0xEA9C227723EE8BCBULL, 0xAECC49914078536DULL, 0x823C12795DB6CE57ULL, 0xC21094364DFB5637ULL,
+                        0x9096EA6F3848984FULL, 0xD77485CB25823AC7ULL, 0xA086CFCD97BF97F4ULL, 0xEF340A98172AACE5ULL,
+                        0xB23867FB2A35B28EULL, 0x84C8D4DFD2C63F3BULL, 0xC5DD44271AD3CDBAULL, 0x936B9FCEBB25C996ULL,
+                        0xDBAC6C247D62A584ULL, 0xA3AB66580D5FDAF6ULL, 0xF3E2F893DEC3F126ULL, 0xB5B5ADA8AAFF80B8ULL,
+                        0x87625F056C7C4A8BULL, 0xC9BCFF6034C13053ULL, 0x964E858C91BA2655ULL, 0xDFF9772470297EBDULL,
+                        0xA6DFBD9FB8E5B88FULL, 0xF8A95FCF88747D94ULL, 0xB94470938FA89BCFULL, 0x8A08F0F8BF0F156BULL,
+                        0xCDB02555653131B6ULL, 0x993FE2C6D07B7FACULL, 0xE45C10C42A2B3B06ULL, 0xAA242499697392D3ULL,
+                        0xFD87B5F28300CA0EULL, 0xBCE5086492111AEBULL, 0x8CBCCC096F5088CCULL, 0xD1B71758E219652CULL,
+                        0x9C40000000000000ULL, 0xE8D4A51000000000ULL, 0xAD78EBC5AC620000ULL, 0x813F3978F8940984ULL,
+                        0xC097CE7BC90715B3ULL, 0x8F7E32CE7BEA5C70ULL, 0xD5D238A4ABE98068ULL, 0x9F4F2726179A2245ULL,
+                        0xED63A231D4C4FB27ULL, 0xB0DE65388CC8ADA8ULL, 0x83C7088E1AAB65DBULL, 0xC45D1DF942711D9AULL,
+                        0x924D692CA61BE758ULL, 0xDA01EE641A708DEAULL, 0xA26DA3999AEF774AULL, 0xF209787BB47D6B85ULL,
+                        0xB454E4A179DD1877ULL, 0x865B86925B9BC5C2ULL, 0xC83553C5C8965D3DULL, 0x952AB45CFA97A0B3ULL,
+                        0xDE469FBD99A05FE3ULL, 0xA59BC234DB398C25ULL, 0xF6C69A72A3989F5CULL, 0xB7DCBF5354E9BECEULL,
+                        0x88FCF317F22241E2ULL, 0xCC20CE9BD35C78A5ULL, 0x98165AF37B2153DFULL, 0xE2A0B5DC971F303AULL,
+                        0xA8D9D1535CE3B396ULL, 0xFB9B7CD9A4A7443CULL, 0xBB764C4CA7A44410ULL, 0x8BAB8EEFB6409C1AULL,
+                        0xD01FEF10A657842CULL, 0x9B10A4E5E9913129ULL, 0xE7109BFBA19C0C9DULL, 0xAC2820D9623BF429ULL,
+                        0x80444B5E7AA7CF85ULL, 0xBF21E44003ACDD2DULL, 0x8E679C2F5E44FF8FULL, 0xD433179D9C8CB841ULL,
+                        0x9E19DB92B4E31BA9ULL, 0xEB96BF6EBADF77D9ULL, 0xAF87023B9BF0EE6BULL
+                };
+                static const short EXPONENTS[] = {
+                        -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927, -901, -874, -847, -821,
+                        -794, -768, -741, -715, -688, -661, -635, -608, -582, -555, -529, -502, -475, -449, -422, -396,
+                        -369, -343, -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+                        56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348, 375, 402, 428, 455,
+                        481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+                        907, 933, 960, 986, 1013, 1039, 1066
+                };
+
+                double estimate = (-61 - exponent) * 0.30102999566398114 + 347;
+                int k = (int)estimate;
+                if(estimate - k > 0.0) ++k;
+
+                cc_size_t index = (cc_size_t)((k >> 3) + 1);
+                decimalExponent = -(-348 + (int)(index << 3));
+                return DiyFp(SIGNIFICANDS[index], EXPONENTS[index]);
+            }
+
+            inline const uint64_t* powersOfTen() {
+                static const uint64_t POWERS[] = {
+                    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+                    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+                    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+                    1000000000000000000ULL, 10000000000000000000ULL
+                };
+                return POWERS;
+            }
+
+            //COMMENT: move the last digit down while the text stays inside the interval and gets closer to the value
+            inline void grisuRound(char* digits, int length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t distance) {
+                while(rest < distance && delta - rest >= tenKappa &&
+                      (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance)) {
+                    --digits[length - 1];
+                    rest += tenKappa;
+                }
+            }
+
+            //NOTICE: high is the upper boundary scaled into [2^-60, 2^-32), emits digits until the text is inside (low, high)
+            inline void digitGen(const DiyFp& value, const DiyFp& high, uint64_t delta, char* digits, int& length, int& decimalExponent) {
+                const uint64_t* powers = powersOfTen();
+                const DiyFp one(1ULL << -high._e, high._e);
+                const DiyFp distance = high - value;
+                uint32_t integral = (uint32_t)(high._f >> -one._e);
+                uint64_t fraction = high._f & (one._f - 1);
+                int kappa = (int)countDigits(integral);
+                length = 0;
+
+                while(kappa > 0) {
+                    uint32_t digit = (uint32_t)(integral / powers[kappa - 1]);
+                    integral %= (uint32_t)powers[kappa - 1];
+                    if(0 != digit || 0 != length) digits[length++] = (char)('0' + digit);
+                    --kappa;
+
+                    uint64_t rest = ((uint64_t)integral << -one._e) + fraction;
+                    if(rest <= delta) {
+                        decimalExponent += kappa;
+                        grisuRound(digits, length, delta, rest, powers[kappa] << -one._e, distance._f);
+                        return;
+                    }
+                }
+
+                for(;;) {
+                    fraction *= 10;
+                    delta *= 10;
+                    char digit = (char)(fraction >> -one._e);
+                    if(0 != digit || 0 != length) digits[length++] = (char)('0' + digit);
+                    fraction &= one._f - 1;
+                    --kappa;
+                    if(fraction < delta) {
+                        decimalExponent += kappa;
+                        int index = -kappa;
+                        grisuRound(digits, length, delta, fraction, one._f, distance._f * (index < 20 ? powers[index] : 0));
+                        return;
+                    }
+                }
+            }
+
+            //NOTICE: significand and exponent of a positive finite value, hidden is the implicit leading bit of the format
+            inline void grisu2(uint64_t significand, int exponent, bool lowerCloser, char* digits, int& length, int& decimalExponent) {
+                DiyFp value(significand, exponent);
+                DiyFp high = DiyFp((significand << 1) + 1, exponent - 1).normalize();
+                DiyFp low = lowerCloser ? DiyFp((significand << 2) - 1, exponent - 2) : DiyFp((significand << 1) - 1, exponent - 1);
+                low._f <<= low._e - high._e;
+                low._e = high._e;
+
+                const DiyFp power = cachedPower(high._e, decimalExponent);
+                DiyFp scaled = value.normalize() * power;
+                DiyFp scaledHigh = high * power;
+                DiyFp scaledLow = low * power;
+                ++scaledLow._f;
+                --scaledHigh._f;
+                digitGen(scaled, scaledHigh, scaledHigh._f - scaledLow._f, digits, length, decimalExponent);
+            }
+
+            //COMMENT: value = digits * 10^decimalExponent, pick plain or exponent layout like JavaScript does
+            inline char* layoutDigits(char* first, char* last, bool negative, const char* digits, int length, int decimalExponent) {
+                char buffer[FLOAT_CHARS_MAX + 1];
+                char* out = buffer;
+                if(negative) *out++ = '-';
+
+                int point = length + decimalExponent;
+                if(decimalExponent >= 0 && point <= 21) {
+                    memcpy(out, digits, length);
+                    out += length;
+                    memset(out, '0', decimalExponent);
+                    out += decimalExponent;
+                } else if(point > 0 && point <= 21) {
+                    memcpy(out, digits, point);
+                    out += point;
+                    *out++ = '.';
+                    memcpy(out, digits + point, length - point);
+                    out += length - point;
+                } else if(point > -6 && point <= 0) {
+                    *out++ = '0';
+                    *out++ = '.';
+                    memset(out, '0', -point);
+                    out += -point;
+                    memcpy(out, digits, length);
+                    out += length;
+                } else {
+                    *out++ = digits[0];
+                    if(length > 1) {
+                        *out++ = '.';
+                        memcpy(out, digits + 1, length - 1);
+                        out += length - 1;
+                    }
+                    int exponent = point - 1;
+                    *out++ = 'e';
+                    *out++ = exponent < 0 ? '-' : '+';
+                    exponent = exponent < 0 ? -exponent : exponent;
+                    cc_size_t count = countDigits((uint64_t)exponent);
+                    writeDigits(out + count, (uint64_t)exponent);
+                    out += count;
+                }
+
+                if(last - first < out - buffer) return CC_NULL;
+                memcpy(first, buffer, out - buffer);
+                return first + (out - buffer);
+            }
+
+            inline char* writeSpecial(char* first, char* last, const char* text) {
+                cc_size_t length = strlen(text);
+                if(last - first < (ptrdiff_t)length) return CC_NULL;
+                memcpy(first, text, length);
+                return first + length;
+            }
+
+            //NOTICE: shared by float and double, bits is the raw encoding widened to 64 bits
+            inline char* writeFloat(char* first, char* last, uint64_t bits, int significandBits, int exponentBits) {
+                const uint64_t fractionMask = (1ULL << significandBits) - 1;
+                const uint64_t exponentMask = (1ULL << exponentBits) - 1;
+                const int bias = (int)(exponentMask >> 1) + significandBits;
+                bool negative = 0 != (bits >> (significandBits + exponentBits));
+                uint64_t fraction = bits & fractionMask;
+                uint64_t biased = (bits >> significandBits) & exponentMask;
+
+                if(exponentMask == biased) {
+                    return writeSpecial(first, last, 0 != fraction ? "nan" : (negative ? "-inf" : "inf"));
+                }
+                if(0 == biased && 0 == fraction) {
+                    return writeSpecial(first, last, negative ? "-0" : "0");
+                }
+
+                uint64_t significand = 0 == biased ? fraction : fraction | (1ULL << significandBits);
+                int exponent = 0 == biased ? 1 - bias : (int)biased - bias;
+                bool lowerCloser = 0 == fraction && biased > 1;
+
+                char digits[24];
+                int length = 0, decimalExponent = 0;
+                grisu2(significand, exponent, lowerCloser, digits, length, decimalExponent);
+                return layoutDigits(first, last, negative, digits, length, decimalExponent);
+            }
+        }   //namespace detail
+
+        inline char* toChars(char* first, char* last, unsigned long long value) {
+            return detail::writeUnsigned(first, last, value, false);
+        }
+
+        inline char* toChars(char* first, char* last, long long value) {
+            //NOTICE: negate in unsigned, LLONG_MIN has no positive counterpart
+            return value < 0 ? detail::writeUnsigned(first, last, 0 - (unsigned long long)value, true)
+                             : detail::writeUnsigned(first, last, (unsigned long long)value, false);
+        }
+
+        inline char* toChars(char* first, char* last, unsigned long value) {
+            return toChars(first, last, (unsigned long long)value);
+        }
+
+        inline char* toChars(char* first, char* last, long value) {
+            return toChars(first, last, (long long)value);
+        }
+
+        inline char* toChars(char* first, char* last, unsigned int value) {
+            return toChars(first, last, (unsigned long long)value);
+        }
+
+        inline char* toChars(char* first, char* last, int value) {
+            return toChars(first, last, (long long)value);
+        }
+
+        inline char* toChars(char* first, char* last, unsigned short value) {
+            return toChars(first, last, (unsigned long long)value);
+        }
+
+        inline char* toChars(char* first, char* last, short value) {
+            return toChars(first, last, (long long)value);
+        }
+
+        inline char* toChars(char* first, char* last, bool value) {
+            return detail::writeSpecial(first, last, value ? "true" : "false");
+        }
+
+        inline char* toChars(char* first, char* last, double value) {
+            uint64_t bits = 0;
+            memcpy(&bits, &value, sizeof(bits));
+            return detail::writeFloat(first, last, bits, 52, 11);
+        }
+
+        inline char* toChars(char* first, char* last, float value) {
+            uint32_t bits = 0;
+            memcpy(&bits, &value, sizeof(bits));
+            return detail::writeFloat(first, last, bits, 23, 8);
+        }
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_FORMAT_H
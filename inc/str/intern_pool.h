@@ -0,0 +1,272 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: string interning pool
+ * intern() maps equal bytes to the same Symbol, a 32 bit handle, so keys compare and hash as integers;
+ * the bytes are copied once into an arena and never move or die before the pool, view() is always valid;
+ * the pool is split into SHARD_COUNT shards by hash, each with its own lock, table and arena,
+ * so threads interning different strings rarely wait for each other;
+ * the handle -> entry directory is a list of blocks doubling in size, a block never moves once published.
+************************/
+#ifndef CCLIB_STR_INTERN_POOL_H
+#define CCLIB_STR_INTERN_POOL_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "string_view.h"
+#include "./../algorithm/hash/hash.h"
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace cclib {
+    namespace str {
+        class Symbol {
+            public:
+                static const uint32_t INVALID = (uint32_t)-1;
+
+            public:
+                Symbol(): _id(INVALID) {}
+                explicit Symbol(uint32_t id): _id(id) {}
+
+            public:
+                uint32_t id() const {
+                    return _id;
+                }
+
+                bool valid() const {
+                    return INVALID != _id;
+                }
+
+                //COMMENT: ids are dense, multiply to spread them over the high bits of a hash table index
+                cc_size_t hash() const {
+                    return (cc_size_t)((uint64_t)_id * 0x9E3779B97F4A7C15ULL >> 32);
+                }
+
+                bool operator==(const Symbol& other) const {
+                    return _id == other._id;
+                }
+
+                bool operator!=(const Symbol& other) const {
+                    return _id != other._id;
+                }
+
+                //NOTICE: orders by intern order, not by the bytes
+                bool operator<(const Symbol& other) const {
+                    return _id < other._id;
+                }
+
+            private:
+                uint32_t _id;
+        };
+
+        class InternPool {
+            public:
+                static const cc_size_t SHARD_COUNT = 16;
+
+            public:
+                InternPool(): _M_next(0) {
+                    for(cc_size_t i = 0; i < BLOCK_COUNT; i++) {
+                        _M_blocks[i].store(CC_NULL, std::memory_order_relaxed);
+                    }
+                }
+
+                ~InternPool() {
+                    for(cc_size_t i = 0; i < BLOCK_COUNT; i++) {
+                        delete[] _M_blocks[i].load(std::memory_order_relaxed);
+                    }
+                }
+
+            private:
+                InternPool(const InternPool& instance);
+                InternPool& operator=(const InternPool& instance);
+
+            public:
+                static InternPool& instance() {
+                    static InternPool pool;
+                    return pool;
+                }
+
+                //NOTICE: returns the existing symbol for equal bytes, otherwise copies the bytes and makes a new one
+                Symbol intern(const char* str, cc_size_t length) {
+                    uint64_t hash = hashBytes(str, length);
+                    Shard& shard = _M_shards[hash & (SHARD_COUNT - 1)];
+                    std::lock_guard<std::mutex> lock(shard._M_mutex);
+
+                    cc_size_t slot = 0;
+                    uint32_t id = shard.lookup(*this, str, length, (uint32_t)(hash >> 32), slot);
+                    if(Symbol::INVALID != id) return Symbol(id);
+
+                    id = _M_next.fetch_add(1, std::memory_order_relaxed);
+                    Entry* entry = entryAt(id, true);
+                    entry->_M_data = shard.copy(str, length);
+                    entry->_size = length;
+                    entry->_hash = (uint32_t)(hash >> 32);
+                    shard.insert(*this, slot, id);
+                    return Symbol(id);
+                }
+
+                Symbol intern(const StringView& str) {
+                    return intern(str.data(), str.size());
+                }
+
+                //NOTICE: lookup only, an invalid Symbol when the bytes were never interned
+                Symbol find(const char* str, cc_size_t length) const {
+                    uint64_t hash = hashBytes(str, length);
+                    Shard& shard = _M_shards[hash & (SHARD_COUNT - 1)];
+                    std::lock_guard<std::mutex> lock(shard._M_mutex);
+
+                    cc_size_t slot = 0;
+                    return Symbol(shard.lookup(*this, str, length, (uint32_t)(hash >> 32), slot));
+                }
+
+                Symbol find(const StringView& str) const {
+                    return find(str.data(), str.size());
+                }
+
+                //NOTICE: the bytes are '\0' terminated and stay valid as long as the pool
+                StringView view(Symbol symbol) const {
+                    const Entry* entry = entryAt(symbol.id(), false);
+                    return StringView(entry->_M_data, entry->_size);
+                }
+
+                const char* c_str(Symbol symbol) const {
+                    return entryAt(symbol.id(), false)->_M_data;
+                }
+
+                cc_size_t size() const {
+                    return _M_next.load(std::memory_order_acquire);
+                }
+
+            private:
+                struct Entry {
+                    const char* _M_data;
+                    cc_size_t _size;
+                    uint32_t _hash;
+                };
+
+                //COMMENT: open addressing of ids, the stored hash bits skip most memcmp calls
+                struct Shard {
+                    static const cc_size_t ARENA_CHUNK = 64 * 1024;
+
+                    std::mutex _M_mutex;
+                    std::vector<uint32_t> _M_slots;
+                    cc_size_t _count;
+                    std::vector<char*> _M_chunks;
+                    char* _M_cursor;
+                    cc_size_t _remain;
+
+                    Shard(): _count(0), _M_cursor(CC_NULL), _remain(0) {}
+
+                    ~Shard() {
+                        for(cc_size_t i = 0; i < _M_chunks.size(); i++) {
+                            delete[] _M_chunks[i];
+                        }
+                    }
+
+                    //NOTICE: returns the id or INVALID, slot is where a new id would go
+                    uint32_t lookup(const InternPool& pool, const char* str, cc_size_t length, uint32_t hash, cc_size_t& slot) const {
+                        if(_M_slots.empty()) return Symbol::INVALID;
+
+                        cc_size_t mask = _M_slots.size() - 1;
+                        for(slot = hash & mask; Symbol::INVALID != _M_slots[slot]; slot = (slot + 1) & mask) {
+                            const Entry* entry = pool.entryAt(_M_slots[slot], false);
+                            if(entry->_hash == hash && entry->_size == length && 0 == memcmp(entry->_M_data, str, length)) {
+                                return _M_slots[slot];
+                            }
+                        }
+                        return Symbol::INVALID;
+                    }
+
+                    void insert(const InternPool& pool, cc_size_t slot, uint32_t id) {
+                        //COMMENT: keep the load factor under 1/2, rehash from the stored hashes
+                        if(2 * (_count + 1) > _M_slots.size()) {
+                            std::vector<uint32_t> old;
+                            old.swap(_M_slots);
+                            uint32_t invalid = Symbol::INVALID;
+                            _M_slots.assign(old.empty() ? 64 : 2 * old.size(), invalid);
+                            cc_size_t mask = _M_slots.size() - 1;
+                            for(cc_size_t i = 0; i < old.size(); i++) {
+                                if(Symbol::INVALID == old[i]) continue;
+                                cc_size_t position = pool.entryAt(old[i], false)->_hash & mask;
+                                while(Symbol::INVALID != _M_slots[position]) position = (position + 1) & mask;
+                                _M_slots[position] = old[i];
+                            }
+                            slot = pool.entryAt(id, false)->_hash & mask;
+                            while(Symbol::INVALID != _M_slots[slot]) slot = (slot + 1) & mask;
+                        }
+                        _M_slots[slot] = id;
+                        ++_count;
+                    }
+
+                    const char* copy(const char* str, cc_size_t length) {
+                        if(length + 1 > _remain) {
+                            //NOTICE: a big string gets a chunk of its own, the current chunk keeps its free tail
+                            if(length + 1 > ARENA_CHUNK / 4) {
+                                char* chunk = new char[length + 1];
+                                _M_chunks.push_back(chunk);
+                                memcpy(chunk, str, length);
+                                chunk[length] = '\0';
+                                return chunk;
+                            }
+                            _M_cursor = new char[ARENA_CHUNK];
+                            _M_chunks.push_back(_M_cursor);
+                            _remain = ARENA_CHUNK;
+                        }
+
+                        char* result = _M_cursor;
+                        memcpy(result, str, length);
+                        result[length] = '\0';
+                        _M_cursor += length + 1;
+                        _remain -= length + 1;
+                        return result;
+                    }
+                };
+
+                //COMMENT: block k holds FIRST_BLOCK << k entries, 23 blocks cover every 32 bit id
+                static const cc_size_t FIRST_BLOCK_SHIFT = 10;
+                static const cc_size_t BLOCK_COUNT = 32 - FIRST_BLOCK_SHIFT + 1;
+
+                Entry* entryAt(uint32_t id, bool create) const {
+                    uint64_t position = (uint64_t)id + ((uint64_t)1 << FIRST_BLOCK_SHIFT);
+                    cc_size_t high = 63 - __builtin_clzll(position);
+                    cc_size_t block = high - FIRST_BLOCK_SHIFT;
+                    cc_size_t offset = (cc_size_t)(position - ((uint64_t)1 << high));
+
+                    Entry* entries = _M_blocks[block].load(std::memory_order_acquire);
+                    if(CC_NULL == entries && create) {
+                        //NOTICE: shards race to publish a block, the loser frees its copy
+                        Entry* fresh = new Entry[(cc_size_t)1 << high];
+                        if(_M_blocks[block].compare_exchange_strong(entries, fresh, std::memory_order_acq_rel)) {
+                            entries = fresh;
+                        } else {
+                            delete[] fresh;
+                        }
+                    }
+                    return entries + offset;
+                }
+
+                //COMMENT: the low bits pick the shard, the high 32 bits are the table hash
+                static uint64_t hashBytes(const char* str, cc_size_t length) {
+                    return algorithm::hashBytes(str, length);
+                }
+
+            private:
+                std::atomic<uint32_t> _M_next;
+                mutable std::atomic<Entry*> _M_blocks[BLOCK_COUNT];
+                mutable Shard _M_shards[SHARD_COUNT];
+        };
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_INTERN_POOL_H
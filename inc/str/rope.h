@@ -0,0 +1,475 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Rope
+ * a string stored as an AVL tree of chunks, leaves hold up to LEAF_CAPACITY bytes, inner nodes hold sizes;
+ * every edit is a split and a join, both walk one path: insert, erase, substr, index and concat are O(log n);
+ * nodes are immutable and reference counted, an edit copies one path and shares the rest,
+ * so copying a rope or taking a substring never copies the bytes;
+ * the reference counts are not atomic, a rope and its copies belong to one thread at a time;
+ * forEachChunk() / ChunkIterator hand out the leaves in order, ready for writev() style gather I/O.
+************************/
+#ifndef CCLIB_STR_ROPE_H
+#define CCLIB_STR_ROPE_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "string_view.h"
+#include <stddef.h>
+#include <string.h>
+#include <new>
+#include <vector>
+
+namespace cclib {
+    namespace str {
+        class Rope {
+            public:
+                static const cc_size_t LEAF_CAPACITY = 2048;
+
+            private:
+                struct Node {
+                    cc_size_t _refs;
+                    cc_size_t _size;
+                    int _height;
+                    Node* _left;
+                    Node* _right;
+                    char _M_data[1];
+
+                    bool isLeaf() const {
+                        return CC_NULL == _left;
+                    }
+                };
+
+            public:
+                Rope(): _M_root(CC_NULL) {}
+
+                Rope(const char* str): _M_root(build(str, CC_NULL == str ? 0 : strlen(str))) {}
+
+                Rope(const char* str, cc_size_t length): _M_root(build(str, length)) {}
+
+                Rope(const StringView& str): _M_root(build(str.data(), str.size())) {}
+
+                //NOTICE: O(1), the copy shares every node
+                Rope(const Rope& other): _M_root(ref(other._M_root)) {}
+
+                Rope(Rope&& other): _M_root(other._M_root) {
+                    other._M_root = CC_NULL;
+                }
+
+                ~Rope() {
+                    unref(_M_root);
+                }
+
+                Rope& operator =(const Rope& other) {
+                    Node* root = ref(other._M_root);
+                    unref(_M_root);
+                    _M_root = root;
+                    return *this;
+                }
+
+                Rope& operator =(Rope&& other) {
+                    if(this != &other) {
+                        unref(_M_root);
+                        _M_root = other._M_root;
+                        other._M_root = CC_NULL;
+                    }
+                    return *this;
+                }
+
+            public:
+                cc_size_t size() const {
+                    return sizeOf(_M_root);
+                }
+
+                cc_size_t length() const {
+                    return size();
+                }
+
+                bool empty() const {
+                    return CC_NULL == _M_root;
+                }
+
+                int height() const {
+                    return heightOf(_M_root);
+                }
+
+                void clear() {
+                    unref(_M_root);
+                    _M_root = CC_NULL;
+                }
+
+                void swap(Rope& other) {
+                    Node* temp = _M_root;
+                    _M_root = other._M_root;
+                    other._M_root = temp;
+                }
+
+                //NOTICE: index must be less than size()
+                char operator[](cc_size_t index) const {
+                    const Node* node = _M_root;
+                    while(!node->isLeaf()) {
+                        if(index < node->_left->_size) {
+                            node = node->_left;
+                        } else {
+                            index -= node->_left->_size;
+                            node = node->_right;
+                        }
+                    }
+                    return node->_M_data[index];
+                }
+
+                //NOTICE: position is clamped to size()
+                Rope& insert(cc_size_t position, const Rope& other) {
+                    if(position > size()) position = size();
+
+                    //NOTICE: other may be this rope, take its root before split() gives up ours
+                    Node* inserted = ref(other._M_root);
+                    Node* left = CC_NULL;
+                    Node* right = CC_NULL;
+                    split(_M_root, position, left, right);
+                    _M_root = join(join(left, inserted), right);
+                    return *this;
+                }
+
+                Rope& insert(cc_size_t position, const char* str, cc_size_t length) {
+                    Rope other(str, length);
+                    return insert(position, other);
+                }
+
+                Rope& insert(cc_size_t position, const char* str) {
+                    return insert(position, str, strlen(str));
+                }
+
+                //NOTICE: erases [position, position + length), clamped to size()
+                Rope& erase(cc_size_t position, cc_size_t length) {
+                    cc_size_t total = size();
+                    if(position >= total || 0 == length) return *this;
+                    if(length > total - position) length = total - position;
+
+                    Node* left = CC_NULL;
+                    Node* middle = CC_NULL;
+                    Node* right = CC_NULL;
+                    split(_M_root, position, left, middle);
+                    split(middle, length, middle, right);
+                    unref(middle);
+                    _M_root = join(left, right);
+                    return *this;
+                }
+
+                //NOTICE: shares the nodes of this rope, only the two cut leaves are copied
+                Rope substr(cc_size_t position, cc_size_t length) const {
+                    cc_size_t total = size();
+                    if(position >= total || 0 == length) return Rope();
+                    if(length > total - position) length = total - position;
+
+                    Node* left = CC_NULL;
+                    Node* middle = CC_NULL;
+                    Node* right = CC_NULL;
+                    split(ref(_M_root), position, left, middle);
+                    split(middle, length, middle, right);
+                    unref(left);
+                    unref(right);
+                    return Rope(middle);
+                }
+
+                Rope& append(const Rope& other) {
+                    _M_root = join(_M_root, ref(other._M_root));
+                    return *this;
+                }
+
+                Rope& append(const char* str, cc_size_t length) {
+                    _M_root = join(_M_root, build(str, length));
+                    return *this;
+                }
+
+                Rope& append(const char* str) {
+                    return append(str, strlen(str));
+                }
+
+                Rope& operator +=(const Rope& other) {
+                    return append(other);
+                }
+
+                Rope& operator +=(const char* str) {
+                    return append(str);
+                }
+
+                Rope operator +(const Rope& other) const {
+                    return Rope(join(ref(_M_root), ref(other._M_root)));
+                }
+
+                //NOTICE: callback(const char* data, cc_size_t length) for every leaf, in order
+                template<typename Callback>
+                void forEachChunk(Callback callback) const {
+                    for(ChunkIterator iter(*this); !iter.done(); iter.next()) {
+                        callback(iter.data(), iter.size());
+                    }
+                }
+
+                //NOTICE: copies length bytes starting at position into buffer, returns how many were copied
+                cc_size_t copy(char* buffer, cc_size_t position, cc_size_t length) const {
+                    cc_size_t total = size();
+                    if(position >= total) return 0;
+                    if(length > total - position) length = total - position;
+
+                    cc_size_t copied = 0;
+                    copyRange(_M_root, position, length, buffer, copied);
+                    return copied;
+                }
+
+                String toString() const {
+                    String result;
+                    result.reserve(size());
+                    for(ChunkIterator iter(*this); !iter.done(); iter.next()) {
+                        result.append(iter.data(), iter.size());
+                    }
+                    return result;
+                }
+
+                bool operator==(const Rope& other) const {
+                    if(size() != other.size()) return false;
+
+                    //COMMENT: chunk boundaries differ between equal ropes, walk both with an offset into each chunk
+                    ChunkIterator left(*this), right(other);
+                    cc_size_t leftOffset = 0, rightOffset = 0;
+                    while(!left.done()) {
+                        cc_size_t step = MIN_VALUE(left.size() - leftOffset, right.size() - rightOffset);
+                        if(0 != memcmp(left.data() + leftOffset, right.data() + rightOffset, step)) return false;
+                        leftOffset += step;
+                        rightOffset += step;
+                        if(leftOffset == left.size()) { left.next(); leftOffset = 0; }
+                        if(rightOffset == right.size()) { right.next(); rightOffset = 0; }
+                    }
+                    return true;
+                }
+
+                bool operator!=(const Rope& other) const {
+                    return !operator==(other);
+                }
+
+            public:
+                //COMMENT: in order walk over the leaves with an explicit stack of right subtrees
+                class ChunkIterator {
+                    public:
+                        explicit ChunkIterator(const Rope& rope): _M_leaf(CC_NULL) {
+                            descend(rope._M_root);
+                        }
+
+                    public:
+                        bool done() const {
+                            return CC_NULL == _M_leaf;
+                        }
+
+                        const char* data() const {
+                            return _M_leaf->_M_data;
+                        }
+
+                        cc_size_t size() const {
+                            return _M_leaf->_size;
+                        }
+
+                        StringView view() const {
+                            return StringView(_M_leaf->_M_data, _M_leaf->_size);
+                        }
+
+                        void next() {
+                            _M_leaf = CC_NULL;
+                            if(!_M_stack.empty()) {
+                                const Node* node = _M_stack.back();
+                                _M_stack.pop_back();
+                                descend(node);
+                            }
+                        }
+
+                    private:
+                        void descend(const Node* node) {
+                            if(CC_NULL == node) return;
+                            while(!node->isLeaf()) {
+                                _M_stack.push_back(node->_right);
+                                node = node->_left;
+                            }
+                            _M_leaf = node;
+                        }
+
+                    private:
+                        const Node* _M_leaf;
+                        std::vector<const Node*> _M_stack;
+                };
+
+            private:
+                explicit Rope(Node* root): _M_root(root) {}
+
+                static cc_size_t sizeOf(const Node* node) {
+                    return CC_NULL == node ? 0 : node->_size;
+                }
+
+                static int heightOf(const Node* node) {
+                    return CC_NULL == node ? -1 : node->_height;
+                }
+
+                static Node* ref(Node* node) {
+                    if(CC_NULL != node) ++node->_refs;
+                    return node;
+                }
+
+                static void unref(Node* node) {
+                    if(CC_NULL == node || 0 != --node->_refs) return;
+                    if(!node->isLeaf()) {
+                        unref(node->_left);
+                        unref(node->_right);
+                    }
+                    ::operator delete(node);
+                }
+
+                //NOTICE: a leaf is allocated with its bytes right behind the header
+                static Node* makeLeaf(const char* first, cc_size_t firstLength, const char* second = CC_NULL, cc_size_t secondLength = 0) {
+                    Node* node = static_cast<Node*>(::operator new(offsetof(Node, _M_data) + firstLength + secondLength));
+                    node->_refs = 1;
+                    node->_size = firstLength + secondLength;
+                    node->_height = 0;
+                    node->_left = CC_NULL;
+                    node->_right = CC_NULL;
+                    memcpy(node->_M_data, first, firstLength);
+                    if(0 != secondLength) memcpy(node->_M_data + firstLength, second, secondLength);
+                    return node;
+                }
+
+                //NOTICE: takes over the references of left and right
+                static Node* makeNode(Node* left, Node* right) {
+                    Node* node = static_cast<Node*>(::operator new(offsetof(Node, _M_data)));
+                    node->_refs = 1;
+                    node->_size = left->_size + right->_size;
+                    node->_height = MAX_VALUE(left->_height, right->_height) + 1;
+                    node->_left = left;
+                    node->_right = right;
+                    return node;
+                }
+
+                //COMMENT: whole leaves first, the two halves differ by at most one leaf so the heights stay within one
+                static Node* build(const char* str, cc_size_t length) {
+                    if(0 == length) return CC_NULL;
+                    if(length <= LEAF_CAPACITY) return makeLeaf(str, length);
+
+                    cc_size_t leaves = (length + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+                    cc_size_t half = leaves / 2 * LEAF_CAPACITY;
+                    return makeNode(build(str, half), build(str + half, length - half));
+                }
+
+                //NOTICE: takes over the references, the heights differ by at most two, one rotation fixes it
+                static Node* balance(Node* left, Node* right) {
+                    if(heightOf(left) > heightOf(right) + 1) {
+                        Node* inner = left->_right;
+                        Node* result;
+                        if(heightOf(left->_left) >= heightOf(inner)) {
+                            result = makeNode(ref(left->_left), makeNode(ref(inner), right));
+                        } else {
+                            result = makeNode(makeNode(ref(left->_left), ref(inner->_left)), makeNode(ref(inner->_right), right));
+                        }
+                        unref(left);
+                        return result;
+                    }
+
+                    if(heightOf(right) > heightOf(left) + 1) {
+                        Node* inner = right->_left;
+                        Node* result;
+                        if(heightOf(right->_right) >= heightOf(inner)) {
+                            result = makeNode(makeNode(left, ref(inner)), ref(right->_right));
+                        } else {
+                            result = makeNode(makeNode(left, ref(inner->_left)), makeNode(ref(inner->_right), ref(right->_right)));
+                        }
+                        unref(right);
+                        return result;
+                    }
+
+                    return makeNode(left, right);
+                }
+
+                //NOTICE: takes over the references, walks down the taller tree until the heights meet
+                static Node* join(Node* left, Node* right) {
+                    if(CC_NULL == left) return right;
+                    if(CC_NULL == right) return left;
+
+                    //COMMENT: two small leaves become one, keeps repeated small inserts from fragmenting the rope
+                    if(left->isLeaf() && right->isLeaf() && left->_size + right->_size <= LEAF_CAPACITY) {
+                        Node* result = makeLeaf(left->_M_data, left->_size, right->_M_data, right->_size);
+                        unref(left);
+                        unref(right);
+                        return result;
+                    }
+
+                    if(left->_height > right->_height + 1) {
+                        Node* result = balance(ref(left->_left), join(ref(left->_right), right));
+                        unref(left);
+                        return result;
+                    }
+
+                    if(right->_height > left->_height + 1) {
+                        Node* result = balance(join(left, ref(right->_left)), ref(right->_right));
+                        unref(right);
+                        return result;
+                    }
+
+                    return makeNode(left, right);
+                }
+
+                //NOTICE: takes over the reference of node, left gets [0, position), right gets the rest
+                static void split(Node* node, cc_size_t position, Node*& left, Node*& right) {
+                    if(0 == position) {
+                        left = CC_NULL;
+                        right = node;
+                        return;
+                    }
+                    if(position >= sizeOf(node)) {
+                        left = node;
+                        right = CC_NULL;
+                        return;
+                    }
+
+                    if(node->isLeaf()) {
+                        left = makeLeaf(node->_M_data, position);
+                        right = makeLeaf(node->_M_data + position, node->_size - position);
+                    } else if(position <= node->_left->_size) {
+                        Node* rest = CC_NULL;
+                        split(ref(node->_left), position, left, rest);
+                        right = join(rest, ref(node->_right));
+                    } else {
+                        Node* rest = CC_NULL;
+                        split(ref(node->_right), position - node->_left->_size, rest, right);
+                        left = join(ref(node->_left), rest);
+                    }
+                    unref(node);
+                }
+
+                static void copyRange(const Node* node, cc_size_t position, cc_size_t length, char* buffer, cc_size_t& copied) {
+                    if(0 == length) return;
+                    if(node->isLeaf()) {
+                        memcpy(buffer + copied, node->_M_data + position, length);
+                        copied += length;
+                        return;
+                    }
+
+                    cc_size_t leftSize = node->_left->_size;
+                    if(position < leftSize) {
+                        cc_size_t leftLength = MIN_VALUE(length, leftSize - position);
+                        copyRange(node->_left, position, leftLength, buffer, copied);
+                        copyRange(node->_right, 0, length - leftLength, buffer, copied);
+                    } else {
+                        copyRange(node->_right, position - leftSize, length, buffer, copied);
+                    }
+                }
+
+            private:
+                Node* _M_root;
+        };
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_ROPE_H
@@ -0,0 +1,150 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: substring search over (pointer, length) byte ranges
+ * one byte needles: scanByte;
+ * short needles (up to SHORT_NEEDLE bytes): SIMD first/last byte filter,
+ * a block of candidates is kept only where both the first and the last needle byte match,
+ * only those few candidates are compared in full;
+ * long needles: Boyer-Moore-Horspool, the bad character table lets the window skip up to the needle length;
+ * every function returns the byte offset of the match or SEARCH_NPOS.
+************************/
+#ifndef CCLIB_STR_SEARCH_H
+#define CCLIB_STR_SEARCH_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "simd_scan.h"
+
+namespace cclib {
+    namespace str {
+        static const cc_size_t SEARCH_NPOS = (cc_size_t)-1;
+
+        namespace detail {
+            static const cc_size_t SHORT_NEEDLE = 32;
+
+            inline cc_size_t searchShort(const char* text, cc_size_t textSize, const char* needle, cc_size_t needleSize) {
+                const char* begin = text;
+                const char* last = text + textSize - needleSize; //NOTICE: last valid start of a match
+                char first = needle[0], tail = needle[needleSize - 1];
+
+                #if defined(__AVX2__)
+                __m256i first32 = _mm256_set1_epi8(first);
+                __m256i tail32 = _mm256_set1_epi8(tail);
+                for(; last - begin >= 31; begin += 32) {
+                    __m256i blockFirst = _mm256_loadu_si256((const __m256i*)begin);
+                    __m256i blockTail = _mm256_loadu_si256((const __m256i*)(begin + needleSize - 1));
+                    uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(
+                        _mm256_cmpeq_epi8(blockFirst, first32), _mm256_cmpeq_epi8(blockTail, tail32)));
+                    while(0 != mask) {
+                        cc_size_t offset = __builtin_ctz(mask);
+                        if(0 == memcmp(begin + offset + 1, needle + 1, needleSize - 2)) {
+                            return begin + offset - text;
+                        }
+                        mask &= mask - 1;
+                    }
+                }
+                #endif
+                #if defined(__SSE2__)
+                __m128i first16 = _mm_set1_epi8(first);
+                __m128i tail16 = _mm_set1_epi8(tail);
+                for(; last - begin >= 15; begin += 16) {
+                    __m128i blockFirst = _mm_loadu_si128((const __m128i*)begin);
+                    __m128i blockTail = _mm_loadu_si128((const __m128i*)(begin + needleSize - 1));
+                    uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(
+                        _mm_cmpeq_epi8(blockFirst, first16), _mm_cmpeq_epi8(blockTail, tail16)));
+                    while(0 != mask) {
+                        cc_size_t offset = __builtin_ctz(mask);
+                        if(0 == memcmp(begin + offset + 1, needle + 1, needleSize - 2)) {
+                            return begin + offset - text;
+                        }
+                        mask &= mask - 1;
+                    }
+                }
+                #endif
+                for(; begin <= last; ++begin) {
+                    if(first == begin[0] && tail == begin[needleSize - 1] && 0 == memcmp(begin, needle, needleSize)) {
+                        return begin - text;
+                    }
+                }
+                return SEARCH_NPOS;
+            }
+
+            inline cc_size_t searchHorspool(const char* text, cc_size_t textSize, const char* needle, cc_size_t needleSize) {
+                cc_size_t shift[256];
+                for(int i = 0; i < 256; i++) {
+                    shift[i] = needleSize;
+                }
+                for(cc_size_t i = 0; i + 1 < needleSize; i++) {
+                    shift[(unsigned char)needle[i]] = needleSize - 1 - i;
+                }
+
+                char tail = needle[needleSize - 1];
+                cc_size_t position = 0;
+                while(position + needleSize <= textSize) {
+                    char last = text[position + needleSize - 1];
+                    if(tail == last && 0 == memcmp(text + position, needle, needleSize - 1)) {
+                        return position;
+                    }
+                    position += shift[(unsigned char)last];
+                }
+                return SEARCH_NPOS;
+            }
+        }   //namespace detail
+
+        inline cc_size_t search(const char* text, cc_size_t textSize, const char* needle, cc_size_t needleSize, cc_size_t position = 0) {
+            if(position > textSize || needleSize > textSize - position) {
+                return SEARCH_NPOS;
+            }
+            if(0 == needleSize) return position;
+
+            const char* begin = text + position;
+            cc_size_t size = textSize - position;
+            cc_size_t found;
+            if(1 == needleSize) {
+                const char* hit = scanByte(begin, begin + size, needle[0]);
+                found = hit == begin + size ? SEARCH_NPOS : hit - begin;
+            } else if(needleSize <= detail::SHORT_NEEDLE) {
+                found = detail::searchShort(begin, size, needle, needleSize);
+            } else {
+                found = detail::searchHorspool(begin, size, needle, needleSize);
+            }
+            return SEARCH_NPOS == found ? SEARCH_NPOS : found + position;
+        }
+
+        //NOTICE: last match that starts at or before position
+        inline cc_size_t searchReverse(const char* text, cc_size_t textSize, const char* needle, cc_size_t needleSize, cc_size_t position = SEARCH_NPOS) {
+            if(needleSize > textSize) return SEARCH_NPOS;
+
+            cc_size_t lastStart = textSize - needleSize;
+            if(position < lastStart) lastStart = position;
+            if(0 == needleSize) return lastStart;
+
+            const char* end = text + lastStart + 1;
+            while(true) {
+                const char* hit = scanByteReverse(text, end, needle[0]);
+                if(CC_NULL == hit) return SEARCH_NPOS;
+                if(0 == memcmp(hit, needle, needleSize)) return hit - text;
+                end = hit;
+            }
+        }
+
+        inline cc_size_t searchFirstOf(const char* text, cc_size_t textSize, const char* set, cc_size_t setSize, cc_size_t position = 0) {
+            if(position >= textSize) return SEARCH_NPOS;
+
+            const char* end = text + textSize;
+            const char* hit = scanAnyOf(text + position, end, ByteSet(set, setSize));
+            return hit == end ? SEARCH_NPOS : hit - text;
+        }
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_SEARCH_H
@@ -0,0 +1,167 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: vectorized byte scanning
+ * compare 32 (AVX2) or 16 (SSE2) bytes at once and turn the result into a bit mask,
+ * the lowest set bit is the first match;
+ * the instruction set is picked at compile time (-mavx2 / -msse2), otherwise a plain loop is used.
+************************/
+#ifndef CCLIB_STR_SIMD_SCAN_H
+#define CCLIB_STR_SIMD_SCAN_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace cclib {
+    namespace str {
+        //COMMENT: a set of delimiter bytes, the 256 bit table answers membership, the byte list feeds the vector compares
+        class ByteSet {
+            public:
+                static const cc_size_t VECTOR_LIMIT = 8;
+
+            public:
+                ByteSet(): _count(0) {
+                    memset(_bits, 0, sizeof(_bits));
+                }
+
+                ByteSet(const char* bytes, cc_size_t length): _count(0) {
+                    memset(_bits, 0, sizeof(_bits));
+                    for(cc_size_t i = 0; i < length; i++) {
+                        add(bytes[i]);
+                    }
+                }
+
+                void add(char ch) {
+                    unsigned char byte = (unsigned char)ch;
+                    if(contains(ch)) return;
+
+                    _bits[byte >> 6] |= (uint64_t)1 << (byte & 63);
+                    if(_count < VECTOR_LIMIT) {
+                        _bytes[_count] = ch;
+                    }
+                    ++_count;
+                }
+
+                bool contains(char ch) const {
+                    unsigned char byte = (unsigned char)ch;
+                    return 0 != (_bits[byte >> 6] & ((uint64_t)1 << (byte & 63)));
+                }
+
+                cc_size_t size() const {
+                    return _count;
+                }
+
+                char byte(cc_size_t index) const {
+                    return _bytes[index];
+                }
+
+            private:
+                uint64_t _bits[4];
+                char _bytes[VECTOR_LIMIT];
+                cc_size_t _count;
+        };
+
+        //NOTICE: returns end when ch is not found
+        inline const char* scanByte(const char* begin, const char* end, char ch) {
+            #if defined(__AVX2__)
+            __m256i target32 = _mm256_set1_epi8(ch);
+            for(; end - begin >= 32; begin += 32) {
+                __m256i block = _mm256_loadu_si256((const __m256i*)begin);
+                uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, target32));
+                if(0 != mask) return begin + __builtin_ctz(mask);
+            }
+            #endif
+            #if defined(__SSE2__)
+            __m128i target = _mm_set1_epi8(ch);
+            for(; end - begin >= 16; begin += 16) {
+                __m128i block = _mm_loadu_si128((const __m128i*)begin);
+                uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, target));
+                if(0 != mask) return begin + __builtin_ctz(mask);
+            }
+            #endif
+            for(; begin < end; ++begin) {
+                if(ch == *begin) return begin;
+            }
+            return end;
+        }
+
+        //NOTICE: reverse scan, returns CC_NULL when ch is not found
+        inline const char* scanByteReverse(const char* begin, const char* end, char ch) {
+            #if defined(__SSE2__)
+            __m128i target = _mm_set1_epi8(ch);
+            for(; end - begin >= 16; end -= 16) {
+                __m128i block = _mm_loadu_si128((const __m128i*)(end - 16));
+                uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, target));
+                if(0 != mask) return end - 16 + (31 - __builtin_clz(mask));
+            }
+            #endif
+            while(end > begin) {
+                if(ch == *--end) return end;
+            }
+            return CC_NULL;
+        }
+
+        //NOTICE: returns end when no byte of set is found
+        inline const char* scanAnyOf(const char* begin, const char* end, const ByteSet& set) {
+            if(0 == set.size()) return end;
+            if(1 == set.size()) return scanByte(begin, end, set.byte(0));
+
+            //COMMENT: small sets OR together one compare per delimiter, big sets use the bit table byte by byte
+            if(set.size() <= ByteSet::VECTOR_LIMIT) {
+                #if defined(__AVX2__)
+                __m256i targets32[ByteSet::VECTOR_LIMIT];
+                for(cc_size_t i = 0; i < set.size(); i++) {
+                    targets32[i] = _mm256_set1_epi8(set.byte(i));
+                }
+                for(; end - begin >= 32; begin += 32) {
+                    __m256i block = _mm256_loadu_si256((const __m256i*)begin);
+                    __m256i hit = _mm256_cmpeq_epi8(block, targets32[0]);
+                    for(cc_size_t i = 1; i < set.size(); i++) {
+                        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(block, targets32[i]));
+                    }
+                    uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+                    if(0 != mask) return begin + __builtin_ctz(mask);
+                }
+                #endif
+                #if defined(__SSE2__)
+                __m128i targets[ByteSet::VECTOR_LIMIT];
+                for(cc_size_t i = 0; i < set.size(); i++) {
+                    targets[i] = _mm_set1_epi8(set.byte(i));
+                }
+                for(; end - begin >= 16; begin += 16) {
+                    __m128i block = _mm_loadu_si128((const __m128i*)begin);
+                    __m128i hit = _mm_cmpeq_epi8(block, targets[0]);
+                    for(cc_size_t i = 1; i < set.size(); i++) {
+                        hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, targets[i]));
+                    }
+                    uint32_t mask = (uint32_t)_mm_movemask_epi8(hit);
+                    if(0 != mask) return begin + __builtin_ctz(mask);
+                }
+                #endif
+            }
+
+            for(; begin < end; ++begin) {
+                if(set.contains(*begin)) return begin;
+            }
+            return end;
+        }
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_SIMD_SCAN_H
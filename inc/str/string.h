@@ -1,55 +1,343 @@
-/*********************************************************************
- * cclib
- *
- * Copyright (c) 2019 cclib contributors:
- *   - hello_chenchen <https://github.com/hello-chenchen>
- *
- * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
- * See https://github.com/cc-libraries/cclib for the latest update to this file
- *
- * author: hello_chenchen <https://github.com/hello-chenchen>
- **********************************************************************************/
-#ifndef CCLIB_STR_STRING_H
-#define CCLIB_STR_STRING_H
-#include <string.h> //DEPRECATED:
-#include "./../../cclib-common/inc/base/common_define.h"
-namespace cclib {
-    namespace str {
-        class String {
-            public:
-                String(const char* str = CC_NULL) {
-                    if(NULL == str) {
-                        m_data = new char[1]();
-                        m_data = '\0';
-                    } else {
-                        m_data = new char[strlen(str) + 1]();
-                        strcpy(m_data, str);
-                    }
-                }
-
-                String(const String& other) {
-                    m_data = new char[strlen(other.m_data) + 1]();
-                    strcpy(m_data, other.m_data);
-                }
-
-                String& operator =(const String& other) {
-                    if(this == &other) {
-                        return *this;
-                    }
-
-                    delete m_data;
-                    m_data = NULL;
-
-                    m_data = new char[strlen(other.m_data) + 1]();
-                    strcpy(m_data, other.m_data);
-
-                    return *this;
-                }
-
-            private:
-                char* m_data;
-        };
-    }   //namespace str
-}   //namespace cclib
-
-#endif //CCLIB_STR_STRING_H
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: String with small string optimization
+ * the object is 24 bytes: pointer, size, capacity when the bytes live on the heap;
+ * up to INLINE_CAPACITY (22) bytes are stored in the object itself, no allocation;
+ * the last byte tells the two apart: inline it holds INLINE_CAPACITY - size (the top bit is clear),
+ * on the heap it is the top byte of the capacity word, where the heap flag bit is set;
+ * the byte before it is kept for the '\0' terminator of a full inline string;
+ * size is always stored, copies and appends never call strlen.
+************************/
+#ifndef CCLIB_STR_STRING_H
+#define CCLIB_STR_STRING_H
+#include <string.h> //DEPRECATED:
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "search.h"
+#include "utf8.h"
+namespace cclib {
+    namespace str {
+        class String {
+            public:
+                static const cc_size_t INLINE_CAPACITY = 3 * sizeof(cc_size_t) - 2;
+                static const cc_size_t npos = SEARCH_NPOS;
+
+            public:
+                String(const char* str = CC_NULL) {
+                    initialize(str, CC_NULL == str ? 0 : strlen(str));
+                }
+
+                String(const char* str, cc_size_t length) {
+                    initialize(str, length);
+                }
+
+                String(const String& other) {
+                    if(other.isInline()) {
+                        memcpy(_M_inline, other._M_inline, sizeof(_M_inline));
+                    } else {
+                        initialize(other._M_heap._M_data, other._M_heap._size);
+                    }
+                }
+
+                String(String&& other) {
+                    memcpy(_M_inline, other._M_inline, sizeof(_M_inline));
+                    other.setInlineSize(0);
+                }
+
+                ~String() {
+                    if(!isInline()) {
+                        delete[] _M_heap._M_data;
+                    }
+                }
+
+                String& operator =(const String& other) {
+                    if(this == &other) {
+                        return *this;
+                    }
+
+                    return assign(other.data(), other.size());
+                }
+
+                String& operator =(String&& other) {
+                    if(this == &other) {
+                        return *this;
+                    }
+
+                    if(!isInline()) {
+                        delete[] _M_heap._M_data;
+                    }
+                    memcpy(_M_inline, other._M_inline, sizeof(_M_inline));
+                    other.setInlineSize(0);
+                    return *this;
+                }
+
+                String& operator =(const char* str) {
+                    return assign(str, CC_NULL == str ? 0 : strlen(str));
+                }
+
+                //NOTICE: reuses the current buffer when it is big enough
+                String& assign(const char* str, cc_size_t length) {
+                    if(length > capacity()) {
+                        String temp(str, length);
+                        swap(temp);
+                    } else {
+                        memmove(data(), str, length);
+                        setSize(length);
+                    }
+                    return *this;
+                }
+
+            public:
+                const char* c_str() const {
+                    return data();
+                }
+
+                const char* data() const {
+                    return isInline() ? _M_inline : _M_heap._M_data;
+                }
+
+                char* data() {
+                    return isInline() ? _M_inline : _M_heap._M_data;
+                }
+
+                cc_size_t size() const {
+                    return isInline() ? INLINE_CAPACITY - (unsigned char)_M_inline[MODE_INDEX] : _M_heap._size;
+                }
+
+                cc_size_t length() const {
+                    return size();
+                }
+
+                cc_size_t capacity() const {
+                    return isInline() ? INLINE_CAPACITY : decodeCapacity(_M_heap._capacity);
+                }
+
+                bool empty() const {
+                    return 0 == size();
+                }
+
+                char& operator[](cc_size_t index) {
+                    return data()[index];
+                }
+
+                const char& operator[](cc_size_t index) const {
+                    return data()[index];
+                }
+
+                void clear() {
+                    setSize(0);
+                }
+
+                bool reserve(cc_size_t newCapacity) {
+                    if(newCapacity <= capacity()) return true;
+
+                    cc_size_t oldSize = size();
+                    char* temp = new char[newCapacity + 1];
+                    memcpy(temp, data(), oldSize + 1);
+                    if(!isInline()) {
+                        delete[] _M_heap._M_data;
+                    }
+
+                    _M_heap._M_data = temp;
+                    _M_heap._size = oldSize;
+                    _M_heap._capacity = encodeCapacity(newCapacity);
+                    return true;
+                }
+
+                String& append(const char* str, cc_size_t length) {
+                    cc_size_t oldSize = size();
+                    if(oldSize + length > capacity()) {
+                        //NOTICE: str may point into this string, remember the offset before the buffer moves
+                        const char* begin = data();
+                        bool alias = str >= begin && str < begin + oldSize;
+                        cc_size_t offset = str - begin;
+
+                        cc_size_t grow = 2 * capacity();
+                        reserve(oldSize + length > grow ? oldSize + length : grow);
+                        if(alias) {
+                            str = _M_heap._M_data + offset;
+                        }
+
+                        //NOTICE: more than INLINE_CAPACITY bytes, the string is on the heap now
+                        memcpy(_M_heap._M_data + oldSize, str, length);
+                        _M_heap._size = oldSize + length;
+                        _M_heap._M_data[oldSize + length] = '\0';
+                        return *this;
+                    }
+
+                    memmove(data() + oldSize, str, length);
+                    setSize(oldSize + length);
+                    return *this;
+                }
+
+                String& append(const char* str) {
+                    return append(str, strlen(str));
+                }
+
+                String& append(const String& other) {
+                    return append(other.data(), other.size());
+                }
+
+                String& push_back(char ch) {
+                    return append(&ch, 1);
+                }
+
+                String& operator +=(const String& other) {
+                    return append(other);
+                }
+
+                String& operator +=(const char* str) {
+                    return append(str);
+                }
+
+                String& operator +=(char ch) {
+                    return push_back(ch);
+                }
+
+                cc_size_t find(const String& needle, cc_size_t position = 0) const {
+                    return search(data(), size(), needle.data(), needle.size(), position);
+                }
+
+                cc_size_t find(const char* needle, cc_size_t position = 0) const {
+                    return search(data(), size(), needle, strlen(needle), position);
+                }
+
+                cc_size_t rfind(const String& needle, cc_size_t position = npos) const {
+                    return searchReverse(data(), size(), needle.data(), needle.size(), position);
+                }
+
+                cc_size_t rfind(const char* needle, cc_size_t position = npos) const {
+                    return searchReverse(data(), size(), needle, strlen(needle), position);
+                }
+
+                cc_size_t findFirstOf(const char* set, cc_size_t position = 0) const {
+                    return searchFirstOf(data(), size(), set, strlen(set), position);
+                }
+
+                bool contains(const String& needle) const {
+                    return npos != find(needle);
+                }
+
+                bool contains(const char* needle) const {
+                    return npos != find(needle);
+                }
+
+                bool validUtf8() const {
+                    return validateUtf8(data(), size());
+                }
+
+                //NOTICE: for valid UTF-8 only, see validUtf8()
+                cc_size_t codePoints() const {
+                    return countCodePoints(data(), size());
+                }
+
+                void swap(String& other) {
+                    char temp[sizeof(_M_inline)];
+                    memcpy(temp, _M_inline, sizeof(_M_inline));
+                    memcpy(_M_inline, other._M_inline, sizeof(_M_inline));
+                    memcpy(other._M_inline, temp, sizeof(_M_inline));
+                }
+
+                int compare(const String& other) const {
+                    cc_size_t leftSize = size(), rightSize = other.size();
+                    int result = memcmp(data(), other.data(), leftSize < rightSize ? leftSize : rightSize);
+                    if(0 != result) return result;
+                    return leftSize < rightSize ? -1 : (leftSize > rightSize ? 1 : 0);
+                }
+
+                bool operator==(const String& other) const {
+                    return size() == other.size() && 0 == memcmp(data(), other.data(), size());
+                }
+
+                bool operator!=(const String& other) const {
+                    return !operator==(other);
+                }
+
+                bool operator<(const String& other) const {
+                    return compare(other) < 0;
+                }
+
+                bool operator>(const String& other) const {
+                    return compare(other) > 0;
+                }
+
+            private:
+                static const cc_size_t MODE_INDEX = INLINE_CAPACITY + 1;
+
+                bool isInline() const {
+                    return 0 == (_M_inline[MODE_INDEX] & 0x80);
+                }
+
+                void initialize(const char* str, cc_size_t length) {
+                    if(length <= INLINE_CAPACITY) {
+                        if(0 != length) memcpy(_M_inline, str, length);
+                        setInlineSize(length);
+                    } else {
+                        _M_heap._M_data = new char[length + 1];
+                        memcpy(_M_heap._M_data, str, length);
+                        _M_heap._M_data[length] = '\0';
+                        _M_heap._size = length;
+                        _M_heap._capacity = encodeCapacity(length);
+                    }
+                }
+
+                void setInlineSize(cc_size_t length) {
+                    _M_inline[length] = '\0';
+                    _M_inline[MODE_INDEX] = (char)(INLINE_CAPACITY - length);
+                }
+
+                void setSize(cc_size_t length) {
+                    if(isInline()) {
+                        setInlineSize(length);
+                    } else {
+                        _M_heap._size = length;
+                        _M_heap._M_data[length] = '\0';
+                    }
+                }
+
+                //COMMENT: put the heap flag into the bit that overlaps the top bit of the mode byte
+                #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                static cc_size_t encodeCapacity(cc_size_t capacity) {
+                    return capacity << 8 | 0x80;
+                }
+
+                static cc_size_t decodeCapacity(cc_size_t value) {
+                    return value >> 8;
+                }
+                #else
+                static const cc_size_t HEAP_FLAG = (cc_size_t)1 << (8 * sizeof(cc_size_t) - 1);
+
+                static cc_size_t encodeCapacity(cc_size_t capacity) {
+                    return capacity | HEAP_FLAG;
+                }
+
+                static cc_size_t decodeCapacity(cc_size_t value) {
+                    return value & ~HEAP_FLAG;
+                }
+                #endif
+
+            private:
+                struct Heap {
+                    char* _M_data;
+                    cc_size_t _size;
+                    cc_size_t _capacity;
+                };
+
+                union {
+                    Heap _M_heap;
+                    char _M_inline[sizeof(Heap)];
+                };
+        };
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_STRING_H
@@ -0,0 +1,156 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: StringView
+ * a pointer and a length into bytes owned by somebody else (String, a C string, a read buffer);
+ * copying a view never copies the bytes, the owner has to outlive the view;
+ * the bytes are not required to be '\0' terminated.
+************************/
+#ifndef CCLIB_STR_STRING_VIEW_H
+#define CCLIB_STR_STRING_VIEW_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "string.h"
+
+namespace cclib {
+    namespace str {
+        class StringView {
+            public:
+                static const cc_size_t npos = SEARCH_NPOS;
+
+            public:
+                StringView(): _M_data(""), _size(0) {}
+                StringView(const char* str): _M_data(CC_NULL == str ? "" : str), _size(CC_NULL == str ? 0 : strlen(str)) {}
+                StringView(const char* str, cc_size_t length): _M_data(str), _size(length) {}
+                StringView(const String& str): _M_data(str.data()), _size(str.size()) {}
+
+            public:
+                const char* data() const {
+                    return _M_data;
+                }
+
+                cc_size_t size() const {
+                    return _size;
+                }
+
+                cc_size_t length() const {
+                    return _size;
+                }
+
+                bool empty() const {
+                    return 0 == _size;
+                }
+
+                const char* begin() const {
+                    return _M_data;
+                }
+
+                const char* end() const {
+                    return _M_data + _size;
+                }
+
+                const char& operator[](cc_size_t index) const {
+                    return _M_data[index];
+                }
+
+                char front() const {
+                    return _M_data[0];
+                }
+
+                char back() const {
+                    return _M_data[_size - 1];
+                }
+
+                //NOTICE: position past the end gives an empty view, length is clamped to what is left
+                StringView substr(cc_size_t position, cc_size_t length = npos) const {
+                    if(position > _size) position = _size;
+                    cc_size_t rest = _size - position;
+                    return StringView(_M_data + position, length < rest ? length : rest);
+                }
+
+                void removePrefix(cc_size_t count) {
+                    _M_data += count;
+                    _size -= count;
+                }
+
+                void removeSuffix(cc_size_t count) {
+                    _size -= count;
+                }
+
+                bool startsWith(const StringView& prefix) const {
+                    return prefix._size <= _size && 0 == memcmp(_M_data, prefix._M_data, prefix._size);
+                }
+
+                bool endsWith(const StringView& suffix) const {
+                    return suffix._size <= _size && 0 == memcmp(_M_data + _size - suffix._size, suffix._M_data, suffix._size);
+                }
+
+                cc_size_t find(const StringView& needle, cc_size_t position = 0) const {
+                    return search(_M_data, _size, needle._M_data, needle._size, position);
+                }
+
+                cc_size_t rfind(const StringView& needle, cc_size_t position = npos) const {
+                    return searchReverse(_M_data, _size, needle._M_data, needle._size, position);
+                }
+
+                cc_size_t findFirstOf(const StringView& set, cc_size_t position = 0) const {
+                    return searchFirstOf(_M_data, _size, set._M_data, set._size, position);
+                }
+
+                bool contains(const StringView& needle) const {
+                    return npos != find(needle);
+                }
+
+                bool validUtf8() const {
+                    return validateUtf8(_M_data, _size);
+                }
+
+                cc_size_t codePoints() const {
+                    return countCodePoints(_M_data, _size);
+                }
+
+                int compare(const StringView& other) const {
+                    cc_size_t length = _size < other._size ? _size : other._size;
+                    int result = 0 == length ? 0 : memcmp(_M_data, other._M_data, length);
+                    if(0 != result) return result;
+                    return _size < other._size ? -1 : (_size > other._size ? 1 : 0);
+                }
+
+                bool operator==(const StringView& other) const {
+                    return _size == other._size && (0 == _size || 0 == memcmp(_M_data, other._M_data, _size));
+                }
+
+                bool operator!=(const StringView& other) const {
+                    return !operator==(other);
+                }
+
+                bool operator<(const StringView& other) const {
+                    return compare(other) < 0;
+                }
+
+                bool operator>(const StringView& other) const {
+                    return compare(other) > 0;
+                }
+
+                //NOTICE: the only place where a view copies its bytes
+                String toString() const {
+                    return String(_M_data, _size);
+                }
+
+            private:
+                const char* _M_data;
+                cc_size_t _size;
+        };
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_STRING_VIEW_H
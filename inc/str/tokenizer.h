@@ -0,0 +1,127 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: Tokenizer
+ * lazily splits a buffer into StringView tokens, one token per next() call, nothing is copied;
+ * delimiters are one byte or a set of bytes (ByteSet), found with the vectorized scanByte / scanAnyOf;
+ * by default empty fields are kept (a,,b gives three tokens), skipEmpty drops them (whitespace splitting).
+************************/
+#ifndef CCLIB_STR_TOKENIZER_H
+#define CCLIB_STR_TOKENIZER_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "string_view.h"
+#include "simd_scan.h"
+
+namespace cclib {
+    namespace str {
+        class Tokenizer {
+            public:
+                class iterator {
+                    public:
+                        typedef iterator _Self;
+
+                    public:
+                        iterator(): _M_tokenizer(CC_NULL) {}
+                        explicit iterator(Tokenizer* tokenizer): _M_tokenizer(tokenizer) {
+                            increment();
+                        }
+
+                        const StringView& operator*() const {
+                            return _M_token;
+                        }
+
+                        const StringView* operator->() const {
+                            return &_M_token;
+                        }
+
+                        _Self& operator++() {
+                            increment();
+                            return *this;
+                        }
+
+                        //NOTICE: only end() compares equal, tokens are produced on the fly
+                        bool operator==(const _Self& instance) const {
+                            return _M_tokenizer == instance._M_tokenizer;
+                        }
+
+                        bool operator!=(const _Self& instance) const {
+                            return _M_tokenizer != instance._M_tokenizer;
+                        }
+
+                    private:
+                        void increment() {
+                            if(!_M_tokenizer->next(_M_token)) {
+                                _M_tokenizer = CC_NULL;
+                            }
+                        }
+
+                        Tokenizer* _M_tokenizer;
+                        StringView _M_token;
+                };
+
+            public:
+                Tokenizer(const StringView& text, char delimiter, bool skipEmpty = false):
+                 _M_rest(text), _M_delimiters(&delimiter, 1), _skipEmpty(skipEmpty), _done(false) {}
+
+                Tokenizer(const StringView& text, const ByteSet& delimiters, bool skipEmpty = false):
+                 _M_rest(text), _M_delimiters(delimiters), _skipEmpty(skipEmpty), _done(false) {}
+
+            public:
+                bool next(StringView& token) {
+                    while(!_done) {
+                        const char* begin = _M_rest.begin();
+                        const char* found = scanAnyOf(begin, _M_rest.end(), _M_delimiters);
+
+                        token = StringView(begin, found - begin);
+                        if(found == _M_rest.end()) {
+                            _done = true;   //NOTICE: the last field has no delimiter behind it
+                        } else {
+                            _M_rest.removePrefix(found - begin + 1);
+                        }
+
+                        if(!_skipEmpty || !token.empty()) return true;
+                    }
+                    return false;
+                }
+
+                //COMMENT: what has not been tokenized yet
+                StringView rest() const {
+                    return _done ? StringView() : _M_rest;
+                }
+
+                iterator begin() {
+                    return iterator(this);
+                }
+
+                iterator end() {
+                    return iterator();
+                }
+
+            private:
+                StringView _M_rest;
+                ByteSet _M_delimiters;
+                bool _skipEmpty;
+                bool _done;
+        };
+
+        inline Tokenizer split(const StringView& text, char delimiter, bool skipEmpty = false) {
+            return Tokenizer(text, delimiter, skipEmpty);
+        }
+
+        inline Tokenizer split(const StringView& text, const ByteSet& delimiters, bool skipEmpty = false) {
+            return Tokenizer(text, delimiters, skipEmpty);
+        }
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_TOKENIZER_H
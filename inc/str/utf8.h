@@ -0,0 +1,511 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: UTF-8 validation, counting and transcoding
+ * validateUtf8() checks 32 (AVX2) or 16 (SSSE3) bytes per step with the lookup algorithm of Keiser and Lemire:
+ * three 16 entry tables, indexed by the high and low nibble of the previous byte and the high nibble
+ * of the current byte, flag every invalid two byte combination, one more compare catches the missing
+ * or extra continuation bytes of three and four byte sequences; a block of pure ASCII skips all of it;
+ * countCodePoints() counts the bytes that are not continuation bytes, a compare and a popcount per block;
+ * without SSSE3 (plain x86-64 builds) validation goes 16 bytes at a time over ASCII and decodes the rest;
+ * the transcoders convert a block of 16 ASCII bytes with a few unpack (SSE2) instructions,
+ * a block holding anything else is decoded one code point at a time;
+ * every function works on pointer and length, '\0' is an ordinary character;
+ * transcoders return the number of units written or UTF_ERROR for invalid input,
+ * the destination needs room for utf16LengthFromUtf8() / utf8LengthFromUtf16() / ... units.
+************************/
+#ifndef CCLIB_STR_UTF8_H
+#define CCLIB_STR_UTF8_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace cclib {
+    namespace str {
+        static const cc_size_t UTF_ERROR = (cc_size_t)-1;
+
+        namespace detail {
+            inline bool isContinuation(unsigned char byte) {
+                return 0x80 == (byte & 0xC0);
+            }
+
+            //NOTICE: returns the length of the sequence at p, 0 when it is invalid or cut off
+            inline cc_size_t decodeUtf8(const unsigned char* p, cc_size_t available, uint32_t& codePoint) {
+                unsigned char lead = p[0];
+                if(lead < 0x80) {
+                    codePoint = lead;
+                    return 1;
+                }
+                if(lead < 0xC2) return 0;
+                if(lead < 0xE0) {
+                    if(available < 2 || !isContinuation(p[1])) return 0;
+                    codePoint = (uint32_t)(lead & 0x1F) << 6 | (p[1] & 0x3F);
+                    return 2;
+                }
+                if(lead < 0xF0) {
+                    if(available < 3 || !isContinuation(p[1]) || !isContinuation(p[2])) return 0;
+                    codePoint = (uint32_t)(lead & 0x0F) << 12 | (uint32_t)(p[1] & 0x3F) << 6 | (p[2] & 0x3F);
+                    if(codePoint < 0x800 || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) return 0;
+                    return 3;
+                }
+                if(lead < 0xF5) {
+                    if(available < 4 || !isContinuation(p[1]) || !isContinuation(p[2]) || !isContinuation(p[3])) return 0;
+                    codePoint = (uint32_t)(lead & 0x07) << 18 | (uint32_t)(p[1] & 0x3F) << 12 | (uint32_t)(p[2] & 0x3F) << 6 | (p[3] & 0x3F);
+                    if(codePoint < 0x10000 || codePoint > 0x10FFFF) return 0;
+                    return 4;
+                }
+                return 0;
+            }
+
+            //NOTICE: codePoint must be a valid scalar value
+            inline cc_size_t encodeUtf8(uint32_t codePoint, char* out) {
+                if(codePoint < 0x80) {
+                    out[0] = (char)codePoint;
+                    return 1;
+                }
+                if(codePoint < 0x800) {
+                    out[0] = (char)(0xC0 | codePoint >> 6);
+                    out[1] = (char)(0x80 | (codePoint & 0x3F));
+                    return 2;
+                }
+                if(codePoint < 0x10000) {
+                    out[0] = (char)(0xE0 | codePoint >> 12);
+                    out[1] = (char)(0x80 | (codePoint >> 6 & 0x3F));
+                    out[2] = (char)(0x80 | (codePoint & 0x3F));
+                    return 3;
+                }
+                out[0] = (char)(0xF0 | codePoint >> 18);
+                out[1] = (char)(0x80 | (codePoint >> 12 & 0x3F));
+                out[2] = (char)(0x80 | (codePoint >> 6 & 0x3F));
+                out[3] = (char)(0x80 | (codePoint & 0x3F));
+                return 4;
+            }
+
+            //COMMENT: error bits of the lookup tables, one bit per kind of invalid byte pair
+            static const unsigned char UTF8_TOO_SHORT = 1 << 0;     //lead followed by a lead or ASCII
+            static const unsigned char UTF8_TOO_LONG = 1 << 1;      //ASCII followed by a continuation
+            static const unsigned char UTF8_OVERLONG_3 = 1 << 2;    //11100000 100_____
+            static const unsigned char UTF8_TOO_LARGE = 1 << 3;     //11110100 1001____ and above
+            static const unsigned char UTF8_SURROGATE = 1 << 4;     //11101101 101_____
+            static const unsigned char UTF8_OVERLONG_2 = 1 << 5;    //1100000_ 10______
+            static const unsigned char UTF8_TOO_LARGE_1000 = 1 << 6;//11110101 1000____ and above
+            static const unsigned char UTF8_OVERLONG_4 = 1 << 6;    //11110000 1000____
+            static const unsigned char UTF8_TWO_CONTS = 1 << 7;     //a continuation after a continuation
+            static const unsigned char UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS;
+
+            #define CCLIB_UTF8_BYTE_1_HIGH \
+                UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, \
+                UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, \
+                UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, \
+                UTF8_TOO_SHORT | UTF8_OVERLONG_2, \
+                UTF8_TOO_SHORT, \
+                UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE, \
+                UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+
+            #define CCLIB_UTF8_BYTE_1_LOW \
+                UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4, \
+                UTF8_CARRY | UTF8_OVERLONG_2, \
+                UTF8_CARRY, \
+                UTF8_CARRY, \
+                UTF8_CARRY | UTF8_TOO_LARGE, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+                UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+
+            #define CCLIB_UTF8_BYTE_2_HIGH \
+                UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, \
+                UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, \
+                UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4, \
+                UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE, \
+                UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE, \
+                UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE, \
+                UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+
+            #if defined(__AVX2__)
+            static const cc_size_t UTF8_BLOCK = 32;
+            typedef __m256i Utf8Vector;
+
+            inline Utf8Vector utf8Load(const unsigned char* p) {
+                return _mm256_loadu_si256((const __m256i*)p);
+            }
+
+            inline bool utf8IsAscii(Utf8Vector input) {
+                return 0 == _mm256_movemask_epi8(input);
+            }
+
+            inline Utf8Vector utf8Zero() {
+                return _mm256_setzero_si256();
+            }
+
+            inline Utf8Vector utf8Or(Utf8Vector left, Utf8Vector right) {
+                return _mm256_or_si256(left, right);
+            }
+
+            inline bool utf8Any(Utf8Vector value) {
+                return 0 == _mm256_testz_si256(value, value);
+            }
+
+            //NOTICE: the last N bytes of previous followed by the first 32 - N bytes of input
+            template<int N>
+            inline Utf8Vector utf8Previous(Utf8Vector input, Utf8Vector previous) {
+                return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+            }
+
+            inline Utf8Vector utf8CheckBlock(Utf8Vector input, Utf8Vector previous) {
+                const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+                __m256i previous1 = utf8Previous<1>(input, previous);
+                __m256i byte1High = _mm256_shuffle_epi8(_mm256_setr_epi8(CCLIB_UTF8_BYTE_1_HIGH, CCLIB_UTF8_BYTE_1_HIGH),
+                                                        _mm256_and_si256(_mm256_srli_epi16(previous1, 4), lowNibble));
+                __m256i byte1Low = _mm256_shuffle_epi8(_mm256_setr_epi8(CCLIB_UTF8_BYTE_1_LOW, CCLIB_UTF8_BYTE_1_LOW),
+                                                       _mm256_and_si256(previous1, lowNibble));
+                __m256i byte2High = _mm256_shuffle_epi8(_mm256_setr_epi8(CCLIB_UTF8_BYTE_2_HIGH, CCLIB_UTF8_BYTE_2_HIGH),
+                                                        _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNibble));
+                __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+                //COMMENT: bytes 2 and 3 after a three or four byte lead must be continuations, and nothing else may be
+                __m256i third = _mm256_subs_epu8(utf8Previous<2>(input, previous), _mm256_set1_epi8((char)(0xE0 - 0x80)));
+                __m256i fourth = _mm256_subs_epu8(utf8Previous<3>(input, previous), _mm256_set1_epi8((char)(0xF0 - 0x80)));
+                __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+                return _mm256_xor_si256(must23, special);
+            }
+
+            //NOTICE: nonzero when the block ends inside a multi byte sequence
+            inline Utf8Vector utf8Incomplete(Utf8Vector input) {
+                const __m256i limit = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                       -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                       (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+                return _mm256_subs_epu8(input, limit);
+            }
+            #elif defined(__SSSE3__)
+            static const cc_size_t UTF8_BLOCK = 16;
+            typedef __m128i Utf8Vector;
+
+            inline Utf8Vector utf8Load(const unsigned char* p) {
+                return _mm_loadu_si128((const __m128i*)p);
+            }
+
+            inline bool utf8IsAscii(Utf8Vector input) {
+                return 0 == _mm_movemask_epi8(input);
+            }
+
+            inline Utf8Vector utf8Zero() {
+                return _mm_setzero_si128();
+            }
+
+            inline Utf8Vector utf8Or(Utf8Vector left, Utf8Vector right) {
+                return _mm_or_si128(left, right);
+            }
+
+            inline bool utf8Any(Utf8Vector value) {
+                return 0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_setzero_si128()));
+            }
+
+            template<int N>
+            inline Utf8Vector utf8Previous(Utf8Vector input, Utf8Vector previous) {
+                return _mm_alignr_epi8(input, previous, 16 - N);
+            }
+
+            inline Utf8Vector utf8CheckBlock(Utf8Vector input, Utf8Vector previous) {
+                const __m128i lowNibble = _mm_set1_epi8(0x0F);
+                __m128i previous1 = utf8Previous<1>(input, previous);
+                __m128i byte1High = _mm_shuffle_epi8(_mm_setr_epi8(CCLIB_UTF8_BYTE_1_HIGH), _mm_and_si128(_mm_srli_epi16(previous1, 4), lowNibble));
+                __m128i byte1Low = _mm_shuffle_epi8(_mm_setr_epi8(CCLIB_UTF8_BYTE_1_LOW), _mm_and_si128(previous1, lowNibble));
+                __m128i byte2High = _mm_shuffle_epi8(_mm_setr_epi8(CCLIB_UTF8_BYTE_2_HIGH), _mm_and_si128(_mm_srli_epi16(input, 4), lowNibble));
+                __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+                __m128i third = _mm_subs_epu8(utf8Previous<2>(input, previous), _mm_set1_epi8((char)(0xE0 - 0x80)));
+                __m128i fourth = _mm_subs_epu8(utf8Previous<3>(input, previous), _mm_set1_epi8((char)(0xF0 - 0x80)));
+                __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char)0x80));
+                return _mm_xor_si128(must23, special);
+            }
+
+            inline Utf8Vector utf8Incomplete(Utf8Vector input) {
+                const __m128i limit = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                    (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+                return _mm_subs_epu8(input, limit);
+            }
+            #endif
+
+            #undef CCLIB_UTF8_BYTE_1_HIGH
+            #undef CCLIB_UTF8_BYTE_1_LOW
+            #undef CCLIB_UTF8_BYTE_2_HIGH
+
+            //NOTICE: the text goes in blocks of 16, a block without any byte >= 0x80 is handled as a whole,
+            //any other block is decoded one code point at a time up to its end
+            static const cc_size_t ASCII_BLOCK = 16;
+
+            inline bool asciiBlock(const unsigned char* p) {
+                #if defined(__SSE2__)
+                return 0 == _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p));
+                #else
+                uint64_t low = 0, high = 0;
+                memcpy(&low, p, sizeof(low));
+                memcpy(&high, p + sizeof(low), sizeof(high));
+                return 0 == ((low | high) & 0x8080808080808080ULL);
+                #endif
+            }
+
+            inline bool asciiBlock(const char16_t* p) {
+                #if defined(__SSE2__)
+                __m128i units = _mm_or_si128(_mm_loadu_si128((const __m128i*)p), _mm_loadu_si128((const __m128i*)(p + 8)));
+                return 0 == _mm_movemask_epi8(_mm_cmpgt_epi16(_mm_srli_epi16(units, 7), _mm_setzero_si128()));
+                #else
+                uint32_t units = 0;
+                for(cc_size_t i = 0; i < ASCII_BLOCK; i++) units |= p[i];
+                return units < 0x80;
+                #endif
+            }
+
+            inline const unsigned char* blockEnd(const unsigned char* p, const unsigned char* end) {
+                return (cc_size_t)(end - p) >= ASCII_BLOCK ? p + ASCII_BLOCK : end;
+            }
+
+            inline bool validateUtf8Blocks(const unsigned char* p, const unsigned char* end) {
+                uint32_t codePoint = 0;
+                while(p < end) {
+                    if((cc_size_t)(end - p) >= ASCII_BLOCK && asciiBlock(p)) {
+                        p += ASCII_BLOCK;
+                        continue;
+                    }
+                    for(const unsigned char* stop = blockEnd(p, end); p < stop;) {
+                        if(*p < 0x80) {
+                            ++p;
+                            continue;
+                        }
+                        cc_size_t length = decodeUtf8(p, end - p, codePoint);
+                        if(0 == length) return false;
+                        p += length;
+                    }
+                }
+                return true;
+            }
+        }   //namespace detail
+
+        inline bool validateUtf8(const char* data, cc_size_t length) {
+            const unsigned char* begin = (const unsigned char*)data;
+            const unsigned char* p = begin;
+            const unsigned char* end = p + length;
+
+            #if defined(__AVX2__) || defined(__SSSE3__)
+            if(length >= detail::UTF8_BLOCK) {
+                using namespace detail;
+                //COMMENT: the text is checked as if it were preceded by ASCII
+                Utf8Vector previous = utf8Zero();
+                Utf8Vector error = utf8Zero();
+                Utf8Vector incomplete = utf8Zero();
+                for(; end - p >= (ptrdiff_t)UTF8_BLOCK; p += UTF8_BLOCK) {
+                    Utf8Vector input = utf8Load(p);
+                    if(utf8IsAscii(input)) {
+                        //NOTICE: ASCII right after an unfinished sequence is the only error an ASCII block can hold
+                        error = utf8Or(error, incomplete);
+                    } else {
+                        error = utf8Or(error, utf8CheckBlock(input, previous));
+                        incomplete = utf8Incomplete(input);
+                    }
+                    previous = input;
+                }
+                if(utf8Any(error)) return false;
+
+                //COMMENT: a sequence cut by the last vector is checked again from its lead byte
+                const unsigned char* lead = p;
+                while(lead > begin && p - lead < 3 && isContinuation(*(lead - 1))) --lead;
+                if(lead > begin && *(lead - 1) >= 0xC0) p = lead - 1;
+            }
+            #endif
+
+            return detail::validateUtf8Blocks(p, end);
+        }
+
+        inline bool validateUtf8(const char* data) {
+            return validateUtf8(data, strlen(data));
+        }
+
+        //NOTICE: for valid UTF-8 only, every byte that is not 10xxxxxx starts a code point
+        inline cc_size_t countCodePoints(const char* data, cc_size_t length) {
+            const unsigned char* p = (const unsigned char*)data;
+            const unsigned char* end = p + length;
+            cc_size_t count = 0;
+            #if defined(__AVX2__)
+            const __m256i limit32 = _mm256_set1_epi8(-65);
+            for(; end - p >= 32; p += 32) {
+                __m256i block = _mm256_loadu_si256((const __m256i*)p);
+                count += __builtin_popcount((uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, limit32)));
+            }
+            #endif
+            #if defined(__SSE2__)
+            const __m128i limit = _mm_set1_epi8(-65);
+            for(; end - p >= 16; p += 16) {
+                __m128i block = _mm_loadu_si128((const __m128i*)p);
+                count += __builtin_popcount((uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(block, limit)));
+            }
+            #endif
+            for(; p < end; ++p) {
+                if(!detail::isContinuation(*p)) ++count;
+            }
+            return count;
+        }
+
+        //NOTICE: for valid UTF-8 only, code points above 0xFFFF take two units
+        inline cc_size_t utf16LengthFromUtf8(const char* data, cc_size_t length) {
+            cc_size_t count = countCodePoints(data, length);
+            for(cc_size_t i = 0; i < length; i++) {
+                if((unsigned char)data[i] >= 0xF0) ++count;
+            }
+            return count;
+        }
+
+        inline cc_size_t utf8LengthFromUtf16(const char16_t* data, cc_size_t length) {
+            cc_size_t count = 0;
+            for(cc_size_t i = 0; i < length; i++) {
+                uint32_t unit = data[i];
+                if(unit < 0x80) count += 1;
+                else if(unit < 0x800) count += 2;
+                else if(unit >= 0xD800 && unit <= 0xDBFF) count += 4, ++i;
+                else count += 3;
+            }
+            return count;
+        }
+
+        inline cc_size_t utf8LengthFromUtf32(const char32_t* data, cc_size_t length) {
+            cc_size_t count = 0;
+            for(cc_size_t i = 0; i < length; i++) {
+                uint32_t codePoint = data[i];
+                count += codePoint < 0x80 ? 1 : (codePoint < 0x800 ? 2 : (codePoint < 0x10000 ? 3 : 4));
+            }
+            return count;
+        }
+
+        inline cc_size_t utf8ToUtf16(const char* data, cc_size_t length, char16_t* out) {
+            const unsigned char* p = (const unsigned char*)data;
+            const unsigned char* end = p + length;
+            char16_t* begin = out;
+            uint32_t codePoint = 0;
+            while(p < end) {
+                if((cc_size_t)(end - p) >= detail::ASCII_BLOCK && detail::asciiBlock(p)) {
+                    #if defined(__SSE2__)
+                    //COMMENT: 16 ASCII bytes widen to 16 units with two unpacks against zero
+                    __m128i block = _mm_loadu_si128((const __m128i*)p);
+                    _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi8(block, _mm_setzero_si128()));
+                    _mm_storeu_si128((__m128i*)(out + 8), _mm_unpackhi_epi8(block, _mm_setzero_si128()));
+                    #else
+                    for(cc_size_t i = 0; i < detail::ASCII_BLOCK; i++) out[i] = p[i];
+                    #endif
+                    p += detail::ASCII_BLOCK;
+                    out += detail::ASCII_BLOCK;
+                    continue;
+                }
+                for(const unsigned char* stop = detail::blockEnd(p, end); p < stop;) {
+                    cc_size_t size = detail::decodeUtf8(p, end - p, codePoint);
+                    if(0 == size) return UTF_ERROR;
+                    p += size;
+                    if(codePoint < 0x10000) {
+                        *out++ = (char16_t)codePoint;
+                    } else {
+                        codePoint -= 0x10000;
+                        *out++ = (char16_t)(0xD800 + (codePoint >> 10));
+                        *out++ = (char16_t)(0xDC00 + (codePoint & 0x3FF));
+                    }
+                }
+            }
+            return out - begin;
+        }
+
+        inline cc_size_t utf16ToUtf8(const char16_t* data, cc_size_t length, char* out) {
+            const char16_t* end = data + length;
+            char* begin = out;
+            while(data < end) {
+                if((cc_size_t)(end - data) >= detail::ASCII_BLOCK && detail::asciiBlock(data)) {
+                    #if defined(__SSE2__)
+                    //COMMENT: 16 units below 0x80 narrow to 16 bytes with one saturating pack
+                    _mm_storeu_si128((__m128i*)out, _mm_packus_epi16(_mm_loadu_si128((const __m128i*)data), _mm_loadu_si128((const __m128i*)(data + 8))));
+                    #else
+                    for(cc_size_t i = 0; i < detail::ASCII_BLOCK; i++) out[i] = (char)data[i];
+                    #endif
+                    data += detail::ASCII_BLOCK;
+                    out += detail::ASCII_BLOCK;
+                    continue;
+                }
+                const char16_t* stop = (cc_size_t)(end - data) >= detail::ASCII_BLOCK ? data + detail::ASCII_BLOCK : end;
+                while(data < stop) {
+                    uint32_t unit = *data++;
+                    if(unit >= 0xD800 && unit <= 0xDFFF) {
+                        if(unit > 0xDBFF || data == end || *data < 0xDC00 || *data > 0xDFFF) return UTF_ERROR;
+                        unit = 0x10000 + ((unit - 0xD800) << 10) + (*data++ - 0xDC00);
+                    }
+                    out += detail::encodeUtf8(unit, out);
+                }
+            }
+            return out - begin;
+        }
+
+        inline cc_size_t utf8ToUtf32(const char* data, cc_size_t length, char32_t* out) {
+            const unsigned char* p = (const unsigned char*)data;
+            const unsigned char* end = p + length;
+            char32_t* begin = out;
+            uint32_t codePoint = 0;
+            while(p < end) {
+                if((cc_size_t)(end - p) >= detail::ASCII_BLOCK && detail::asciiBlock(p)) {
+                    #if defined(__SSE2__)
+                    __m128i block = _mm_loadu_si128((const __m128i*)p);
+                    __m128i low = _mm_unpacklo_epi8(block, _mm_setzero_si128());
+                    __m128i high = _mm_unpackhi_epi8(block, _mm_setzero_si128());
+                    _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi16(low, _mm_setzero_si128()));
+                    _mm_storeu_si128((__m128i*)(out + 4), _mm_unpackhi_epi16(low, _mm_setzero_si128()));
+                    _mm_storeu_si128((__m128i*)(out + 8), _mm_unpacklo_epi16(high, _mm_setzero_si128()));
+                    _mm_storeu_si128((__m128i*)(out + 12), _mm_unpackhi_epi16(high, _mm_setzero_si128()));
+                    #else
+                    for(cc_size_t i = 0; i < detail::ASCII_BLOCK; i++) out[i] = p[i];
+                    #endif
+                    p += detail::ASCII_BLOCK;
+                    out += detail::ASCII_BLOCK;
+                    continue;
+                }
+                for(const unsigned char* stop = detail::blockEnd(p, end); p < stop;) {
+                    cc_size_t size = detail::decodeUtf8(p, end - p, codePoint);
+                    if(0 == size) return UTF_ERROR;
+                    p += size;
+                    *out++ = codePoint;
+                }
+            }
+            return out - begin;
+        }
+
+        inline cc_size_t utf32ToUtf8(const char32_t* data, cc_size_t length, char* out) {
+            char* begin = out;
+            for(cc_size_t i = 0; i < length; i++) {
+                uint32_t codePoint = data[i];
+                if(codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) return UTF_ERROR;
+                out += detail::encodeUtf8(codePoint, out);
+            }
+            return out - begin;
+        }
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_UTF8_H
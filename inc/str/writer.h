@@ -0,0 +1,206 @@
+/*********************************************************************
+ * cclib
+ *
+ * Copyright (c) 2019 cclib contributors:
+ *   - hello_chenchen <https://github.com/hello-chenchen>
+ *
+ * MIT License <https://github.com/cc-libraries/cclib/blob/master/LICENSE>
+ * See https://github.com/cc-libraries/cclib for the latest update to this file
+ *
+ * author: hello_chenchen <https://github.com/hello-chenchen>
+ **********************************************************************************/
+/************************
+ * NOTICE: buffered writer
+ * Writer(file) collects text in BUFFER_SIZE bytes inside the object and hands it to fwrite() when full,
+ * Writer(buffer, size) writes into the caller's buffer and drops what does not fit (overflow() tells);
+ * numbers go through toChars() straight into the buffer, nothing is allocated;
+ * containers print themselves with dump(writer), see Pair, Vector, RedBlackTree and BinarySearchTree.
+************************/
+#ifndef CCLIB_STR_WRITER_H
+#define CCLIB_STR_WRITER_H
+
+#include "./../../cclib-common/inc/base/common_define.h"
+#include "format.h"
+#include "string_view.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace cclib {
+    namespace str {
+        class Writer {
+            public:
+                static const cc_size_t BUFFER_SIZE = 4096;
+
+            public:
+                explicit Writer(FILE* file = stdout): _M_file(file), _M_begin(_M_buffer), _M_cursor(_M_buffer),
+                    _M_end(_M_buffer + BUFFER_SIZE), _overflow(false) {}
+
+                Writer(char* buffer, cc_size_t size): _M_file(CC_NULL), _M_begin(buffer), _M_cursor(buffer),
+                    _M_end(buffer + size), _overflow(false) {}
+
+                ~Writer() {
+                    flush();
+                }
+
+            private:
+                Writer(const Writer& instance);
+                Writer& operator=(const Writer& instance);
+
+            public:
+                //NOTICE: only a file writer empties its buffer, a caller buffer keeps everything written
+                void flush() {
+                    if(CC_NULL == _M_file || _M_cursor == _M_begin) return;
+                    fwrite(_M_begin, 1, _M_cursor - _M_begin, _M_file);
+                    _M_cursor = _M_begin;
+                }
+
+                const char* data() const {
+                    return _M_begin;
+                }
+
+                cc_size_t size() const {
+                    return _M_cursor - _M_begin;
+                }
+
+                bool overflow() const {
+                    return _overflow;
+                }
+
+                Writer& write(const char* str, cc_size_t length) {
+                    if(length <= (cc_size_t)(_M_end - _M_cursor)) {
+                        memcpy(_M_cursor, str, length);
+                        _M_cursor += length;
+                        return *this;
+                    }
+                    return spill(str, length);
+                }
+
+                Writer& put(char ch) {
+                    if(_M_cursor == _M_end) {
+                        if(CC_NULL == _M_file) {
+                            _overflow = true;
+                            return *this;
+                        }
+                        flush();
+                    }
+                    *_M_cursor++ = ch;
+                    return *this;
+                }
+
+                //NOTICE: formats in place, a file writer flushes first when the tail is too short;
+                //a full caller buffer keeps the digits that fit, through a small stack buffer
+                template<typename Number>
+                Writer& number(Number value) {
+                    char* next = toChars(_M_cursor, _M_end, value);
+                    if(CC_NULL == next && CC_NULL != _M_file) {
+                        flush();
+                        next = toChars(_M_cursor, _M_end, value);
+                    }
+                    if(CC_NULL != next) {
+                        _M_cursor = next;
+                        return *this;
+                    }
+
+                    char temp[FLOAT_CHARS_MAX];
+                    cc_size_t length = toChars(temp, temp + sizeof(temp), value) - temp;
+                    cc_size_t room = _M_end - _M_cursor;
+                    memcpy(_M_cursor, temp, length < room ? length : room);
+                    _M_cursor += length < room ? length : room;
+                    _overflow = true;
+                    return *this;
+                }
+
+                Writer& operator<<(const char* str) {
+                    return write(str, strlen(str));
+                }
+
+                Writer& operator<<(const StringView& str) {
+                    return write(str.data(), str.size());
+                }
+
+                Writer& operator<<(const String& str) {
+                    return write(str.data(), str.size());
+                }
+
+                Writer& operator<<(char ch) {
+                    return put(ch);
+                }
+
+                Writer& operator<<(bool value) {
+                    return number(value);
+                }
+
+                Writer& operator<<(short value) {
+                    return number(value);
+                }
+
+                Writer& operator<<(unsigned short value) {
+                    return number(value);
+                }
+
+                Writer& operator<<(int value) {
+                    return number(value);
+                }
+
+                Writer& operator<<(unsigned int value) {
+                    return number(value);
+                }
+
+                Writer& operator<<(long value) {
+                    return number(value);
+                }
+
+                Writer& operator<<(unsigned long value) {
+                    return number(value);
+                }
+
+                Writer& operator<<(long long value) {
+                    return number(value);
+                }
+
+                Writer& operator<<(unsigned long long value) {
+                    return number(value);
+                }
+
+                Writer& operator<<(float value) {
+                    return number(value);
+                }
+
+                Writer& operator<<(double value) {
+                    return number(value);
+                }
+
+            private:
+                //NOTICE: length is more than the room left, the tail is filled and flushed until the rest fits
+                Writer& spill(const char* str, cc_size_t length) {
+                    for(;;) {
+                        cc_size_t room = _M_end - _M_cursor;
+                        if(length <= room) {
+                            memcpy(_M_cursor, str, length);
+                            _M_cursor += length;
+                            return *this;
+                        }
+                        memcpy(_M_cursor, str, room);
+                        _M_cursor += room;
+                        if(CC_NULL == _M_file) {
+                            _overflow = true;
+                            return *this;
+                        }
+                        str += room;
+                        length -= room;
+                        flush();
+                    }
+                }
+
+            private:
+                FILE* _M_file;
+                char* _M_begin;
+                char* _M_cursor;
+                char* _M_end;
+                bool _overflow;
+                char _M_buffer[BUFFER_SIZE];
+        };
+    }   //namespace str
+}   //namespace cclib
+
+#endif //CCLIB_STR_WRITER_H
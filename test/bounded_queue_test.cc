@@ -0,0 +1,111 @@
+//COMPILE: g++ bounded_queue_test.cc -std=c++11 -O2 -pthread
+#include "./../inc/adt/bounded_queue.h"
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+using namespace std;
+using namespace cclib::adt;
+
+void mpmcQueueTest() {
+    MPMCQueue<int> aa(3);
+    cout << "capacity: " << aa.capacity() << endl;
+
+    for(int i = 0; i < 5; i++) {
+        cout << "tryPush(" << i << "): " << aa.tryPush(i) << endl;
+    }
+
+    int value = 0;
+    while(aa.tryPop(value)) {
+        cout << "tryPop: " << value << endl;
+    }
+
+    int batch[6] = {1, 2, 3, 4, 5, 6};
+    cout << "tryPushBatch: " << aa.tryPushBatch(batch, 6) << endl;
+    int out[6] = {0};
+    cout << "tryPopBatch: " << aa.tryPopBatch(out, 6) << " first: " << out[0] << " last: " << out[3] << endl;
+}
+
+void spscQueueTest() {
+    SPSCQueue<int> aa(4);
+    int batch[6] = {1, 2, 3, 4, 5, 6};
+    cout << "spsc tryPushBatch: " << aa.tryPushBatch(batch, 6) << " size: " << aa.size() << endl;
+
+    int value = 0;
+    aa.tryPop(value);
+    cout << "spsc tryPop: " << value << " tryPush: " << aa.tryPush(7) << " tryPush: " << aa.tryPush(8) << endl;
+
+    int out[6] = {0};
+    cc_size_t count = aa.tryPopBatch(out, 6);
+    for(cc_size_t i = 0; i < count; i++) {
+        cout << "spsc out: " << out[i] << endl;
+    }
+}
+
+typedef chrono::steady_clock::time_point TimePoint;
+
+//COMMENT: every message carries its send time, consumers sum up the queueing latency
+template<typename Queue>
+void queueBenchmark(Queue& queue, int producers, int consumers, long long count) {
+    std::atomic<long long> latency(0);
+    vector<thread> workers;
+    long long perProducer = count / producers;
+    long long perConsumer = perProducer * producers / consumers;
+    long long total = perConsumer * consumers;
+
+    TimePoint start = chrono::steady_clock::now();
+    for(int p = 0; p < producers; p++) {
+        workers.push_back(thread([&queue, perProducer, p, producers, consumers, total]() {
+            //NOTICE: the last producer fills up the remainder so that consumers never wait forever
+            long long share = p == producers - 1 ? total - perProducer * (producers - 1) : perProducer;
+            for(long long i = 0; i < share; i++) {
+                queue.push(chrono::steady_clock::now());
+            }
+        }));
+    }
+    for(int c = 0; c < consumers; c++) {
+        workers.push_back(thread([&queue, &latency, perConsumer]() {
+            long long sum = 0;
+            TimePoint sendTime;
+            for(long long i = 0; i < perConsumer; i++) {
+                queue.pop(sendTime);
+                sum += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - sendTime).count();
+            }
+            latency += sum;
+        }));
+    }
+    for(cc_size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+    chrono::duration<double> spend = chrono::steady_clock::now() - start;
+
+    cout << producers << "P/" << consumers << "C: " << total / spend.count() / 1e6 << " Mops/s, "
+         << "avg latency: " << (double)latency.load() / total << " ns" << endl;
+}
+
+void boundedQueueBenchmark() {
+    const long long count = 1000000;
+    int maxThread = thread::hardware_concurrency() < 2 ? 2 : (int)thread::hardware_concurrency() / 2;
+
+    {
+        SPSCQueue<TimePoint> queue(1024);
+        cout << "SPSCQueue ";
+        queueBenchmark(queue, 1, 1, count);
+    }
+    for(int producers = 1; producers <= maxThread; producers *= 2) {
+        for(int consumers = 1; consumers <= maxThread; consumers *= 2) {
+            MPMCQueue<TimePoint> queue(1024);
+            cout << "MPMCQueue ";
+            queueBenchmark(queue, producers, consumers, count);
+        }
+    }
+}
+
+int main(int argc, char const *argv[])
+{
+    mpmcQueueTest();
+    spscQueueTest();
+    boundedQueueBenchmark();
+    return 0;
+}
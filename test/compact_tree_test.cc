@@ -0,0 +1,104 @@
+//COMPILE: g++ compact_tree_test.cc -std=c++11 -O2
+#include "./../inc/adt/compact_tree.h"
+#include "./../inc/adt/tree.h"
+#include "./../inc/str/writer.h"
+#include <iostream>
+#include <set>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <malloc.h>
+
+using namespace std;
+using namespace cclib::adt;
+
+void compactTreeTest() {
+    CompactRedBlackTree<int> tree;
+    set<int> expect;
+    int failed = 0;
+    for(int round = 0; round < 50000; round++) {
+        int value = rand() % 3000;
+        if(rand() % 3) {
+            if(tree.insert(value) != expect.insert(value).second) ++failed;
+        } else {
+            if(tree.remove(value) != (0 != expect.erase(value))) ++failed;
+        }
+        if(tree.contains(value) != (0 != expect.count(value))) ++failed;
+    }
+    set<int>::iterator itr = expect.begin();
+    for(int value : tree) {
+        if(itr == expect.end() || value != *itr++) ++failed;
+    }
+    if(tree.size() != expect.size() || itr != expect.end() || *--tree.end() != *expect.rbegin()) ++failed;
+    cout << "compact tree failed: " << failed << " size: " << tree.size() << endl;
+
+    CompactRedBlackTree<int> small;
+    for(int i = 0; i < 10; i++) small.insert((i * 7) % 10);
+    small.remove(3);
+    cclib::str::Writer writer;
+    writer << "compact tree: ";
+    small.dump(writer);
+    writer << '\n';
+    writer.flush();
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+//NOTICE: glibc only, bytes handed out by malloc with its per block overhead, large blocks are mmapped
+size_t heapInUse() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+void compactTreeBenchmark() {
+    const int count = 1000000;
+    vector<int> keys(count), probes(count);
+    for(int i = 0; i < count; i++) {
+        keys[i] = rand();
+        probes[i] = 0 == i % 2 ? keys[rand() % count] : rand();
+    }
+
+    size_t before = heapInUse();
+    RedBlackTree<int>* pointerTree = new RedBlackTree<int>();
+    clock_t start = clock();
+    for(int i = 0; i < count; i++) pointerTree->insert(keys[i]);
+    double pointerInsert = timeSpend(start, clock());
+    size_t pointerBytes = heapInUse() - before;
+
+    before = heapInUse();
+    CompactRedBlackTree<int>* compactTree = new CompactRedBlackTree<int>();
+    start = clock();
+    for(int i = 0; i < count; i++) compactTree->insert(keys[i]);
+    double compactInsert = timeSpend(start, clock());
+    size_t compactBytes = heapInUse() - before;
+
+    cout << "RedBlackTree: " << (double)pointerBytes / pointerTree->size() << " bytes per key, insert " << pointerInsert << "ms" << endl;
+    cout << "CompactRedBlackTree: " << (double)compactBytes / compactTree->size() << " bytes per key ("
+         << (double)compactTree->nodeBytes() / compactTree->size() << " in nodes), insert " << compactInsert << "ms" << endl;
+
+    cc_size_t found = 0;
+    start = clock();
+    for(int round = 0; round < 3; round++) {
+        for(int i = 0; i < count; i++) found += pointerTree->nil() != pointerTree->find(probes[i]);
+    }
+    cout << "RedBlackTree lookup time spend: " << timeSpend(start, clock()) << "ms (" << found << ")" << endl;
+
+    found = 0;
+    start = clock();
+    for(int round = 0; round < 3; round++) {
+        for(int i = 0; i < count; i++) found += compactTree->contains(probes[i]);
+    }
+    cout << "CompactRedBlackTree lookup time spend: " << timeSpend(start, clock()) << "ms (" << found << ")" << endl;
+
+    delete pointerTree;
+    delete compactTree;
+}
+
+int main(int argc, char const *argv[])
+{
+    compactTreeTest();
+    compactTreeBenchmark();
+    return 0;
+}
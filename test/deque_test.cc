@@ -0,0 +1,86 @@
+//COMPILE: g++ deque_test.cc -std=c++11 -O2
+#include "./../inc/adt/deque.h"
+#include "./../inc/adt/vector.h"
+#include <iostream>
+#include <string>
+#include <ctime>
+
+using namespace std;
+using namespace cclib::adt;
+
+void dequeTest() {
+    Deque<int, 4> cc;
+    for(int i = 0; i < 6; i++) {
+        cc.push_back(i);
+        cc.push_front(-i - 1);
+    }
+    cout << "size: " << cc.size() << " front: " << cc.front() << " back: " << cc.back() << endl;
+
+    for(Deque<int, 4>::iterator itr = cc.begin(); itr != cc.end(); ++itr) {
+        cout << *itr << " ";
+    }
+    cout << endl;
+
+    int& stable = cc[3];
+    for(int i = 0; i < 100; i++) {
+        cc.push_back(i);
+        cc.push_front(i);
+    }
+    cout << "stable reference: " << stable << " cc[103]: " << cc[103] << endl;
+
+    while(cc.size() > 2) {
+        cc.pop_front();
+        cc.pop_back();
+    }
+    cout << "size: " << cc.size() << " front: " << cc.front() << " back: " << cc.back() << endl;
+
+    Deque<string> dd;
+    dd.emplace_back(2, 'b');
+    dd.emplace_front("a");
+    Deque<string> ee = dd;
+    dd.clear();
+    cout << "copy: " << ee[0] << ee[1] << " cleared size: " << dd.size() << endl;
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+//COMMENT: sliding window FIFO, push one element and pop the oldest once the window is full
+void dequeBenchmark() {
+    const int window = 10000;
+    const int count = 200000;
+
+    long long sum = 0;
+    clock_t start = clock();
+    Deque<int> deque;
+    for(int i = 0; i < count; i++) {
+        deque.push_back(i);
+        if(deque.size() > window) {
+            sum += deque.front();
+            deque.pop_front();
+        }
+    }
+    clock_t end = clock();
+    cout << "Deque sliding window time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+
+    sum = 0;
+    start = clock();
+    Vector<int> vector;
+    for(int i = 0; i < count; i++) {
+        vector.push_back(i);
+        if(vector.size() > window) {
+            sum += vector[0];
+            vector.earse((cc_size_t)0);
+        }
+    }
+    end = clock();
+    cout << "Vector sliding window time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    dequeTest();
+    dequeBenchmark();
+    return 0;
+}
@@ -0,0 +1,106 @@
+//COMPILE: g++ fenwick_tree_test.cc -std=c++11 -O2
+#include "./../inc/adt/fenwick_tree.h"
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+
+using namespace std;
+using namespace cclib::adt;
+
+void fenwickTreeTest() {
+    const int size = 1000;
+    Vector<long long> values;
+    vector<long long> expect(size);
+    for(int i = 0; i < size; i++) {
+        expect[i] = rand() % 100;
+        values.push_back(expect[i]);
+    }
+    FenwickTree<long long> tree(values);
+    int failed = 0;
+    for(int round = 0; round < 20000; round++) {
+        int index = rand() % size;
+        if(rand() % 2) {
+            long long delta = rand() % 50;
+            tree.add(index, delta);
+            expect[index] += delta;
+        } else {
+            long long value = rand() % 100;
+            tree.set(index, value);
+            expect[index] = value;
+        }
+
+        int first = rand() % (size + 1), last = rand() % (size + 1);
+        if(first > last) swap(first, last);
+        long long sum = 0;
+        for(int i = first; i < last; i++) sum += expect[i];
+        if(tree.rangeSum(first, last) != sum || tree.at(index) != expect[index]) ++failed;
+
+        //COMMENT: the first index whose running sum reaches target, size when none does
+        long long target = rand() % (50 * size + 1000), running = 0;
+        int expectIndex = 0;
+        while(expectIndex < size && running + expect[expectIndex] < target) running += expect[expectIndex++];
+        if(target <= 0) expectIndex = 0;
+        if(tree.lowerBound(target) != (cc_size_t)expectIndex) ++failed;
+    }
+    cout << "fenwick tree failed: " << failed << " total: " << tree.prefixSum(size) << endl;
+
+    FenwickTree<int> small(5);
+    small.add(0, 3);
+    small.add(2, 4);
+    small.add(4, 1);
+    cout << "prefix sums:";
+    for(cc_size_t i = 0; i <= small.size(); i++) cout << " " << small.prefixSum(i);
+    cout << " lowerBound(5): " << small.lowerBound(5) << " lowerBound(9): " << small.lowerBound(9) << endl;
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+//COMMENT: rolling sums with point updates in between, against rescanning the range each time
+void fenwickTreeBenchmark() {
+    const int size = 1000000, queries = 1000000, scans = 2000;
+    Vector<long long> values;
+    vector<long long> plain(size);
+    for(int i = 0; i < size; i++) {
+        plain[i] = rand() % 1000;
+        values.push_back(plain[i]);
+    }
+
+    clock_t start = clock();
+    FenwickTree<long long> tree(values);
+    cout << "build " << size << ": " << timeSpend(start, clock()) << "ms" << endl;
+
+    long long checksum = 0;
+    start = clock();
+    for(int i = 0; i < queries; i++) {
+        int first = rand() % size, last = first + rand() % (size - first + 1);
+        tree.add(rand() % size, 1);
+        checksum += tree.rangeSum(first, last);
+    }
+    double treeTime = timeSpend(start, clock());
+
+    start = clock();
+    for(int i = 0; i < scans; i++) {
+        int first = rand() % size, last = first + rand() % (size - first + 1);
+        plain[rand() % size] += 1;
+        for(int n = first; n < last; n++) checksum += plain[n];
+    }
+    double scanTime = timeSpend(start, clock());
+
+    start = clock();
+    for(int i = 0; i < queries; i++) checksum += tree.lowerBound(rand() % tree.prefixSum(size));
+    double boundTime = timeSpend(start, clock());
+
+    cout << "update + range sum: FenwickTree " << treeTime * 1000 / queries << "us, linear scan "
+         << scanTime * 1000 / scans << "us per query" << endl;
+    cout << "lowerBound: " << boundTime * 1000 / queries << "us per query (" << (checksum != 0) << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    fenwickTreeTest();
+    fenwickTreeBenchmark();
+    return 0;
+}
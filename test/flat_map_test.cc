@@ -0,0 +1,181 @@
+//COMPILE: g++ flat_map_test.cc -std=c++11 -O2
+#include "./../inc/adt/flat_map.h"
+#include "./../inc/adt/tree.h"
+#include "./../inc/str/writer.h"
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <malloc.h>
+
+using namespace std;
+using namespace cclib::adt;
+
+typedef FlatMap<int, int> IntFlatMap;
+
+bool sameMap(const IntFlatMap& map, const std::map<int, int>& expect) {
+    std::map<int, int>::const_iterator itr = expect.begin();
+    bool same = map.size() == expect.size();
+    map.forEach([&](const Pair<int, int>& entry) {
+        if(itr == expect.end() || itr->first != entry._key || itr->second != entry._value) same = false;
+        else ++itr;
+    });
+    return same && itr == expect.end();
+}
+
+void flatMapTest() {
+    IntFlatMap map;
+    std::map<int, int> expect;
+    int failed = 0;
+    for(int round = 0; round < 30000; round++) {
+        int key = rand() % 3000;
+        switch(rand() % 3) {
+            case 0:
+                if(map.erase(key) != (0 != expect.erase(key))) ++failed;
+                break;
+            case 1: {
+                const int* value = map.find(key);
+                if((CC_NULL != value) != (0 != expect.count(key)) || (CC_NULL != value && *value != expect[key])) ++failed;
+                break;
+            }
+            default:
+                if(map.insert(key, round) != expect.insert(make_pair(key, round)).second) ++failed;
+                break;
+        }
+    }
+    if(!sameMap(map, expect)) ++failed;
+
+    //COMMENT: batches with duplicates inside and against the map, the last appended value of a key wins
+    for(int batch = 0; batch < 50; batch++) {
+        int count = rand() % 2000;
+        for(int i = 0; i < count; i++) {
+            int key = rand() % 6000, value = batch * 10000 + i;
+            map.append(key, value);
+            expect[key] = value;
+        }
+        if(map.pending() != (cc_size_t)count) ++failed;
+        map.commit();
+        if(0 != map.pending() || !sameMap(map, expect)) ++failed;
+    }
+
+    cc_size_t erased = map.eraseIf([](const Pair<int, int>& entry) { return 0 == entry._value % 3; });
+    cc_size_t expectErased = 0;
+    for(std::map<int, int>::iterator itr = expect.begin(); itr != expect.end();) {
+        if(0 == itr->second % 3) {
+            expect.erase(itr++);
+            ++expectErased;
+        } else {
+            ++itr;
+        }
+    }
+    if(erased != expectErased || !sameMap(map, expect)) ++failed;
+
+    for(int round = 0; round < 1000; round++) {
+        int low = rand() % 6100 - 50, high = low + rand() % 300;
+        std::map<int, int>::const_iterator itr = expect.lower_bound(low);
+        map.forRange(low, high, [&](const Pair<int, int>& entry) {
+            if(itr == expect.end() || itr->first != entry._key) ++failed;
+            else ++itr;
+        });
+        if(itr != expect.end() && itr->first < high) ++failed;
+    }
+    cout << "flat map failed: " << failed << " size: " << map.size() << endl;
+
+    FlatSet<int> flatSet;
+    set<int> expectSet;
+    failed = 0;
+    for(int i = 0; i < 5000; i++) {
+        int key = rand() % 4000;
+        flatSet.append(key);
+        expectSet.insert(key);
+    }
+    flatSet.commit();
+    if(flatSet.insert(-1) != expectSet.insert(-1).second || flatSet.insert(-1)) ++failed;
+    set<int>::const_iterator itr = expectSet.begin();
+    for(cc_size_t i = 0; i < flatSet.size(); i++, ++itr) {
+        if(flatSet[i] != *itr) ++failed;
+    }
+    if(flatSet.size() != expectSet.size()) ++failed;
+    cout << "flat set failed: " << failed << " size: " << flatSet.size() << endl;
+
+    FlatSet<int> small;
+    int values[] = {5, 3, 9, 3, 1};
+    for(int i = 0; i < 5; i++) small.append(values[i]);
+    small.commit();
+    small.erase(9);
+    cclib::str::Writer writer;
+    writer << "set: ";
+    small.dump(writer);
+    writer << '\n';
+    writer.flush();
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+cc_size_t heapUsed() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+//COMMENT: a config table of count entries rebuilt from scratch, then looked up many times
+void flatMapBenchmark() {
+    const int count = 1000000, lookups = 5000000;
+    vector<int> keys(count);
+    for(int i = 0; i < count; i++) keys[i] = rand();
+
+    cc_size_t before = heapUsed();
+    clock_t start = clock();
+    IntFlatMap map;
+    for(int i = 0; i < count; i++) map.append(keys[i], i);
+    map.commit();
+    double flatBuild = timeSpend(start, clock());
+    cc_size_t flatBytes = heapUsed() - before;
+
+    before = heapUsed();
+    start = clock();
+    RedBlackTree<Pair<int, int> > tree;
+    for(int i = 0; i < count; i++) tree.insert(Pair<int, int>(keys[i], i));
+    double treeBuild = timeSpend(start, clock());
+    cc_size_t treeBytes = heapUsed() - before;
+
+    cout << "build " << map.size() << " entries: FlatMap " << flatBuild << "ms, RedBlackTree " << treeBuild << "ms" << endl;
+    cout << "memory: FlatMap " << (double)flatBytes / map.size() << " bytes/entry, RedBlackTree "
+         << (double)treeBytes / tree.size() << " bytes/entry" << endl;
+
+    vector<int> probes(lookups);
+    for(int i = 0; i < lookups; i++) probes[i] = 0 == i % 2 ? keys[rand() % count] : rand();
+
+    cc_size_t found = 0;
+    start = clock();
+    for(int i = 0; i < lookups; i++) found += map.contains(probes[i]);
+    double flatLookup = timeSpend(start, clock());
+
+    start = clock();
+    for(int i = 0; i < lookups; i++) found += tree.nil() != tree.find(Pair<int, int>(probes[i], 0));
+    cout << "lookup " << lookups << ": FlatMap " << flatLookup << "ms, RedBlackTree " << timeSpend(start, clock()) << "ms (" << found << ")" << endl;
+
+    //COMMENT: a tenth of the table changes, one batch against one insert at a time
+    start = clock();
+    for(int i = 0; i < count / 10; i++) map.append(rand(), i);
+    map.commit();
+    double batchUpdate = timeSpend(start, clock());
+
+    start = clock();
+    for(int i = 0; i < count / 10; i++) tree.insert(Pair<int, int>(rand(), i));
+    cout << "update " << count / 10 << ": FlatMap batch " << batchUpdate << "ms, RedBlackTree " << timeSpend(start, clock()) << "ms" << endl;
+
+    start = clock();
+    cc_size_t erased = map.eraseIf([](const Pair<int, int>& entry) { return 0 == entry._key % 4; });
+    cout << "eraseIf " << erased << ": FlatMap " << timeSpend(start, clock()) << "ms" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    flatMapTest();
+    flatMapBenchmark();
+    return 0;
+}
@@ -0,0 +1,178 @@
+//COMPILE: g++ format_test.cc -std=c++11 -O2
+#include "./../inc/str/format.h"
+#include "./../inc/str/writer.h"
+#include "./../inc/adt/pair.h"
+#include "./../inc/adt/vector.h"
+#include "./../inc/adt/tree.h"
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <ctime>
+
+using namespace std;
+using namespace cclib::str;
+using namespace cclib::adt;
+
+uint64_t randomBits() {
+    uint64_t bits = 0;
+    for(int i = 0; i < 4; i++) {
+        bits = bits << 16 ^ (uint64_t)(rand() & 0xFFFF);
+    }
+    return bits;
+}
+
+template<typename Number>
+string format(Number value) {
+    char buffer[FLOAT_CHARS_MAX];
+    char* end = toChars(buffer, buffer + sizeof(buffer), value);
+    return string(buffer, end - buffer);
+}
+
+void formatTest() {
+    cout << "integers: " << format(0) << " " << format(-7) << " " << format(INT_MIN) << " " << format(LLONG_MIN) << " " << format(ULLONG_MAX) << endl;
+    cout << "doubles: " << format(0.0) << " " << format(-0.0) << " " << format(100.0) << " " << format(0.1) << " " << format(1.0 / 3)
+         << " " << format(1e21) << " " << format(1.5e-7) << " " << format(5e-324) << " " << format(1.7976931348623157e308) << endl;
+    cout << "floats: " << format(0.1f) << " " << format(3.14159f) << " " << format(1e-45f) << " " << format(3.4028235e38f) << endl;
+
+    char small[3];
+    cout << "too small: " << (CC_NULL == toChars(small, small + sizeof(small), 1234)) << " " << (CC_NULL == toChars(small, small + sizeof(small), 0.25)) << endl;
+
+    //COMMENT: integers against snprintf, doubles and floats must read back to the same bits
+    int failed = 0, longer = 0;
+    char expect[64];
+    for(int round = 0; round < 200000; round++) {
+        long long integer = (long long)randomBits() >> (rand() % 64);
+        snprintf(expect, sizeof(expect), "%lld", integer);
+        if(format(integer) != expect) ++failed;
+
+        uint64_t bits = randomBits();
+        double value = 0;
+        memcpy(&value, &bits, sizeof(value));
+        if(value != value) continue;
+        string text = format(value);
+        if(strtod(text.c_str(), CC_NULL) != value) ++failed;
+
+        //NOTICE: count the rare Grisu2 outputs longer than the shortest %.*g text
+        for(int precision = 1; precision <= 17; precision++) {
+            snprintf(expect, sizeof(expect), "%.*g", precision, value);
+            if(strtod(expect, CC_NULL) == value) {
+                string digits = text.substr(0, text.find('e'));
+                cc_size_t count = 0;
+                for(cc_size_t i = 0, leading = 1; i < digits.size(); i++) {
+                    if(digits[i] >= '1' && digits[i] <= '9') leading = 0;
+                    if(!leading && digits[i] >= '0' && digits[i] <= '9') ++count;
+                }
+                if((int)count > precision && string::npos != text.find('e')) ++longer;
+                break;
+            }
+        }
+
+        float single = 0;
+        uint32_t singleBits = (uint32_t)bits;
+        memcpy(&single, &singleBits, sizeof(single));
+        if(single != single) continue;
+        if(strtof(format(single).c_str(), CC_NULL) != single) ++failed;
+    }
+    cout << "random format failed: " << failed << " longer than shortest: " << longer << endl;
+}
+
+void writerTest() {
+    Pair<int, double> pair(42, 2.5);
+    cout << "to_string: " << Pair<int, double>::to_string(pair) << endl;
+
+    Writer writer;
+    writer << "pair: " << pair << '\n';
+
+    Vector<Pair<int, int> > pairs;
+    for(int i = 0; i < 3; i++) {
+        pairs.push_back(Pair<int, int>(i, i * i));
+    }
+    writer << "vector: ";
+    pairs.dump(writer);
+    writer << '\n';
+
+    RedBlackTree<int> tree;
+    BinarySearchTree<int> search;
+    for(int i = 0; i < 10; i++) {
+        tree.insert((i * 7) % 10);
+        search.insert((i * 3) % 10);
+    }
+    writer << "red black tree: ";
+    tree.dump(writer);
+    writer << " binary search tree: ";
+    search.dump(writer);
+    writer << '\n';
+    writer.flush();
+
+    char buffer[8];
+    Writer bounded(buffer, sizeof(buffer));
+    bounded << "overflow " << 12345;
+    cout << "bounded: " << string(bounded.data(), bounded.size()) << " overflow: " << bounded.overflow() << endl;
+
+    char digits[12];
+    Writer partial(digits, sizeof(digits));
+    partial << "value " << 1234567890;
+    cout << "partial: " << string(partial.data(), partial.size()) << " overflow: " << partial.overflow() << endl;
+
+    //COMMENT: longer than the stack buffer of to_string(), nothing may be cut off
+    String longKey("a key far longer than the fixed buffer Pair::to_string starts with, it needs the heap");
+    string dumped = Pair<String, int>::to_string(Pair<String, int>(longKey, 7));
+    cout << "long to_string: " << (dumped == string("key:") + longKey.c_str() + "-value:7") << " size: " << dumped.size() << endl;
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+void formatBenchmark() {
+    const int count = 1000000;
+    char buffer[64];
+    cc_size_t sum = 0;
+
+    clock_t start = clock();
+    for(int i = 0; i < count; i++) {
+        sum += toChars(buffer, buffer + sizeof(buffer), i * 7919LL) - buffer;
+        sum += toChars(buffer, buffer + sizeof(buffer), i * 0.7919) - buffer;
+    }
+    clock_t end = clock();
+    cout << "toChars time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+
+    sum = 0;
+    start = clock();
+    for(int i = 0; i < count; i++) {
+        sum += snprintf(buffer, sizeof(buffer), "%lld", i * 7919LL);
+        sum += snprintf(buffer, sizeof(buffer), "%.17g", i * 0.7919);
+    }
+    end = clock();
+    cout << "snprintf time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+
+    sum = 0;
+    Pair<long long, long long> pair(0, 0);
+    start = clock();
+    for(int i = 0; i < count; i++) {
+        pair._key = i;
+        pair._value = i * 7919LL;
+        sum += Pair<long long, long long>::to_string(pair).size();
+    }
+    end = clock();
+    cout << "Pair::to_string time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+
+    sum = 0;
+    start = clock();
+    for(int i = 0; i < count; i++) {
+        sum += ("key:" + std::to_string((long long)i) + "-" + "value:" + std::to_string(i * 7919LL)).size();
+    }
+    end = clock();
+    cout << "std::to_string concat time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    formatTest();
+    writerTest();
+    formatBenchmark();
+    return 0;
+}
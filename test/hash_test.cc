@@ -0,0 +1,125 @@
+//COMPILE: g++ hash_test.cc -std=c++11 -O2 -mavx2
+#include "./../inc/algorithm/hash/hash.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdlib>
+#include <ctime>
+
+using namespace std;
+using namespace cclib;
+using namespace cclib::algorithm;
+
+int popcount64(uint64_t value) {
+    return __builtin_popcountll(value);
+}
+
+void hashTest() {
+    //NOTICE: the printed values must be the same for -mno-sse2, the default and -mavx2 builds
+    vector<unsigned char> data(10000);
+    for(cc_size_t i = 0; i < data.size(); i++) {
+        data[i] = (unsigned char)(i * 131 + 7);
+    }
+    cc_size_t sizes[] = {0, 3, 8, 17, 49, 4095, 4096, 4097, 10000};
+    uint64_t digest = 0;
+    for(int i = 0; i < 9; i++) {
+        digest = hashCombine(digest, hashBytes(&data[0], sizes[i]));
+    }
+    cout << "digest: " << hex << digest << " seeded: " << hashBytes(&data[0], 10000, 42) << dec << endl;
+
+    str::String text("a key longer than the inline buffer");
+    cout << "string == view: " << (Hash<str::String>()(text) == Hash<str::StringView>()(str::StringView(text))) << endl;
+    cout << "seed changes hash: " << (Hash<str::String>(1)(text) != Hash<str::String>(2)(text)) << endl;
+    //COMMENT: pairs with the same key are equal, their hashes must be too
+    Hash<adt::Pair<int, int> > pairHash;
+    cout << "pair: " << (pairHash(adt::Pair<int, int>(1, 2)) == pairHash(adt::Pair<int, int>(1, 3)))
+         << " " << (pairHash(adt::Pair<int, int>(1, 2)) != pairHash(adt::Pair<int, int>(2, 1)))
+         << " " << (pairHash(adt::Pair<int, int>(7, 0)) == Hash<int>()(7)) << endl;
+    cout << "zero: " << (Hash<double>()(0.0) == Hash<double>()(-0.0)) << endl;
+
+    //COMMENT: flipping one input bit should flip half of the output bits on average
+    int lengths[] = {4, 16, 40, 200, 2000};
+    for(int n = 0; n < 5; n++) {
+        vector<unsigned char> buffer(lengths[n]);
+        long long flipped = 0, trials = 0;
+        for(int round = 0; round < 200; round++) {
+            for(cc_size_t i = 0; i < buffer.size(); i++) buffer[i] = (unsigned char)rand();
+            uint64_t base = hashBytes(&buffer[0], buffer.size(), round);
+            cc_size_t bit = rand() % (8 * buffer.size());
+            buffer[bit / 8] ^= (unsigned char)(1 << (bit % 8));
+            flipped += popcount64(base ^ hashBytes(&buffer[0], buffer.size(), round));
+            ++trials;
+        }
+        cout << "avalanche " << lengths[n] << " bytes: " << (double)flipped / trials << " bits" << endl;
+    }
+
+    //COMMENT: sequential integers spread evenly over 1024 buckets
+    vector<int> buckets(1024, 0);
+    Hash<int> integerHash;
+    for(int i = 0; i < 1024 * 64; i++) {
+        ++buckets[integerHash(i) & 1023];
+    }
+    int largest = 0;
+    for(int i = 0; i < 1024; i++) largest = buckets[i] > largest ? buckets[i] : largest;
+    cout << "integer buckets: average 64, largest " << largest << endl;
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+uint64_t fnv1a(const unsigned char* data, cc_size_t length) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for(cc_size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+void hashBenchmark() {
+    const cc_size_t total = 256 << 20;
+    vector<unsigned char> data(1 << 20);
+    for(cc_size_t i = 0; i < data.size(); i++) data[i] = (unsigned char)rand();
+    string text(data.begin(), data.end());
+
+    cc_size_t sizes[] = {4, 16, 64, 256, 1024, 4096, 65536, 1 << 20};
+    for(int n = 0; n < 8; n++) {
+        cc_size_t size = sizes[n], rounds = total / size;
+        cc_size_t mask = size <= data.size() / 2 ? data.size() / 2 - 1 : 0;
+        uint64_t sum = 0;
+        clock_t start = clock();
+        for(cc_size_t i = 0; i < rounds; i++) {
+            sum += hashBytes(&data[(i * 64) & mask], size);
+        }
+        clock_t end = clock();
+        double hashTime = timeSpend(start, end);
+
+        start = clock();
+        for(cc_size_t i = 0; i < rounds / 8; i++) {
+            sum += fnv1a(&data[(i * 64) & mask], size);
+        }
+        end = clock();
+        double fnvTime = timeSpend(start, end) * 8;
+
+        std::hash<string> stdHash;
+        string sample = text.substr(0, size);
+        start = clock();
+        for(cc_size_t i = 0; i < rounds; i++) {
+            sum += stdHash(sample);
+        }
+        end = clock();
+        double stdTime = timeSpend(start, end);
+
+        cout << "size " << size << ": hashBytes " << total / hashTime / 1e6 << " GB/s, fnv1a " << total / fnvTime / 1e6
+             << " GB/s, std::hash " << total / stdTime / 1e6 << " GB/s (" << (sum & 1) << ")" << endl;
+    }
+}
+
+int main(int argc, char const *argv[])
+{
+    hashTest();
+    hashBenchmark();
+    return 0;
+}
@@ -0,0 +1,108 @@
+//COMPILE: g++ intern_pool_test.cc -std=c++11 -O2 -pthread
+#include "./../inc/str/intern_pool.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <unordered_map>
+#include <cstdio>
+#include <ctime>
+
+using namespace std;
+using namespace cclib::str;
+
+void internPoolTest() {
+    InternPool pool;
+    Symbol aa = pool.intern("hello");
+    Symbol bb = pool.intern(String("hello"));
+    Symbol cc = pool.intern("world", 5);
+    cout << "aa: " << aa.id() << " bb: " << bb.id() << " cc: " << cc.id() << " equal: " << (aa == bb) << " " << (aa == cc) << endl;
+    cout << "view: " << pool.c_str(cc) << " size: " << pool.view(cc).size() << " pool size: " << pool.size() << endl;
+    cout << "find: " << pool.find("hello").id() << " absent valid: " << pool.find("absent").valid() << endl;
+
+    //NOTICE: embedded '\0' and empty strings are ordinary keys
+    Symbol zero = pool.intern("a\0b", 3);
+    Symbol empty = pool.intern("", 0);
+    cout << "zero: " << (zero != pool.intern("a", 1)) << " empty: " << pool.view(empty).size() << " " << (empty == pool.intern("")) << endl;
+
+    //COMMENT: many threads interning one vocabulary must agree on every handle
+    const int threadCount = 4, wordCount = 20000;
+    InternPool shared;
+    vector<vector<uint32_t> > ids(threadCount, vector<uint32_t>(wordCount));
+    vector<thread> threads;
+    for(int t = 0; t < threadCount; t++) {
+        threads.push_back(thread([&, t]() {
+            char word[32];
+            for(int i = 0; i < wordCount; i++) {
+                int n = (i * 7 + t * 13) % wordCount;
+                int length = snprintf(word, sizeof(word), "word-%d", n);
+                ids[t][n] = shared.intern(word, length).id();
+            }
+        }));
+    }
+    for(int t = 0; t < threadCount; t++) {
+        threads[t].join();
+    }
+
+    int failed = 0;
+    char word[32];
+    for(int i = 0; i < wordCount; i++) {
+        for(int t = 1; t < threadCount; t++) {
+            if(ids[t][i] != ids[0][i]) ++failed;
+        }
+        snprintf(word, sizeof(word), "word-%d", i);
+        if(StringView(word) != shared.view(Symbol(ids[0][i]))) ++failed;
+    }
+    cout << "threads: " << threadCount << " symbols: " << shared.size() << " failed: " << failed << endl;
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+//COMMENT: counting a small vocabulary, keyed by symbol versus keyed by the string bytes
+void internPoolBenchmark() {
+    const int vocabulary = 1000, count = 2000000;
+    vector<string> words;
+    for(int i = 0; i < vocabulary; i++) {
+        words.push_back("vocabulary-word-" + to_string(i * 7919));
+    }
+
+    InternPool pool;
+    vector<Symbol> symbols;
+    for(int i = 0; i < vocabulary; i++) {
+        symbols.push_back(pool.intern(words[i].data(), words[i].size()));
+    }
+
+    clock_t start = clock();
+    unordered_map<string, int> byString;
+    for(int i = 0; i < count; i++) {
+        ++byString[words[(i * 31) % vocabulary]];
+    }
+    clock_t end = clock();
+    cout << "string keyed count time spend: " << timeSpend(start, end) << "ms (" << byString.size() << ")" << endl;
+
+    start = clock();
+    vector<int> bySymbol(pool.size(), 0);
+    for(int i = 0; i < count; i++) {
+        ++bySymbol[symbols[(i * 31) % vocabulary].id()];
+    }
+    end = clock();
+    cout << "symbol keyed count time spend: " << timeSpend(start, end) << "ms (" << bySymbol.size() << ")" << endl;
+
+    start = clock();
+    cc_size_t sum = 0;
+    for(int i = 0; i < count; i++) {
+        const string& word = words[(i * 31) % vocabulary];
+        sum += pool.intern(word.data(), word.size()).id();
+    }
+    end = clock();
+    cout << "intern hit time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    internPoolTest();
+    internPoolBenchmark();
+    return 0;
+}
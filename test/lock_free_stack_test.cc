@@ -0,0 +1,114 @@
+//COMPILE: g++ lock_free_stack_test.cc -std=c++11 -O2 -pthread
+#include "./../inc/adt/lock_free_stack.h"
+#include "./../inc/adt/stack.h"
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+
+using namespace std;
+using namespace cclib::adt;
+
+void lockFreeStackTest() {
+    LockFreeStack<int> aa;
+    aa.push(11);
+    aa.push(12);
+    aa.push(13);
+
+    int value = 0;
+    while(aa.pop(value)) {
+        cout << "pop: " << value << endl;
+    }
+    cout << "empty: " << aa.empty() << endl;
+}
+
+//COMMENT: every thread pushes then pops its own share, the total must come back unchanged
+void lockFreeStackConcurrentTest() {
+    const int threadCount = 4;
+    const int count = 100000;
+    LockFreeStack<long long> stack;
+    std::atomic<long long> popSum(0);
+
+    vector<thread> workers;
+    for(int t = 0; t < threadCount; t++) {
+        workers.push_back(thread([&stack, &popSum, t, count]() {
+            long long sum = 0, value = 0;
+            for(int i = 0; i < count; i++) {
+                stack.push((long long)t * count + i);
+                if(stack.pop(value)) sum += value;
+            }
+            popSum += sum;
+        }));
+    }
+    for(cc_size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+
+    long long value = 0, sum = popSum.load();
+    while(stack.pop(value)) sum += value;
+
+    long long expect = (long long)threadCount * count * (threadCount * count - 1) / 2;
+    cout << "concurrent sum: " << sum << " expect: " << expect << (sum == expect ? " ok" : " FAILED") << endl;
+}
+
+template<typename T>
+class MutexStack {
+    public:
+        bool push(const T& data) {
+            std::lock_guard<std::mutex> guard(_M_mutex);
+            return _M_stack.push(data);
+        }
+
+        bool pop(T& data) {
+            std::lock_guard<std::mutex> guard(_M_mutex);
+            if(_M_stack.empty()) return false;
+            data = _M_stack.top();
+            return _M_stack.pop();
+        }
+
+    private:
+        std::mutex _M_mutex;
+        Stack<T> _M_stack;
+};
+
+template<typename StackType>
+double stackThroughput(int threadCount, int count) {
+    StackType stack;
+    vector<thread> workers;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int t = 0; t < threadCount; t++) {
+        workers.push_back(thread([&stack, count]() {
+            int value = 0;
+            for(int i = 0; i < count; i++) {
+                stack.push(i);
+                stack.pop(value);
+            }
+        }));
+    }
+    for(cc_size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+    chrono::duration<double> spend = chrono::steady_clock::now() - start;
+
+    return threadCount * count / spend.count() / 1e6;
+}
+
+void lockFreeStackBenchmark() {
+    const int count = 1000000;
+    unsigned int maxThread = thread::hardware_concurrency() < 2 ? 4 : 2 * thread::hardware_concurrency();
+    for(unsigned int threadCount = 1; threadCount <= maxThread; threadCount *= 2) {
+        cout << "threads: " << threadCount
+             << " LockFreeStack: " << stackThroughput<LockFreeStack<int> >(threadCount, count) << " Mops/s"
+             << " mutex Stack: " << stackThroughput<MutexStack<int> >(threadCount, count) << " Mops/s" << endl;
+    }
+}
+
+int main(int argc, char const *argv[])
+{
+    lockFreeStackTest();
+    lockFreeStackConcurrentTest();
+    lockFreeStackBenchmark();
+    return 0;
+}
@@ -0,0 +1,263 @@
+//COMPILE: g++ persistent_map_test.cc -std=c++11 -O2 -pthread
+void pausePoint(const char* where);
+#define CCLIB_PERSISTENT_MAP_PAUSE(where) pausePoint(where)
+#include "./../inc/adt/persistent_map.h"
+#include "./../inc/adt/tree.h"
+#include "./../inc/str/writer.h"
+#include <iostream>
+#include <map>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+using namespace cclib::adt;
+
+typedef PersistentMap<int, int> IntMap;
+
+//COMMENT: height of the subtree, -1 when the AVL rule, the stored height or the order is broken
+int avlCheck(const PersistentMapNode<int, int>* node) {
+    if(CC_NULL == node) return 0;
+    int left = avlCheck(node->_leftChild), right = avlCheck(node->_rightChild);
+    if(left < 0 || right < 0 || left - right > 1 || right - left > 1) return -1;
+    if(CC_NULL != node->_leftChild && !(node->_leftChild->_key < node->_key)) return -1;
+    if(CC_NULL != node->_rightChild && !(node->_key < node->_rightChild->_key)) return -1;
+    int height = (left > right ? left : right) + 1;
+    return height == node->_height ? height : -1;
+}
+
+bool sameMap(const IntMap& map, const std::map<int, int>& expect) {
+    std::map<int, int>::const_iterator itr = expect.begin();
+    bool same = map.size() == expect.size();
+    map.forEach([&](int key, int value) {
+        if(itr == expect.end() || itr->first != key || itr->second != value) same = false;
+        else ++itr;
+    });
+    return same && itr == expect.end();
+}
+
+void persistentMapTest() {
+    //COMMENT: every 500th version is kept with a copy of what it held, none of them may change later
+    IntMap map;
+    std::map<int, int> expect;
+    vector<IntMap> versions;
+    vector<std::map<int, int> > expectVersions;
+    int failed = 0;
+    for(int round = 0; round < 50000; round++) {
+        int key = rand() % 3000;
+        if(rand() % 3) {
+            map = map.insert(key, round);
+            expect[key] = round;
+        } else {
+            map = map.erase(key);
+            expect.erase(key);
+        }
+        const int* value = map.find(key);
+        if((CC_NULL != value) != (0 != expect.count(key)) || (CC_NULL != value && *value != expect[key])) ++failed;
+        if(map.size() != expect.size()) ++failed;
+        if(0 == round % 500) {
+            versions.push_back(map);
+            expectVersions.push_back(expect);
+        }
+    }
+    for(cc_size_t i = 0; i < versions.size(); i++) {
+        if(!sameMap(versions[i], expectVersions[i]) || avlCheck(versions[i].root()) < 0) ++failed;
+    }
+    if(!sameMap(map, expect)) ++failed;
+    cout << "persistent map failed: " << failed << " versions: " << versions.size() << " size: " << map.size() << endl;
+
+    IntMap small;
+    for(int i = 0; i < 10; i++) small = small.insert((i * 7) % 10, i);
+    IntMap older = small;
+    small = small.erase(3).insert(5, 50);
+    cclib::str::Writer writer;
+    writer << "old: ";
+    older.dump(writer);
+    writer << "\nnew: ";
+    small.dump(writer);
+    writer << '\n';
+    writer.flush();
+}
+
+//COMMENT: the writer publishes 0..n-1 one key at a time, a snapshot must hold exactly the keys below its size
+void concurrentTest() {
+    const int count = 200000, readers = 3;
+    AtomicPersistentMap<int, int> published;
+    atomic<bool> done(false);
+    atomic<int> failed(0);
+    atomic<long long> snapshots(0);
+
+    vector<thread> threads;
+    for(int t = 0; t < readers; t++) {
+        threads.push_back(thread([&]() {
+            long long taken = 0;
+            while(!done.load()) {
+                IntMap snapshot = published.snapshot();
+                int size = (int)snapshot.size();
+                if(size > 0 && (!snapshot.contains(size - 1) || *snapshot.find(size - 1) != 2 * (size - 1))) ++failed;
+                if(snapshot.contains(size)) ++failed;
+                ++taken;
+            }
+            snapshots += taken;
+        }));
+    }
+
+    IntMap map;
+    for(int i = 0; i < count; i++) {
+        map = map.insert(i, 2 * i);
+        published.publish(map);
+    }
+    done.store(true);
+    for(cc_size_t t = 0; t < threads.size(); t++) threads[t].join();
+    if(published.snapshot().size() != count || avlCheck(map.root()) < 0) ++failed;
+    cout << "concurrent snapshot failed: " << failed.load() << " (" << (snapshots.load() > 0) << ")" << endl;
+}
+
+//COMMENT: while parking is on, every thread reaching a pause point takes the next ticket and waits until its gate opens
+atomic<bool> parking(false);
+atomic<int> arrivals(0);
+atomic<bool> gates[3];
+const char* pausedAt[3];
+
+void pausePoint(const char* where) {
+    if(!parking.load(memory_order_relaxed)) return;
+    int ticket = arrivals.fetch_add(1);
+    pausedAt[ticket] = where;
+    while(!gates[ticket].load()) this_thread::yield();
+}
+
+void waitArrivals(int count) {
+    while(arrivals.load() < count) this_thread::yield();
+}
+
+//COMMENT: counts its live copies, the old version must be freed exactly when the last of its holders lets go
+struct Counted {
+    static atomic<int> live;
+    int _value;
+
+    Counted(int value = 0): _value(value) { ++live; }
+    Counted(const Counted& other): _value(other._value) { ++live; }
+    ~Counted() { --live; }
+    Counted& operator=(const Counted& other) { _value = other._value; return *this; }
+};
+atomic<int> Counted::live(0);
+
+//COMMENT: two readers stop between taking their count and handing it back, publish() stops between the exchange
+//and the transfer; the first reader gives its count back before the transfer lands, the second one after it
+void handoffTest() {
+    typedef PersistentMap<int, Counted> CountedMap;
+    int failed = 0;
+    {
+        CountedMap map;
+        for(int i = 0; i < 3; i++) map = map.insert(i, Counted(i));
+        AtomicPersistentMap<int, Counted> published(map);
+        map = CountedMap();
+
+        for(int i = 0; i < 3; i++) gates[i].store(false);
+        arrivals.store(0);
+        parking.store(true);
+        cc_size_t sizes[2] = {0, 0};
+        thread first([&]() { sizes[0] = published.snapshot().size(); });
+        waitArrivals(1);
+        thread second([&]() { sizes[1] = published.snapshot().size(); });
+        waitArrivals(2);
+        thread writer([&]() { published.publish(CountedMap()); });
+        waitArrivals(3);
+        parking.store(false);
+
+        gates[0].store(true);
+        first.join();
+        gates[2].store(true);
+        writer.join();
+        if(0 == Counted::live.load()) ++failed;     //NOTICE: the second reader still holds the old version
+        gates[1].store(true);
+        second.join();
+
+        if(3 != sizes[0] || 3 != sizes[1] || 0 != published.snapshot().size()) ++failed;
+        if(string("snapshot") != pausedAt[0] || string("snapshot") != pausedAt[1] || string("publish") != pausedAt[2]) ++failed;
+        if(0 != Counted::live.load()) ++failed;
+    }
+    if(0 != Counted::live.load()) ++failed;
+    cout << "snapshot handoff failed: " << failed << endl;
+}
+
+double wallSpend(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void persistentMapBenchmark() {
+    const int count = 1000000, updates = 1000;
+    vector<int> keys(count);
+    for(int i = 0; i < count; i++) keys[i] = rand();
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    IntMap map;
+    for(int i = 0; i < count; i++) map = map.insert(keys[i], i);
+    double persistentInsert = wallSpend(start);
+
+    start = chrono::steady_clock::now();
+    RedBlackTree<int> tree;
+    for(int i = 0; i < count; i++) tree.insert(keys[i]);
+    cout << "insert " << count << ": PersistentMap " << persistentInsert << "ms, RedBlackTree " << wallSpend(start) << "ms" << endl;
+
+    //COMMENT: a reader wants a consistent view after every update, the tree can only be copied
+    start = chrono::steady_clock::now();
+    vector<IntMap> versions;
+    for(int i = 0; i < updates; i++) {
+        map = map.insert(rand(), i);
+        versions.push_back(map);
+    }
+    double persistentSnapshot = wallSpend(start);
+
+    start = chrono::steady_clock::now();
+    cc_size_t copied = 0;
+    for(int i = 0; i < 10; i++) {
+        RedBlackTree<int> copy;
+        for(RedBlackTree<int>::iterator itr = tree.begin(); itr != tree.end(); ++itr) copy.insert(*itr);
+        copied += copy.size();
+    }
+    cout << "update and snapshot: PersistentMap " << persistentSnapshot / updates << "ms each, RedBlackTree copy "
+         << wallSpend(start) / 10 << "ms each (" << copied / 10 << ")" << endl;
+
+    cc_size_t found = 0;
+    start = chrono::steady_clock::now();
+    for(int i = 0; i < count; i++) found += map.contains(keys[i]);
+    double persistentLookup = wallSpend(start);
+    start = chrono::steady_clock::now();
+    for(int i = 0; i < count; i++) found += tree.nil() != tree.find(keys[i]);
+    cout << "lookup: PersistentMap " << persistentLookup << "ms, RedBlackTree " << wallSpend(start) << "ms (" << found << ")" << endl;
+
+    //COMMENT: readers look up keys in fresh snapshots while one writer keeps publishing
+    AtomicPersistentMap<int, int> published(map);
+    atomic<bool> done(false);
+    atomic<long long> reads(0);
+    thread reader([&]() {
+        long long local = 0;
+        while(!done.load()) {
+            IntMap snapshot = published.snapshot();
+            for(int i = 0; i < 100; i++) local += snapshot.contains(keys[(local + i) % count]) ? 1 : 0;
+        }
+        reads += local;
+    });
+    start = chrono::steady_clock::now();
+    for(int i = 0; i < 100000; i++) {
+        map = map.insert(rand(), i);
+        published.publish(map);
+    }
+    double writeTime = wallSpend(start);
+    done.store(true);
+    reader.join();
+    cout << "100000 publishes with a reader running: " << writeTime << "ms (" << (reads.load() > 0) << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    persistentMapTest();
+    concurrentTest();
+    handoffTest();
+    persistentMapBenchmark();
+    return 0;
+}
@@ -0,0 +1,191 @@
+//COMPILE: g++ radix_tree_test.cc -std=c++11 -O2
+#include "./../inc/adt/radix_tree.h"
+#include "./../inc/adt/tree.h"
+#include "./../inc/adt/pair.h"
+#include "./../inc/str/string.h"
+#include "./../inc/str/writer.h"
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <malloc.h>
+
+using namespace std;
+using namespace cclib::adt;
+using cclib::str::String;
+using cclib::str::StringView;
+
+typedef RadixTree<int> IntRadix;
+
+//COMMENT: short keys over a small alphabet share prefixes, end inside each other and pass the stored prefix length
+string randomKey() {
+    static const char* stems[] = {"", "a", "ab", "abcdefghijkl", "abcdefghijklmnop", "abcdefgh", "\xff\x01"};
+    string key = stems[rand() % 7];
+    int extra = rand() % 5;
+    for(int i = 0; i < extra; i++) key += (char)("abc\0\xfe"[rand() % 5]);
+    return key;
+}
+
+bool sameTree(const IntRadix& tree, const map<string, int>& expect) {
+    map<string, int>::const_iterator itr = expect.begin();
+    bool same = tree.size() == expect.size();
+    tree.forEach([&](const StringView& key, int value) {
+        if(itr == expect.end() || itr->first != string(key.data(), key.size()) || itr->second != value) same = false;
+        else ++itr;
+    });
+    return same && itr == expect.end();
+}
+
+void radixTreeTest() {
+    IntRadix tree;
+    map<string, int> expect;
+    int failed = 0;
+    for(int round = 0; round < 200000; round++) {
+        string key = randomKey();
+        StringView view(key.data(), key.size());
+        switch(rand() % 3) {
+            case 0:
+                if(tree.erase(view) != (0 != expect.erase(key))) ++failed;
+                break;
+            case 1: {
+                const int* value = tree.find(view);
+                if((CC_NULL != value) != (0 != expect.count(key)) || (CC_NULL != value && *value != expect[key])) ++failed;
+                break;
+            }
+            default: {
+                bool added = 0 == expect.count(key);
+                expect[key] = round;
+                if(tree.insert(view, round) != added) ++failed;
+                break;
+            }
+        }
+        if(tree.size() != expect.size()) ++failed;
+        if(0 == round % 10000 && !sameTree(tree, expect)) ++failed;
+    }
+    if(!sameTree(tree, expect)) ++failed;
+    cout << "radix tree failed: " << failed << " size: " << tree.size() << endl;
+
+    //COMMENT: every prefix scan must return the std::map range [prefix, prefix + 0xff...)
+    failed = 0;
+    for(int round = 0; round < 2000; round++) {
+        string prefix = randomKey();
+        prefix = prefix.substr(0, rand() % (prefix.size() + 1));
+        vector<string> expectKeys;
+        for(map<string, int>::const_iterator itr = expect.lower_bound(prefix); itr != expect.end() && 0 == itr->first.compare(0, prefix.size(), prefix); ++itr) {
+            expectKeys.push_back(itr->first);
+        }
+        vector<string> keys;
+        cc_size_t count = tree.scanPrefix(StringView(prefix.data(), prefix.size()), [&keys](const StringView& key, int) {
+            keys.push_back(string(key.data(), key.size()));
+        });
+        if(keys != expectKeys || count != keys.size()) ++failed;
+    }
+    cout << "prefix scan failed: " << failed << endl;
+
+    //COMMENT: grow every node kind up to 256 children and erase back down through all of them
+    failed = 0;
+    IntRadix wide;
+    for(int i = 0; i < 256; i++) {
+        char key[2] = {'x', (char)i};
+        if(!wide.insert(StringView(key, 2), i)) ++failed;
+    }
+    for(int i = 0; i < 256; i++) {
+        char key[2] = {'x', (char)i};
+        if(CC_NULL == wide.find(StringView(key, 2)) || *wide.find(StringView(key, 2)) != i) ++failed;
+        if(!wide.erase(StringView(key, 2)) || wide.contains(StringView(key, 2))) ++failed;
+    }
+    if(!wide.empty()) ++failed;
+    cout << "node growth failed: " << failed << endl;
+
+    IntRadix small;
+    const char* words[] = {"romane", "romanus", "romulus", "rubens", "ruber", "rubicon", "rubicundus", "rom"};
+    for(int i = 0; i < 8; i++) small.insert(words[i], i);
+    small.erase("ruber");
+    cclib::str::Writer writer;
+    writer << "dump: ";
+    small.dump(writer);
+    writer << "\nrub*: ";
+    small.scanPrefix("rub", [&writer](const StringView& key, int value) { writer << key << '=' << value << ' '; });
+    writer << '\n';
+    writer.flush();
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+cc_size_t heapUsed() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+//COMMENT: urls share a handful of hosts and path stems, the unique part sits at the end
+vector<string> urlDataset(int count) {
+    static const char* hosts[] = {"https://www.example.com/", "https://news.example.org/", "http://shop.example.net/", "https://api.example.io/v2/"};
+    static const char* paths[] = {"articles/", "products/item/", "users/profile/", "static/images/", "search?q="};
+    vector<string> keys(count);
+    for(int i = 0; i < count; i++) {
+        char unique[32];
+        snprintf(unique, sizeof(unique), "%d/%x", rand() % 100000, rand());
+        keys[i] = string(hosts[rand() % 4]) + paths[rand() % 5] + unique;
+    }
+    return keys;
+}
+
+//COMMENT: source identifiers, camel case words from a small vocabulary and a short suffix
+vector<string> identifierDataset(int count) {
+    static const char* words[] = {"get", "set", "Value", "Node", "Tree", "Count", "is", "Empty", "Buffer", "size", "Index", "Parent"};
+    vector<string> keys(count);
+    for(int i = 0; i < count; i++) {
+        string key;
+        int parts = 2 + rand() % 3;
+        for(int p = 0; p < parts; p++) key += words[rand() % 12];
+        keys[i] = key + "_" + to_string(rand() % 1000);
+    }
+    return keys;
+}
+
+void radixTreeBenchmark(const char* name, const vector<string>& keys) {
+    cc_size_t before = heapUsed();
+    clock_t start = clock();
+    IntRadix radix;
+    for(cc_size_t i = 0; i < keys.size(); i++) radix.insert(StringView(keys[i].data(), keys[i].size()), (int)i);
+    double radixInsert = timeSpend(start, clock());
+    cc_size_t radixBytes = heapUsed() - before;
+
+    //NOTICE: the red black tree owns its keys as String, like the radix tree leaves own a copy
+    vector<String> strings(keys.size());
+    for(cc_size_t i = 0; i < keys.size(); i++) strings[i] = String(keys[i].data(), keys[i].size());
+    before = heapUsed();
+    start = clock();
+    RedBlackTree<Pair<String, int> > tree;
+    for(cc_size_t i = 0; i < keys.size(); i++) tree.insert(Pair<String, int>(strings[i], (int)i));
+    double treeInsert = timeSpend(start, clock());
+    cc_size_t treeBytes = heapUsed() - before;
+
+    cout << name << " " << radix.size() << " keys (" << tree.size() << ")" << endl;
+    cout << "  memory: RadixTree " << radixBytes / radix.size() << " bytes/key, RedBlackTree " << treeBytes / tree.size() << " bytes/key" << endl;
+    cout << "  insert: RadixTree " << radixInsert << "ms, RedBlackTree " << treeInsert << "ms" << endl;
+
+    vector<cc_size_t> probes(keys.size());
+    for(cc_size_t i = 0; i < probes.size(); i++) probes[i] = rand() % keys.size();
+
+    cc_size_t found = 0;
+    start = clock();
+    for(cc_size_t i = 0; i < probes.size(); i++) found += radix.contains(StringView(keys[probes[i]].data(), keys[probes[i]].size()));
+    double radixLookup = timeSpend(start, clock());
+
+    start = clock();
+    for(cc_size_t i = 0; i < probes.size(); i++) found += tree.nil() != tree.find(Pair<String, int>(strings[probes[i]], 0));
+    cout << "  lookup: RadixTree " << radixLookup << "ms, RedBlackTree " << timeSpend(start, clock()) << "ms (" << found << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    radixTreeTest();
+    radixTreeBenchmark("urls", urlDataset(1000000));
+    radixTreeBenchmark("identifiers", identifierDataset(1000000));
+    return 0;
+}
@@ -0,0 +1,123 @@
+//COMPILE: g++ rope_test.cc -std=c++11 -O2
+#include "./../inc/str/rope.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <cstdio>
+#include <sys/uio.h>
+
+using namespace std;
+using namespace cclib::str;
+
+string toStd(const Rope& rope) {
+    string result(rope.size(), '\0');
+    rope.copy(&result[0], 0, rope.size());
+    return result;
+}
+
+void ropeTest() {
+    Rope aa("hello world");
+    aa.insert(5, ",");
+    aa.insert(aa.size(), "!");
+    cout << "aa: " << aa.toString().c_str() << " size: " << aa.size() << " [7]: " << aa[7] << endl;
+
+    Rope bb = aa.substr(7, 5);
+    aa.erase(0, 7);
+    cout << "bb: " << bb.toString().c_str() << " aa: " << aa.toString().c_str() << " equal: " << (bb + Rope("!") == aa) << endl;
+
+    //COMMENT: random edits against std::string, small leaves get split and merged all the time
+    int failed = 0;
+    string expect;
+    Rope rope;
+    for(int round = 0; round < 20000; round++) {
+        cc_size_t position = rand() % (expect.size() + 1);
+        int action = rand() % 4;
+        if(0 == action || expect.size() < 100) {
+            string text(rand() % 3000, (char)('a' + rand() % 26));
+            expect.insert(position, text);
+            rope.insert(position, text.data(), text.size());
+        } else if(1 == action) {
+            cc_size_t length = rand() % 3000;
+            expect.erase(position, length);
+            rope.erase(position, length);
+        } else if(2 == action) {
+            cc_size_t length = rand() % 5000;
+            if(expect.substr(position, length) != toStd(rope.substr(position, length))) ++failed;
+        } else if(!expect.empty()) {
+            position = rand() % expect.size();
+            if(expect[position] != rope[position]) ++failed;
+        }
+        if(expect.size() != rope.size()) ++failed;
+    }
+    if(expect != toStd(rope)) ++failed;
+
+    cc_size_t chunks = 0, bytes = 0;
+    rope.forEachChunk([&](const char*, cc_size_t length) { ++chunks; bytes += length; });
+    cout << "random rope failed: " << failed << " size: " << bytes << " chunks: " << chunks << " height: " << rope.height() << endl;
+
+    //COMMENT: a rope inserted into itself, split() must not free the nodes being inserted
+    string selfExpect;
+    for(int i = 0; i < 5000; i++) selfExpect += (char)('a' + i % 26);
+    Rope self(selfExpect.data(), selfExpect.size());
+    self.insert(2500, self);
+    selfExpect.insert(2500, selfExpect);
+    self.append(self);
+    selfExpect += selfExpect;
+    cout << "self insert equal: " << (selfExpect == toStd(self)) << " size: " << self.size() << endl;
+}
+
+//NOTICE: the chunks go straight into writev(), no flattening copy
+void gatherWriteTest() {
+    Rope rope;
+    for(int i = 0; i < 1000; i++) {
+        rope.append("a line of the document written with gather I/O\n");
+    }
+
+    vector<struct iovec> vectors;
+    for(Rope::ChunkIterator iter(rope); !iter.done(); iter.next()) {
+        struct iovec vec;
+        vec.iov_base = (void*)iter.data();
+        vec.iov_len = iter.size();
+        vectors.push_back(vec);
+    }
+
+    FILE* file = tmpfile();
+    ssize_t written = writev(fileno(file), vectors.data(), (int)vectors.size());
+    fclose(file);
+    cout << "writev: " << written << " bytes in " << vectors.size() << " chunks, rope size: " << rope.size() << endl;
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+//COMMENT: small edits at random places of an 8MB document
+template<typename Document>
+void ropeBenchmark(const char* name) {
+    srand(1);
+    string content(8 << 20, 'x');
+    Document document(content.data(), content.size());
+
+    clock_t start = clock();
+    for(int i = 0; i < 20000; i++) {
+        cc_size_t position = rand() % document.size();
+        if(0 == i % 2) {
+            document.insert(position, "edit", 4);
+        } else {
+            document.erase(position, 4);
+        }
+    }
+    clock_t end = clock();
+    cout << name << " 20000 edits time spend: " << timeSpend(start, end) << "ms (" << document.size() << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    ropeTest();
+    gatherWriteTest();
+    ropeBenchmark<Rope>("rope");
+    ropeBenchmark<string>("std::string");
+    return 0;
+}
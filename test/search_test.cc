@@ -0,0 +1,150 @@
+//COMPILE: g++ search_test.cc -std=c++11 -O2 -mavx2
+#include "./../inc/str/string.h"
+#include "./../inc/str/string_view.h"
+#include "./../inc/str/aho_corasick.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+using namespace std;
+using namespace cclib::str;
+
+string randomText(cc_size_t length, int alphabet) {
+    string text(length, 'a');
+    for(cc_size_t i = 0; i < length; i++) {
+        text[i] = (char)('a' + rand() % alphabet);
+    }
+    return text;
+}
+
+//COMMENT: compare against std::string on random inputs, small alphabets give lots of partial matches
+void searchTest() {
+    String hello("hello world, hello search");
+    cout << "find: " << hello.find("hello") << " " << hello.find("hello", 1) << " " << (hello.find("absent") == String::npos) << endl;
+    cout << "rfind: " << hello.rfind("hello") << " findFirstOf: " << hello.findFirstOf(",;") << " contains: " << hello.contains("world") << endl;
+
+    int failed = 0;
+    for(int round = 0; round < 20000; round++) {
+        string text = randomText(rand() % 200, 2 + rand() % 3);
+        string needle = randomText(rand() % 40, 2 + rand() % 3);
+        cc_size_t position = rand() % (text.size() + 2);
+        StringView view(text.data(), text.size());
+        StringView needleView(needle.data(), needle.size());
+
+        cc_size_t expect = text.find(needle, position);
+        cc_size_t result = view.find(needleView, position);
+        if((string::npos == expect ? StringView::npos : expect) != result) ++failed;
+
+        expect = text.rfind(needle, position);
+        result = view.rfind(needleView, position);
+        if((string::npos == expect ? StringView::npos : expect) != result) ++failed;
+
+        expect = text.find_first_of(needle, position);
+        result = view.findFirstOf(needleView, position);
+        if((string::npos == expect ? StringView::npos : expect) != result) ++failed;
+    }
+    cout << "random search failed: " << failed << endl;
+}
+
+void ahoCorasickTest() {
+    AhoCorasick matcher;
+    const char* patterns[] = {"he", "she", "his", "hers"};
+    for(int i = 0; i < 4; i++) {
+        matcher.addPattern(patterns[i]);
+    }
+    matcher.build();
+
+    matcher.scan("ushers", [&](cc_size_t id, cc_size_t position) {
+        cout << "match: " << patterns[id] << " at " << position << endl;
+    });
+    cout << "containsAny: " << matcher.containsAny("ahishe") << " " << matcher.containsAny("xyz") << endl;
+
+    //COMMENT: a pattern added after build() leaves the automaton stale, scan() reports nothing until the next build()
+    cc_size_t stale = 0;
+    matcher.addPattern("us");
+    matcher.scan("ushers", [&](cc_size_t, cc_size_t) { ++stale; });
+    cout << "stale built: " << matcher.built() << " matches: " << stale << " containsAny: " << matcher.containsAny("ushers");
+    matcher.build();
+    matcher.scan("ushers", [&](cc_size_t, cc_size_t) { ++stale; });
+    cout << " rebuilt matches: " << stale << endl;
+
+    int failed = 0;
+    for(int round = 0; round < 200; round++) {
+        vector<string> words;
+        AhoCorasick random;
+        for(int i = 0; i < 20; i++) {
+            words.push_back(randomText(1 + rand() % 4, 3));
+            random.addPattern(StringView(words[i].data(), words[i].size()));
+        }
+        random.build();
+
+        string text = randomText(300, 3);
+        cc_size_t found = 0, expect = 0;
+        random.scan(StringView(text.data(), text.size()), [&](cc_size_t id, cc_size_t position) {
+            if(0 != text.compare(position, words[id].size(), words[id])) ++failed;
+            ++found;
+        });
+        //NOTICE: duplicates report once, count distinct patterns only
+        for(int i = 0; i < 20; i++) {
+            bool duplicate = false;
+            for(int j = 0; j < i; j++) duplicate = duplicate || words[i] == words[j];
+            for(cc_size_t p = text.find(words[i]); !duplicate && string::npos != p; p = text.find(words[i], p + 1)) ++expect;
+        }
+        if(found != expect) ++failed;
+    }
+    cout << "random aho-corasick failed: " << failed << endl;
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+void searchBenchmark() {
+    string text = randomText(1 << 24, 26);
+    const char* needles[] = {"q", "zqxj", "abcdefghijklmnop", "the needle that is longer than thirty two bytes"};
+
+    for(int n = 0; n < 4; n++) {
+        cc_size_t sum = 0;
+        clock_t start = clock();
+        for(int i = 0; i < 10; i++) {
+            sum += StringView(text.data(), text.size()).find(needles[n]);
+        }
+        clock_t end = clock();
+        cout << "find needle " << strlen(needles[n]) << " bytes time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+
+        sum = 0;
+        start = clock();
+        for(int i = 0; i < 10; i++) {
+            const char* hit = strstr(text.c_str(), needles[n]);
+            sum += CC_NULL == hit ? 0 : hit - text.c_str();
+        }
+        end = clock();
+        cout << "strstr needle " << strlen(needles[n]) << " bytes time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+    }
+
+    AhoCorasick matcher;
+    vector<string> patterns;
+    for(int i = 0; i < 2000; i++) {
+        patterns.push_back(randomText(6 + rand() % 6, 26));
+        matcher.addPattern(StringView(patterns[i].data(), patterns[i].size()));
+    }
+    matcher.build();
+
+    cc_size_t matches = 0;
+    clock_t start = clock();
+    matcher.scan(StringView(text.data(), text.size()), [&](cc_size_t, cc_size_t) { ++matches; });
+    clock_t end = clock();
+    cout << "aho-corasick 2000 patterns over " << text.size() / (1 << 20) << "MB time spend: " << timeSpend(start, end)
+         << "ms (" << matches << " matches, " << matcher.stateCount() << " states)" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    searchTest();
+    ahoCorasickTest();
+    searchBenchmark();
+    return 0;
+}
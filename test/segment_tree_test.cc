@@ -0,0 +1,183 @@
+//COMPILE: g++ segment_tree_test.cc -std=c++11 -O2
+#include "./../inc/adt/segment_tree.h"
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+
+using namespace std;
+using namespace cclib::adt;
+
+//COMMENT: range assignment, its updates do not commute, so pushing them down in order matters
+struct SegmentSumAssign {
+    typedef long long Value;
+    typedef long long Update;   //NOTICE: -1 is no assignment, the tested values are never negative
+
+    static Value identity() {
+        return 0;
+    }
+
+    static Value combine(const Value& left, const Value& right) {
+        return left + right;
+    }
+
+    static Update noUpdate() {
+        return -1;
+    }
+
+    static Update compose(const Update& newer, const Update& older) {
+        return -1 == newer ? older : newer;
+    }
+
+    static Value apply(const Value& value, const Update& update, cc_size_t length) {
+        return -1 == update ? value : update * (Value)length;
+    }
+};
+
+template<typename Operation, typename Check>
+int segmentTreeCheck(int size, Check check) {
+    Vector<long long> values;
+    vector<long long> expect(size);
+    for(int i = 0; i < size; i++) {
+        expect[i] = rand() % 1000;
+        values.push_back(expect[i]);
+    }
+    SegmentTree<Operation> tree(values);
+    int failed = 0;
+    for(int round = 0; round < 5000; round++) {
+        int first = rand() % (size + 1), last = rand() % (size + 1);
+        if(first > last) swap(first, last);
+        switch(rand() % 3) {
+            case 0: {
+                long long update = rand() % 100;
+                tree.update(first, last, update);
+                check.update(expect, first, last, update);
+                break;
+            }
+            case 1: {
+                int index = rand() % size;
+                long long value = rand() % 1000;
+                tree.set(index, value);
+                expect[index] = value;
+                break;
+            }
+            default:
+                if(tree.query(first, last) != check.query(expect, first, last)) ++failed;
+                break;
+        }
+    }
+    for(int i = 0; i < size; i++) {
+        if(tree.at(i) != expect[i]) ++failed;
+    }
+    return failed;
+}
+
+struct AddCheck {
+    void update(vector<long long>& values, int first, int last, long long update) {
+        for(int i = first; i < last; i++) values[i] += update;
+    }
+};
+
+struct SumCheck: public AddCheck {
+    long long query(const vector<long long>& values, int first, int last) {
+        long long sum = 0;
+        for(int i = first; i < last; i++) sum += values[i];
+        return sum;
+    }
+};
+
+struct MinCheck: public AddCheck {
+    long long query(const vector<long long>& values, int first, int last) {
+        long long result = SegmentMinAdd<long long>::identity();
+        for(int i = first; i < last; i++) result = values[i] < result ? values[i] : result;
+        return result;
+    }
+};
+
+struct MaxCheck: public AddCheck {
+    long long query(const vector<long long>& values, int first, int last) {
+        long long result = SegmentMaxAdd<long long>::identity();
+        for(int i = first; i < last; i++) result = values[i] > result ? values[i] : result;
+        return result;
+    }
+};
+
+struct AssignCheck: public SumCheck {
+    void update(vector<long long>& values, int first, int last, long long update) {
+        for(int i = first; i < last; i++) values[i] = update;
+    }
+};
+
+void segmentTreeTest() {
+    //NOTICE: 1000 is not a power of two, the padding leaves are in play
+    cout << "sum / add failed: " << segmentTreeCheck<SegmentSumAdd<long long> >(1000, SumCheck()) << endl;
+    cout << "min / add failed: " << segmentTreeCheck<SegmentMinAdd<long long> >(1000, MinCheck()) << endl;
+    cout << "max / add failed: " << segmentTreeCheck<SegmentMaxAdd<long long> >(777, MaxCheck()) << endl;
+    cout << "sum / assign failed: " << segmentTreeCheck<SegmentSumAssign>(1000, AssignCheck()) << endl;
+    cout << "single value failed: " << segmentTreeCheck<SegmentSumAdd<long long> >(1, SumCheck()) << endl;
+
+    SegmentTree<SegmentMinAdd<int> > small(6);
+    for(int i = 0; i < 6; i++) small.set(i, 10 * i);
+    small.update(1, 4, -25);
+    cout << "min values:";
+    for(int i = 0; i < 6; i++) cout << " " << small.at(i);
+    cout << " min [2, 6): " << small.query(2, 6) << endl;
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+//COMMENT: range add followed by a range min, against updating and rescanning the plain array
+void segmentTreeBenchmark() {
+    const int size = 1000000, queries = 1000000, scans = 1000;
+    Vector<long long> values;
+    vector<long long> plain(size);
+    for(int i = 0; i < size; i++) {
+        plain[i] = rand() % 1000000;
+        values.push_back(plain[i]);
+    }
+
+    clock_t start = clock();
+    SegmentTree<SegmentMinAdd<long long> > minTree(values);
+    SegmentTree<SegmentSumAdd<long long> > sumTree(values);
+    cout << "build two trees of " << size << ": " << timeSpend(start, clock()) << "ms" << endl;
+
+    long long checksum = 0;
+    start = clock();
+    for(int i = 0; i < queries; i++) {
+        int first = rand() % size, last = first + rand() % (size - first + 1);
+        minTree.update(first, last, rand() % 10 - 5);
+        checksum += minTree.query(rand() % size, size);
+    }
+    double minTime = timeSpend(start, clock());
+
+    start = clock();
+    for(int i = 0; i < queries; i++) {
+        int first = rand() % size, last = first + rand() % (size - first + 1);
+        sumTree.update(first, last, rand() % 10 - 5);
+        checksum += sumTree.query(rand() % size, size);
+    }
+    double sumTime = timeSpend(start, clock());
+
+    start = clock();
+    for(int i = 0; i < scans; i++) {
+        int first = rand() % size, last = first + rand() % (size - first + 1);
+        long long update = rand() % 10 - 5, result = SegmentMinAdd<long long>::identity();
+        for(int n = first; n < last; n++) plain[n] += update;
+        for(int n = rand() % size; n < size; n++) result = plain[n] < result ? plain[n] : result;
+        checksum += result;
+    }
+    double scanTime = timeSpend(start, clock());
+
+    cout << "range add + range query: min SegmentTree " << minTime * 1000 / queries << "us, sum SegmentTree "
+         << sumTime * 1000 / queries << "us, linear scan " << scanTime * 1000 / scans << "us per query ("
+         << (checksum != 0) << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    segmentTreeTest();
+    segmentTreeBenchmark();
+    return 0;
+}
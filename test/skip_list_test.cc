@@ -0,0 +1,197 @@
+//COMPILE: g++ skip_list_test.cc -std=c++11 -O2 -pthread
+#include "./../inc/adt/skip_list.h"
+#include "./../inc/adt/tree.h"
+#include <iostream>
+#include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+using namespace cclib::adt;
+
+typedef ConcurrentSkipList<int, int> IntSkipList;
+
+bool sameList(IntSkipList& list, const map<int, int>& expect) {
+    map<int, int>::const_iterator itr = expect.begin();
+    bool same = list.size() == expect.size();
+    list.forEach([&](int key, int value) {
+        if(itr == expect.end() || itr->first != key || itr->second != value) same = false;
+        else ++itr;
+    });
+    return same && itr == expect.end();
+}
+
+void skipListTest() {
+    IntSkipList list;
+    map<int, int> expect;
+    int failed = 0;
+    for(int round = 0; round < 100000; round++) {
+        int key = rand() % 3000, value = 0;
+        switch(rand() % 3) {
+            case 0:
+                if(list.erase(key) != (0 != expect.erase(key))) ++failed;
+                break;
+            case 1:
+                if(list.find(key, value) != (0 != expect.count(key)) || (0 != expect.count(key) && value != expect[key])) ++failed;
+                break;
+            default:
+                if(list.insert(key, round) != expect.insert(make_pair(key, round)).second) ++failed;
+                break;
+        }
+        if(list.size() != expect.size()) ++failed;
+    }
+    if(!sameList(list, expect)) ++failed;
+
+    for(int round = 0; round < 1000; round++) {
+        int low = rand() % 3100 - 50, high = low + rand() % 200;
+        map<int, int>::const_iterator itr = expect.lower_bound(low);
+        list.forRange(low, high, [&](int key, int value) {
+            if(itr == expect.end() || itr->first != key || itr->second != value) ++failed;
+            else ++itr;
+        });
+        if(itr != expect.end() && itr->first < high) ++failed;
+    }
+    cout << "skip list failed: " << failed << " size: " << list.size() << endl;
+}
+
+//COMMENT: writers fight over a small key range, each counts what it really added and removed;
+//a scanner checks that every walk comes out strictly ordered while the list changes under it
+void concurrentTest() {
+    const int writers = 4, rounds = 100000, range = 512;
+    IntSkipList list;
+    atomic<long> balance(0);
+    atomic<bool> done(false);
+    atomic<int> failed(0);
+
+    thread scanner([&]() {
+        while(!done.load()) {
+            int last = -1;
+            list.forRange(range / 4, range, [&](int key, int value) {
+                if(key <= last || key < range / 4 || key >= range || value != key * 3) ++failed;
+                last = key;
+            });
+        }
+    });
+
+    vector<thread> threads;
+    for(int t = 0; t < writers; t++) {
+        threads.push_back(thread([&]() {
+            long local = 0;
+            for(int i = 0; i < rounds; i++) {
+                int key = threadRandom() % range, value = 0;
+                switch(threadRandom() % 3) {
+                    case 0: local -= list.erase(key) ? 1 : 0; break;
+                    case 1: if(list.find(key, value) && value != key * 3) ++failed; break;
+                    default: local += list.insert(key, key * 3) ? 1 : 0; break;
+                }
+            }
+            balance += local;
+        }));
+    }
+    for(cc_size_t t = 0; t < threads.size(); t++) threads[t].join();
+    done.store(true);
+    scanner.join();
+
+    long counted = 0;
+    list.forEach([&counted](int, int) { ++counted; });
+    if(counted != balance.load() || (long)list.size() != counted) ++failed;
+    cout << "concurrent skip list failed: " << failed.load() << " size: " << counted << endl;
+}
+
+double wallSpend(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+//COMMENT: the alternative today, one tree behind one mutex
+class MutexTree {
+    public:
+        bool insert(int key) {
+            lock_guard<mutex> guard(_M_mutex);
+            return _M_tree.insert(key);
+        }
+
+        bool erase(int key) {
+            lock_guard<mutex> guard(_M_mutex);
+            bool found = _M_tree.nil() != _M_tree.find(key);
+            _M_tree.remove(key);
+            return found;
+        }
+
+        bool contains(int key) {
+            lock_guard<mutex> guard(_M_mutex);
+            return _M_tree.nil() != _M_tree.find(key);
+        }
+
+    private:
+        mutex _M_mutex;
+        RedBlackTree<int> _M_tree;
+};
+
+//NOTICE: every thread does operations / threads mixed operations, writePercent of them insert or erase
+template<typename Map, typename Insert, typename Erase, typename Lookup>
+double mixedRun(Map& map, int threadCount, int operations, int writePercent, int range, Insert insert, Erase erase, Lookup lookup, long& hits) {
+    atomic<long> total(0);
+    vector<thread> threads;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int t = 0; t < threadCount; t++) {
+        threads.push_back(thread([&]() {
+            long local = 0;
+            int count = operations / threadCount;
+            for(int i = 0; i < count; i++) {
+                int key = threadRandom() % range;
+                int dice = threadRandom() % 100;
+                if(dice < writePercent / 2) local += insert(map, key);
+                else if(dice < writePercent) local += erase(map, key);
+                else local += lookup(map, key);
+            }
+            total += local;
+        }));
+    }
+    for(cc_size_t t = 0; t < threads.size(); t++) threads[t].join();
+    double spend = wallSpend(start);
+    hits += total.load();   //NOTICE: used, so the lookups can not be optimized away
+    return spend;
+}
+
+void skipListBenchmark() {
+    const int range = 1000000, operations = 2000000;
+    int writes[] = {10, 50};
+    int threadCounts[] = {1, 2, 4, 8, 32};
+    long hits = 0;
+    cout << "hardware threads: " << thread::hardware_concurrency() << endl;
+    for(int w = 0; w < 2; w++) {
+        for(int c = 0; c < 5; c++) {
+            IntSkipList list;
+            MutexTree tree;
+            for(int i = 0; i < range / 2; i++) {
+                int key = rand() % range;
+                list.insert(key, key);
+                tree.insert(key);
+            }
+
+            double listTime = mixedRun(list, threadCounts[c], operations, writes[w], range,
+                [](IntSkipList& map, int key) { return map.insert(key, key) ? 1 : 0; },
+                [](IntSkipList& map, int key) { return map.erase(key) ? 1 : 0; },
+                [](IntSkipList& map, int key) { return map.contains(key) ? 1 : 0; }, hits);
+            double treeTime = mixedRun(tree, threadCounts[c], operations, writes[w], range,
+                [](MutexTree& map, int key) { return map.insert(key) ? 1 : 0; },
+                [](MutexTree& map, int key) { return map.erase(key) ? 1 : 0; },
+                [](MutexTree& map, int key) { return map.contains(key) ? 1 : 0; }, hits);
+            cout << writes[w] << "% writes, " << threadCounts[c] << " threads: ConcurrentSkipList " << listTime
+                 << "ms, mutex RedBlackTree " << treeTime << "ms" << endl;
+        }
+    }
+    cout << "(" << hits << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    skipListTest();
+    concurrentTest();
+    skipListBenchmark();
+    return 0;
+}
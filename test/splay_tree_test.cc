@@ -0,0 +1,139 @@
+//COMPILE: g++ splay_tree_test.cc -std=c++11 -O2
+#include "./../inc/adt/splay_tree.h"
+#include "./../inc/adt/tree.h"
+#include "./../inc/str/writer.h"
+#include <iostream>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+
+using namespace std;
+using namespace cclib::adt;
+
+void splayTreeTest() {
+    SplayTree<int> tree;
+    set<int> expect;
+    int failed = 0;
+    for(int round = 0; round < 50000; round++) {
+        int value = rand() % 3000;
+        switch(rand() % 3) {
+            case 0:
+                if(tree.remove(value) != (0 != expect.erase(value))) ++failed;
+                break;
+            case 1:
+                if(tree.contains(value) != (0 != expect.count(value))) ++failed;
+                break;
+            default:
+                if(tree.insert(value) != expect.insert(value).second) ++failed;
+                break;
+        }
+        if(tree.size() != expect.size()) ++failed;
+    }
+    cout << "splay tree failed: " << failed << " size: " << tree.size() << endl;
+
+    //COMMENT: split at every kind of key, join back, the sizes and contents must survive
+    failed = 0;
+    for(int round = 0; round < 200; round++) {
+        int key = rand() % 3100 - 50;
+        SplayTree<int> right;
+        tree.split(key, right);
+        cc_size_t expectRight = distance(expect.lower_bound(key), expect.end());
+        if(right.size() != expectRight || tree.size() != expect.size() - expectRight) ++failed;
+        if(expectRight > 0 && !right.contains(*expect.lower_bound(key))) ++failed;
+        if(expectRight < expect.size() && tree.contains(*expect.lower_bound(key))) ++failed;
+        tree.join(right);
+        if(tree.size() != expect.size() || !right.empty()) ++failed;
+    }
+    //COMMENT: a tree split into or joined with itself keeps every value
+    tree.split(1500, tree);
+    tree.join(tree);
+    if(tree.size() != expect.size() || (!expect.empty() && !tree.contains(*expect.rbegin()))) ++failed;
+    cout << "split and join failed: " << failed << endl;
+
+    SplayTree<int> small, other;
+    for(int i = 0; i < 10; i++) small.insert(9 - i);
+    small.split(5, other);
+    cclib::str::Writer writer;
+    writer << "split: ";
+    small.dump(writer);
+    writer << ' ';
+    other.dump(writer);
+    small.join(other);
+    writer << " join: ";
+    small.dump(writer);
+    writer << '\n';
+    writer.flush();
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+//COMMENT: Zipf(1.0) over count keys, key i has weight 1 / (i + 1), hot keys are scattered over the key space
+vector<int> zipfSample(int count, int samples, const vector<int>& keys) {
+    vector<double> cumulative(count);
+    double total = 0;
+    for(int i = 0; i < count; i++) {
+        total += 1.0 / (i + 1);
+        cumulative[i] = total;
+    }
+    vector<int> result(samples);
+    for(int i = 0; i < samples; i++) {
+        double target = total * rand() / RAND_MAX;
+        int index = lower_bound(cumulative.begin(), cumulative.end(), target) - cumulative.begin();
+        result[i] = keys[index < count ? index : count - 1];
+    }
+    return result;
+}
+
+void splayTreeBenchmark() {
+    const int count = 1000000, samples = 3000000;
+    vector<int> keys(count);
+    for(int i = 0; i < count; i++) keys[i] = i;
+    for(int i = count - 1; i > 0; i--) swap(keys[i], keys[rand() % (i + 1)]);
+    vector<int> probes = zipfSample(count, samples, keys);
+
+    SplayTree<int> splay;
+    RedBlackTree<int> redBlack;
+    BinarySearchTree<int, BinaryAVLBalance> avl;
+    for(int i = 0; i < count; i++) {
+        splay.insert(keys[i]);
+        redBlack.insert(keys[i]);
+        avl.insert(keys[i]);
+    }
+
+    cc_size_t found = 0;
+    clock_t start = clock();
+    for(int i = 0; i < samples; i++) found += splay.contains(probes[i]);
+    cout << "zipf SplayTree lookup time spend: " << timeSpend(start, clock()) << "ms (" << found << ")" << endl;
+
+    found = 0;
+    start = clock();
+    for(int i = 0; i < samples; i++) found += redBlack.nil() != redBlack.find(probes[i]);
+    cout << "zipf RedBlackTree lookup time spend: " << timeSpend(start, clock()) << "ms (" << found << ")" << endl;
+
+    found = 0;
+    start = clock();
+    for(int i = 0; i < samples; i++) found += avl.contains(probes[i]);
+    cout << "zipf AVL BinarySearchTree lookup time spend: " << timeSpend(start, clock()) << "ms (" << found << ")" << endl;
+
+    //NOTICE: uniform lookups are where splaying costs more than it saves
+    found = 0;
+    start = clock();
+    for(int i = 0; i < samples; i++) found += splay.contains(rand() % count);
+    cout << "uniform SplayTree lookup time spend: " << timeSpend(start, clock()) << "ms (" << found << ")" << endl;
+
+    found = 0;
+    start = clock();
+    for(int i = 0; i < samples; i++) found += redBlack.nil() != redBlack.find(rand() % count);
+    cout << "uniform RedBlackTree lookup time spend: " << timeSpend(start, clock()) << "ms (" << found << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    splayTreeTest();
+    splayTreeBenchmark();
+    return 0;
+}
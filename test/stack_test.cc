@@ -1,5 +1,8 @@
+//COMPILE: g++ stack_test.cc -std=c++11 -O2
 #include "./../inc/adt/stack.h"
 #include <iostream>
+#include <string>
+#include <ctime>
 
 using namespace std;
 using namespace cclib::adt;
@@ -15,14 +18,70 @@ void stack_test() {
         aa.pop();
     }
 
-    cout << "top: " << aa.top() << endl;
+    cout << "empty: " << aa.empty() << endl;
 
     Stack<int> bb;
-    cout << "bb top: " << bb.top() << endl;
+    cout << "bb empty: " << bb.empty() << " pop: " << bb.pop() << endl;
+}
+
+void stackSpillTest() {
+    Stack<string, 2> cc;
+    cc.push("a");
+    cc.push(string("b"));
+    cout << "inline onHeap: " << cc.onHeap() << " capacity: " << cc.capacity() << endl;
+
+    cc.emplace(3, 'c');
+    cc.push(cc.top());
+    cc.emplace(cc.top());   //COMMENT: full again, the argument lives in the buffer that moves
+    cout << "spill onHeap: " << cc.onHeap() << " capacity: " << cc.capacity() << " top: " << cc.top() << endl;
+
+    Stack<string, 2> dd = cc;
+    Stack<string, 2> ee(std::move(cc));
+    cout << "copy size: " << dd.size() << " move size: " << ee.size() << " moved-from size: " << cc.size() << endl;
+
+    while(!ee.empty()) {
+        cout << "ee: " << ee.top() << endl;
+        ee.pop();
+    }
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+template<typename StackType>
+long long pushPopRound(StackType& stack, int depth) {
+    long long sum = 0;
+    for(int i = 0; i < depth; i++) {
+        stack.push(i);
+    }
+    while(!stack.empty()) {
+        sum += stack.top();
+        stack.pop();
+    }
+    return sum;
+}
+
+void stackBenchmark() {
+    const int round = 1000000;
+    const int depths[] = {3, 16, 64};
+
+    for(int n = 0; n < 3; n++) {
+        long long sum = 0;
+        clock_t start = clock();
+        for(int i = 0; i < round; i++) {
+            Stack<int> stack;   //NOTICE: construct per round, the parse stack use case
+            sum += pushPopRound(stack, depths[n]);
+        }
+        clock_t end = clock();
+        cout << "Stack<int> depth " << depths[n] << " push/pop time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+    }
 }
 
 int main(int argc, char const *argv[])
 {
     stack_test();
+    stackSpillTest();
+    stackBenchmark();
     return 0;
 }
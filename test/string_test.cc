@@ -0,0 +1,80 @@
+//COMPILE: g++ string_test.cc -std=c++11 -O2
+#include "./../inc/str/string.h"
+#include <iostream>
+#include <string>
+#include <ctime>
+
+using namespace std;
+using namespace cclib::str;
+
+void stringTest() {
+    String aa("hello");
+    String bb = aa;
+    cout << "aa: " << aa.c_str() << " size: " << aa.size() << " capacity: " << aa.capacity() << endl;
+
+    bb += " world, a string longer than the inline buffer";
+    cout << "bb: " << bb.c_str() << " size: " << bb.size() << " capacity: " << bb.capacity() << endl;
+
+    String cc(std::move(bb));
+    cout << "moved cc: " << cc.c_str() << " moved-from bb size: " << bb.size() << endl;
+
+    cc.append(cc.c_str(), 5);
+    cout << "self append: " << cc.c_str() << endl;
+
+    String dd("0123456789012345678901");
+    cout << "dd: " << dd.c_str() << " size: " << dd.size() << " capacity: " << dd.capacity() << endl;
+    dd.push_back('x');
+    cout << "dd: " << dd.c_str() << " size: " << dd.size() << " capacity: " << dd.capacity() << endl;
+
+    String ee;
+    ee.reserve(100);
+    ee = "short";
+    cout << "ee: " << ee.c_str() << " capacity: " << ee.capacity() << " equal: " << (ee == String("short")) << " less: " << (aa < ee) << endl;
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+template<typename StringType>
+void stringBenchmark(const char* name) {
+    const int count = 2000000;
+    const char* keys[] = {"id", "user_name", "content-length", "x-request-id-0123456", "a key that is too long to stay inline"};
+    cc_size_t total = 0;
+
+    clock_t start = clock();
+    for(int i = 0; i < count; i++) {
+        StringType key(keys[i % 5]);
+        total += key.size();
+    }
+    clock_t end = clock();
+    cout << name << " construct time spend: " << timeSpend(start, end) << "ms" << endl;
+
+    StringType source(keys[1]);
+    start = clock();
+    for(int i = 0; i < count; i++) {
+        StringType copy(source);
+        total += copy.size();
+    }
+    end = clock();
+    cout << name << " copy time spend: " << timeSpend(start, end) << "ms" << endl;
+
+    start = clock();
+    for(int i = 0; i < count / 100; i++) {
+        StringType line;
+        for(int n = 0; n < 100; n++) {
+            line += keys[n % 5];
+        }
+        total += line.size();
+    }
+    end = clock();
+    cout << name << " append time spend: " << timeSpend(start, end) << "ms (" << total << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    stringTest();
+    stringBenchmark<String>("String");
+    stringBenchmark<std::string>("std::string");
+    return 0;
+}
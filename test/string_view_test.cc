@@ -0,0 +1,91 @@
+//COMPILE: g++ string_view_test.cc -std=c++11 -O2 -msse2
+#include "./../inc/str/string_view.h"
+#include "./../inc/str/tokenizer.h"
+#include <iostream>
+#include <string>
+#include <ctime>
+
+using namespace std;
+using namespace cclib::str;
+
+void printView(const char* name, const StringView& view) {
+    cout << name << ": [" << string(view.data(), view.size()) << "]" << endl;
+}
+
+void stringViewTest() {
+    String owner("key=value; path=/index.html");
+    StringView view(owner);
+    printView("view", view);
+    printView("substr", view.substr(4, 5));
+    cout << "startsWith: " << view.startsWith("key") << " endsWith: " << view.endsWith(".html") << endl;
+
+    StringView cstr("value");
+    cout << "equal: " << (view.substr(4, 5) == cstr) << " less: " << (StringView("abc") < StringView("abd")) << endl;
+    String copy = view.substr(0, 3).toString();
+    cout << "toString: " << copy.c_str() << endl;
+}
+
+void tokenizerTest() {
+    Tokenizer csv = split("a,,b,c", ',');
+    StringView token;
+    while(csv.next(token)) {
+        printView("csv", token);
+    }
+
+    Tokenizer words = split("  hello \tworld\n  ", ByteSet(" \t\n", 3), true);
+    for(Tokenizer::iterator itr = words.begin(); itr != words.end(); ++itr) {
+        printView("words", *itr);
+    }
+
+    Tokenizer line("GET /index.html HTTP/1.1", ' ');
+    line.next(token);
+    printView("method", token);
+    printView("rest", line.rest());
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+void tokenizerBenchmark() {
+    string buffer;
+    for(int i = 0; i < 200000; i++) {
+        buffer += "2019-10-18T12:00:00,GET,/api/v1/users/12345,200,0.0123,Mozilla/5.0 (X11; Linux x86_64)\n";
+    }
+
+    cc_size_t fields = 0, bytes = 0;
+    clock_t start = clock();
+    Tokenizer lines(StringView(buffer.data(), buffer.size()), '\n', true);
+    StringView line, field;
+    while(lines.next(line)) {
+        Tokenizer columns(line, ',');
+        while(columns.next(field)) {
+            ++fields;
+            bytes += field.size();
+        }
+    }
+    clock_t end = clock();
+    cout << "Tokenizer views: " << fields << " fields time spend: " << timeSpend(start, end) << "ms (" << bytes << ")" << endl;
+
+    fields = bytes = 0;
+    start = clock();
+    lines = Tokenizer(StringView(buffer.data(), buffer.size()), '\n', true);
+    while(lines.next(line)) {
+        Tokenizer columns(line, ',');
+        while(columns.next(field)) {
+            String copy = field.toString();   //NOTICE: one String per field, the old way
+            ++fields;
+            bytes += copy.size();
+        }
+    }
+    end = clock();
+    cout << "Tokenizer copies: " << fields << " fields time spend: " << timeSpend(start, end) << "ms (" << bytes << ")" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    stringViewTest();
+    tokenizerTest();
+    tokenizerBenchmark();
+    return 0;
+}
@@ -0,0 +1,84 @@
+//COMPILE: g++ thread_pool_test.cc -std=c++11 -O2 -pthread
+#include "./../inc/algorithm/parallel/thread_pool.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <stdexcept>
+
+using namespace std;
+using namespace cclib::algorithm;
+
+long long fibonacci(int n) {
+    if(n < 2) return n;
+    if(n < 20) return fibonacci(n - 1) + fibonacci(n - 2);
+
+    long long left = 0, right = 0;
+    parallelInvoke([&]() { left = fibonacci(n - 1); },
+                   [&]() { right = fibonacci(n - 2); });
+    return left + right;
+}
+
+void threadPoolTest() {
+    ThreadPool& pool = ThreadPool::instance();
+    cout << "threads: " << pool.threadCount() << " concurrency: " << pool.concurrency() << endl;
+
+    TaskFuture<int> future = pool.submit([]() { return 6 * 7; });
+    TaskFuture<void> nothing = pool.submit([]() {});
+    nothing.get();
+    cout << "future: " << future.get() << endl;
+
+    cout << "fibonacci(30): " << fibonacci(30) << endl;
+
+    vector<int> values(100000, 1);
+    std::atomic<long long> sum(0);
+    parallelFor(0, values.size(), [&](long long i) { sum += values[i]; });
+    cout << "parallelFor sum: " << sum.load() << endl;
+
+    TaskFuture<int> failed = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    try {
+        failed.get();
+    } catch(const std::exception& e) {
+        cout << "exception: " << e.what() << endl;
+    }
+}
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+//COMMENT: chunked reduction, one partial sum per grain so that the atomics stay out of the hot loop
+void threadPoolBenchmark() {
+    const long long count = 50000000;
+    vector<double> values(count, 0.5);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    double sequential = 0;
+    for(long long i = 0; i < count; i++) {
+        sequential += values[i] * values[i];
+    }
+    cout << "sequential sum: " << sequential << " time: " << secondsSince(start) << "s" << endl;
+
+    const long long chunk = 1 << 16;
+    vector<double> partial((count + chunk - 1) / chunk, 0);
+    start = chrono::steady_clock::now();
+    parallelFor(0, partial.size(), [&](long long c) {
+        double sum = 0;
+        long long end = (c + 1) * chunk < count ? (c + 1) * chunk : count;
+        for(long long i = c * chunk; i < end; i++) {
+            sum += values[i] * values[i];
+        }
+        partial[c] = sum;
+    });
+    double parallel = 0;
+    for(cc_size_t i = 0; i < partial.size(); i++) {
+        parallel += partial[i];
+    }
+    cout << "parallelFor sum: " << parallel << " time: " << secondsSince(start) << "s" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    threadPoolTest();
+    threadPoolBenchmark();
+    return 0;
+}
@@ -3,10 +3,19 @@
 #include "./../cclib-common/inc/util/util.h"
 #include "./../inc/adt/tree.h"
 #include "./../inc/adt/pair.h"
+#include "./../inc/algorithm/parallel/parallel_tree.h"
 #include <iostream>
+#include <set>
+#include <iterator>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
 
 using namespace std;
 using namespace cclib::adt;
+using cclib::algorithm::ParallelRedBlackTree;
 
 void binarySearchTreeTest() {
     BinarySearchTree<int> cc;
@@ -107,10 +116,434 @@ void redBlackTreePairTest() {
     cclib::common::util::printTreeValue(cc);
 }
 
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+void orderStatisticTest() {
+    //COMMENT: random inserts and removes against std::set, every query checked
+    RedBlackTree<int, RedBlackOrderStatistic> tree;
+    set<int> expect;
+    int failed = 0;
+    for(int round = 0; round < 20000; round++) {
+        int value = rand() % 2000;
+        if(rand() % 3) {
+            if(tree.insert(value) != expect.insert(value).second) ++failed;
+        } else {
+            tree.remove(value);
+            expect.erase(value);
+        }
+        if(tree.size() != expect.size()) ++failed;
+
+        int probe = rand() % 2100 - 50;
+        if(tree.rank(probe) != (cc_size_t)distance(expect.begin(), expect.lower_bound(probe))) ++failed;
+        if(!expect.empty()) {
+            cc_size_t index = rand() % expect.size();
+            set<int>::iterator it = expect.begin();
+            advance(it, index);
+            if(tree.select(index)->_data != *it) ++failed;
+        }
+        if(tree.select(expect.size()) != tree.nil()) ++failed;
+        int low = rand() % 2000, high = low + rand() % 300;
+        if(tree.rangeCount(low, high) != (cc_size_t)distance(expect.lower_bound(low), expect.lower_bound(high))) ++failed;
+    }
+    cout << "order statistic failed: " << failed << " size: " << tree.size() << endl;
+
+    const int count = 1000000;
+    RedBlackTree<int, RedBlackOrderStatistic> large;
+    set<int> largeExpect;
+    for(int i = 0; i < count; i++) {
+        large.insert(i * 2);
+        largeExpect.insert(i * 2);
+    }
+    cc_size_t sum = 0;
+    clock_t start = clock();
+    for(int i = 0; i < 1000; i++) {
+        sum += large.rank(rand() % (2 * count));
+        sum += large.select(rand() % count)->_data;
+    }
+    clock_t end = clock();
+    cout << "rank and select time spend: " << timeSpend(start, end) << "ms (" << sum << ")" << endl;
+
+    //NOTICE: the walk runs 10 rounds instead of 1000, its time is scaled by 100
+    sum = 0;
+    start = clock();
+    for(int i = 0; i < 10; i++) {
+        sum += distance(largeExpect.begin(), largeExpect.lower_bound(rand() % (2 * count)));
+        set<int>::iterator it = largeExpect.begin();
+        advance(it, rand() % count);
+        sum += *it;
+    }
+    end = clock();
+    cout << "std::set walk time spend: " << timeSpend(start, end) * 100 << "ms (" << sum << ")" << endl;
+}
+
+void iteratorTest() {
+    RedBlackTree<int> tree;
+    set<int> expect;
+    for(int i = 0; i < 5000; i++) {
+        int value = rand() % 3000;
+        if(rand() % 4) {
+            tree.insert(value);
+            expect.insert(value);
+        } else {
+            tree.remove(value);
+            expect.erase(value);
+        }
+    }
+
+    int failed = 0;
+    set<int>::iterator forward = expect.begin();
+    for(int value : tree) {
+        if(forward == expect.end() || value != *forward++) ++failed;
+    }
+    set<int>::reverse_iterator backward = expect.rbegin();
+    for(RedBlackTree<int>::reverse_iterator itr = tree.rbegin(); itr != tree.rend(); ++itr) {
+        if(backward == expect.rend() || *itr != *backward++) ++failed;
+    }
+    if(*--tree.end() != *expect.rbegin() || *--tree.rend() != *expect.begin()) ++failed;
+
+    for(int round = 0; round < 2000; round++) {
+        int low = rand() % 3100 - 50, high = low + rand() % 200;
+        RedBlackTree<int>::iterator lower = tree.lowerBound(low), upper = tree.upperBound(low);
+        if((lower == tree.end()) != (expect.lower_bound(low) == expect.end()) || (lower != tree.end() && *lower != *expect.lower_bound(low))) ++failed;
+        if((upper == tree.end()) != (expect.upper_bound(low) == expect.end()) || (upper != tree.end() && *upper != *expect.upper_bound(low))) ++failed;
+
+        long long sum = 0, expectSum = 0;
+        cc_size_t count = tree.scan(low, high, [&sum](int value) { sum += value; });
+        for(set<int>::iterator itr = expect.lower_bound(low); itr != expect.lower_bound(high); ++itr) expectSum += *itr;
+        if(count != (cc_size_t)distance(expect.lower_bound(low), expect.lower_bound(high)) || sum != expectSum) ++failed;
+    }
+    cout << "iterator failed: " << failed << " size: " << tree.size() << endl;
+
+    const int count = 1000000;
+    RedBlackTree<int> large;
+    set<int> largeExpect;
+    for(int i = 0; i < count; i++) {
+        large.insert(rand());
+        largeExpect.insert(rand());
+    }
+    long long sum = 0;
+    clock_t start = clock();
+    for(int round = 0; round < 10; round++) {
+        for(RedBlackTree<int>::iterator itr = large.begin(); itr != large.end(); ++itr) sum += *itr;
+    }
+    clock_t end = clock();
+    cout << "full traversal time spend: " << timeSpend(start, end) << "ms (" << (sum & 1) << ")" << endl;
+
+    start = clock();
+    for(int round = 0; round < 10; round++) {
+        for(set<int>::iterator itr = largeExpect.begin(); itr != largeExpect.end(); ++itr) sum += *itr;
+    }
+    end = clock();
+    cout << "std::set traversal time spend: " << timeSpend(start, end) << "ms (" << (sum & 1) << ")" << endl;
+
+    cc_size_t visited = 0;
+    const int width = (RAND_MAX / count) * 100;
+    start = clock();
+    for(int round = 0; round < 10000; round++) {
+        int low = rand() % (RAND_MAX - width);
+        visited += large.scan(low, low + width, [&sum](int value) { sum += value; });
+    }
+    end = clock();
+    cout << "range scan time spend: " << timeSpend(start, end) << "ms (" << visited << " values)" << endl;
+}
+
+void intervalTest() {
+    //COMMENT: random inserts and removes against a plain list, every query checked against a full scan
+    IntervalTree<int> tree;
+    set<Interval<int> > expect;
+    int failed = 0;
+    for(int round = 0; round < 20000; round++) {
+        int low = rand() % 10000;
+        Interval<int> interval(low, low + rand() % 500);
+        if(rand() % 3) {
+            if(tree.insert(interval) != expect.insert(interval).second) ++failed;
+        } else {
+            tree.remove(interval);
+            expect.erase(interval);
+        }
+
+        int queryLow = rand() % 10500 - 250, queryHigh = queryLow + rand() % 300;
+        vector<Interval<int> > found, brute;
+        cc_size_t count = tree.overlap(queryLow, queryHigh, [&found](const Interval<int>& value) { found.push_back(value); });
+        for(set<Interval<int> >::iterator itr = expect.begin(); itr != expect.end(); ++itr) {
+            if(itr->overlaps(queryLow, queryHigh)) brute.push_back(*itr);
+        }
+        if(count != found.size() || found != brute) ++failed;
+
+        cc_size_t stabbed = tree.stab(queryLow, [](const Interval<int>&) {});
+        cc_size_t bruteStabbed = 0;
+        for(set<Interval<int> >::iterator itr = expect.begin(); itr != expect.end(); ++itr) bruteStabbed += itr->overlaps(queryLow, queryLow);
+        if(stabbed != bruteStabbed) ++failed;
+    }
+    if(tree.size() != expect.size()) ++failed;
+    cout << "interval tree failed: " << failed << " size: " << tree.size() << endl;
+
+    //COMMENT: a million ranges of up to 1000 over [0, 1e9), windows of 10000
+    const int count = 1000000, queries = 10000;
+    IntervalTree<int> large;
+    vector<Interval<int> > all;
+    for(int i = 0; i < count; i++) {
+        int low = rand() % 1000000000;
+        Interval<int> interval(low, low + rand() % 1000);
+        if(large.insert(interval)) all.push_back(interval);
+    }
+
+    cc_size_t hits = 0;
+    clock_t start = clock();
+    for(int i = 0; i < queries; i++) {
+        int low = rand() % 1000000000;
+        hits += large.overlap(low, low + 10000, [](const Interval<int>&) {});
+    }
+    cout << "interval overlap query time spend: " << timeSpend(start, clock()) << "ms (" << hits << " hits)" << endl;
+
+    //NOTICE: the scan runs 10 queries instead of 10000, its time is scaled by 1000
+    hits = 0;
+    start = clock();
+    for(int i = 0; i < 10; i++) {
+        int low = rand() % 1000000000;
+        for(cc_size_t j = 0; j < all.size(); j++) hits += all[j].overlaps(low, low + 10000);
+    }
+    cout << "full scan time spend: " << timeSpend(start, clock()) * 1000 << "ms (" << hits << " hits)" << endl;
+}
+
+//COMMENT: black height of the subtree, -1 when a red black rule, a parent link, the order or a subtree size is broken
+template<typename Node>
+int redBlackCheck(const Node* node, const Node* nil, const Node* parent) {
+    if(nil == node) return 0;
+    if(node->_parent != parent) return -1;
+    if(EN_Red == node->_color && (EN_Red == node->_leftChild->_color || EN_Red == node->_rightChild->_color)) return -1;
+    if(nil != node->_leftChild && !(node->_leftChild->_data < node->_data)) return -1;
+    if(nil != node->_rightChild && !(node->_data < node->_rightChild->_data)) return -1;
+    if(node->_count != 1 + node->_leftChild->_count + node->_rightChild->_count) return -1;
+
+    int left = redBlackCheck(node->_leftChild, nil, node), right = redBlackCheck(node->_rightChild, nil, node);
+    if(left < 0 || left != right) return -1;
+    return left + (EN_Black == node->_color ? 1 : 0);
+}
+
+template<typename Tree>
+bool sameSet(Tree& tree, const set<int>& expect) {
+    const RedBlackNode<int, RedBlackOrderStatistic>* root = tree.begin().node();
+    while(tree.nil() != root && tree.nil() != root->_parent) root = root->_parent;
+    if(tree.nil() != root && EN_Black != root->_color) return false;
+    if(redBlackCheck(root, tree.nil(), tree.nil()) < 0 || 0 != tree.nil()->_count) return false;
+    if(tree.size() != expect.size() || (tree.nil() != root && root->_count != expect.size())) return false;
+    if(!expect.empty() && (*tree.begin() != *expect.begin() || *tree.rbegin() != *expect.rbegin())) return false;
+    set<int>::const_iterator itr = expect.begin();
+    for(int value : tree) {
+        if(value != *itr++) return false;
+    }
+    return true;
+}
+
+template<typename Tree>
+void fillTree(Tree& tree, set<int>& expect, int count, int range) {
+    for(int i = 0; i < count; i++) {
+        int value = rand() % range;
+        tree.insert(value);
+        expect.insert(value);
+    }
+}
+
+template<typename Tree>
+void setOperationTest(const char* name) {
+    int failed = 0;
+    for(int round = 0; round < 400; round++) {
+        //COMMENT: from empty to large trees on both sides, a small range gives many common values
+        int range = 1 + rand() % 20000;
+        int countA = round % 5 ? rand() % 3000 : rand() % 4, countB = round % 7 ? rand() % 3000 : rand() % 4;
+        if(0 == round % 50) countA = 100000;
+        set<int> expectA, expectB, expect;
+
+        Tree a, b;
+        fillTree(a, expectA, countA, range);
+        fillTree(b, expectB, countB, range);
+        set_union(expectA.begin(), expectA.end(), expectB.begin(), expectB.end(), inserter(expect, expect.end()));
+        a.unionWith(b);
+        if(!sameSet(a, expect) || !b.empty() || !sameSet(b, set<int>())) ++failed;
+
+        //COMMENT: the emptied tree must still work
+        b.insert(range);
+        b.insert(-1);
+        if(!sameSet(b, set<int>{-1, range})) ++failed;
+
+        Tree c, d;
+        expectA.clear(), expectB.clear(), expect.clear();
+        fillTree(c, expectA, countA, range);
+        fillTree(d, expectB, countB, range);
+        set_intersection(expectA.begin(), expectA.end(), expectB.begin(), expectB.end(), inserter(expect, expect.end()));
+        c.intersectWith(d);
+        if(!sameSet(c, expect) || !d.empty()) ++failed;
+
+        Tree e, f;
+        expectA.clear(), expectB.clear(), expect.clear();
+        fillTree(e, expectA, countA, range);
+        fillTree(f, expectB, countB, range);
+        set_difference(expectA.begin(), expectA.end(), expectB.begin(), expectB.end(), inserter(expect, expect.end()));
+        e.differenceWith(f);
+        if(!sameSet(e, expect) || !f.empty()) ++failed;
+
+        Tree right;
+        fillTree(right, expectB, 10, range);
+        int key = rand() % (range + 2) - 1;
+        set<int> expectRight(expect.lower_bound(key), expect.end());
+        expect.erase(expect.lower_bound(key), expect.end());
+        e.split(key, right);
+        if(!sameSet(e, expect) || !sameSet(right, expectRight)) ++failed;
+        e.unionWith(right);
+        expect.insert(expectRight.begin(), expectRight.end());
+        if(!sameSet(e, expect)) ++failed;
+    }
+    cout << name << " set operation failed: " << failed << endl;
+}
+
+double wallSpend(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+//COMMENT: count sorted values spread over [0, 3 * large), two such sets share about a third of the smaller one;
+//the same seed gives the same set, the join and the loop work on equal inputs
+void fillSpread(ParallelRedBlackTree<int>& tree, int count, int large, int seed) {
+    srand(seed);
+    int step = 3 * (large / count);
+    for(int i = 0; i < count; i++) tree.insert(i * step + rand() % 3);
+}
+
+//NOTICE: wall clock, clock() would add up the time of all the pool threads
+void setOperationBenchmark() {
+    const int large = 10000000;
+    const int smalls[] = {large, 1000};
+    cout << "set operations on " << thread::hardware_concurrency() << " cores" << endl;
+    for(int n = 0; n < 2; n++) {
+        int small = smalls[n];
+        ParallelRedBlackTree<int> *a = new ParallelRedBlackTree<int>(), *b = new ParallelRedBlackTree<int>();
+        fillSpread(*a, large, large, 1);
+        fillSpread(*b, small, large, 2);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        a->unionWith(*b);
+        double joinTime = wallSpend(start);
+        cc_size_t joinSize = a->size();
+        delete a;
+        delete b;
+
+        a = new ParallelRedBlackTree<int>();
+        b = new ParallelRedBlackTree<int>();
+        fillSpread(*a, large, large, 1);
+        fillSpread(*b, small, large, 2);
+        start = chrono::steady_clock::now();
+        for(ParallelRedBlackTree<int>::iterator itr = b->begin(); itr != b->end(); ++itr) a->insert(*itr);
+        cout << large << " x " << small << " union: join " << joinTime << "ms, insert " << wallSpend(start) << "ms ("
+             << joinSize << " " << a->size() << ")" << endl;
+        delete a;
+        delete b;
+
+        a = new ParallelRedBlackTree<int>();
+        b = new ParallelRedBlackTree<int>();
+        fillSpread(*a, large, large, 1);
+        fillSpread(*b, small, large, 2);
+        start = chrono::steady_clock::now();
+        a->intersectWith(*b);
+        joinTime = wallSpend(start);
+        joinSize = a->size();
+        delete a;
+        delete b;
+
+        a = new ParallelRedBlackTree<int>();
+        b = new ParallelRedBlackTree<int>();
+        fillSpread(*a, large, large, 1);
+        fillSpread(*b, small, large, 2);
+        start = chrono::steady_clock::now();
+        vector<int> missing;
+        for(ParallelRedBlackTree<int>::iterator itr = a->begin(); itr != a->end(); ++itr) {
+            if(b->nil() == b->find(*itr)) missing.push_back(*itr);
+        }
+        for(cc_size_t i = 0; i < missing.size(); i++) a->remove(missing[i]);
+        cout << large << " x " << small << " intersection: join " << joinTime << "ms, find and remove " << wallSpend(start) << "ms ("
+             << joinSize << " " << a->size() << ")" << endl;
+        delete a;
+        delete b;
+
+        a = new ParallelRedBlackTree<int>();
+        b = new ParallelRedBlackTree<int>();
+        fillSpread(*a, large, large, 1);
+        fillSpread(*b, small, large, 2);
+        start = chrono::steady_clock::now();
+        a->differenceWith(*b);
+        joinTime = wallSpend(start);
+        joinSize = a->size();
+        delete a;
+        delete b;
+
+        a = new ParallelRedBlackTree<int>();
+        b = new ParallelRedBlackTree<int>();
+        fillSpread(*a, large, large, 1);
+        fillSpread(*b, small, large, 2);
+        start = chrono::steady_clock::now();
+        for(ParallelRedBlackTree<int>::iterator itr = b->begin(); itr != b->end(); ++itr) a->remove(*itr);
+        cout << large << " x " << small << " difference: join " << joinTime << "ms, remove " << wallSpend(start) << "ms ("
+             << joinSize << " " << a->size() << ")" << endl;
+        delete a;
+        delete b;
+    }
+}
+
+template<typename Node>
+int depth(const Node* node) {
+    if(CC_NULL == node) return 0;
+    int left = depth(node->_leftChild), right = depth(node->_rightChild);
+    return (left > right ? left : right) + 1;
+}
+
+template<typename Balance>
+void balanceTest(const char* name) {
+    BinarySearchTree<int, Balance> tree;
+    set<int> expect;
+    int failed = 0;
+    for(int round = 0; round < 20000; round++) {
+        int value = rand() % 4000;
+        if(rand() % 3) {
+            if(tree.insert(value) != expect.insert(value).second) ++failed;
+        } else {
+            if(tree.remove(value) != (0 != expect.erase(value))) ++failed;
+        }
+        int probe = rand() % 4000;
+        if(tree.contains(probe) != (0 != expect.count(probe))) ++failed;
+        if(tree.contains(probe) && tree.find(probe) != probe) ++failed;
+    }
+    if(tree.size() != expect.size()) ++failed;
+    cout << name << " random failed: " << failed << " size: " << tree.size() << " depth: " << depth(tree.begin()) << endl;
+
+    //COMMENT: sorted inserts turn the unbalanced tree into a list
+    const int count = 10000;
+    BinarySearchTree<int, Balance> sorted;
+    clock_t start = clock();
+    for(int i = 0; i < count; i++) sorted.insert(i);
+    double insertTime = timeSpend(start, clock());
+
+    cc_size_t found = 0;
+    start = clock();
+    for(int round = 0; round < 10; round++) {
+        for(int i = 0; i < count; i++) found += sorted.contains(i);
+    }
+    double lookupTime = timeSpend(start, clock());
+    cout << name << " sorted insert " << insertTime << "ms, lookup " << lookupTime << "ms (" << found << "), depth: " << depth(sorted.begin()) << endl;
+}
+
 int main(int argc, char const *argv[])
 {
     /* code */
-    // binarySearchTreeTest();
+    binarySearchTreeTest();
     redBlackTreePairTest();
+    orderStatisticTest();
+    iteratorTest();
+    intervalTest();
+    setOperationTest<RedBlackTree<int, RedBlackOrderStatistic> >("serial");
+    setOperationTest<ParallelRedBlackTree<int, RedBlackOrderStatistic> >("parallel");
+    setOperationBenchmark();
+    balanceTest<BinaryNoBalance>("no balance");
+    balanceTest<BinaryTreapBalance>("treap");
+    balanceTest<BinaryAVLBalance>("avl");
     return 0;
 }
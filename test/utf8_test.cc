@@ -0,0 +1,196 @@
+//COMPILE: g++ utf8_test.cc -std=c++11 -O2 -mavx2
+#include "./../inc/str/utf8.h"
+#include "./../inc/str/string.h"
+#include "./../inc/str/string_view.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+
+using namespace std;
+using namespace cclib::str;
+
+//COMMENT: byte at a time reference, the check every caller used to run
+bool validateReference(const char* data, cc_size_t length) {
+    const unsigned char* p = (const unsigned char*)data;
+    const unsigned char* end = p + length;
+    uint32_t codePoint = 0;
+    while(p < end) {
+        cc_size_t size = detail::decodeUtf8(p, end - p, codePoint);
+        if(0 == size) return false;
+        p += size;
+    }
+    return true;
+}
+
+string randomText(cc_size_t codePoints, int mix) {
+    string text;
+    char buffer[4];
+    for(cc_size_t i = 0; i < codePoints; i++) {
+        uint32_t codePoint = 0;
+        int kind = rand() % 100;
+        if(kind >= mix) codePoint = 0x20 + rand() % 0x5F;
+        else if(kind % 3 == 0) codePoint = 0x80 + rand() % 0x780;
+        else if(kind % 3 == 1) codePoint = 0x4E00 + rand() % 0x5200;
+        else codePoint = 0x10000 + rand() % 0x100000;
+        text.append(buffer, detail::encodeUtf8(codePoint, buffer));
+    }
+    return text;
+}
+
+void validateTest() {
+    const char* invalid[] = {"\x80", "\xC0\xAF", "\xC1\xBF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF0\x80\x80\xAF",
+                             "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", "\xE4\xB8", "\xC3\x28", "\xE4\xB8\xAD\x80"};
+    int rejected = 0;
+    for(int i = 0; i < 12; i++) {
+        //NOTICE: every case sits at each offset of a 64 byte ASCII frame, across the vector boundaries
+        string frame(64, 'a');
+        bool all = true;
+        for(cc_size_t offset = 0; offset < 64; offset++) {
+            string text = frame;
+            text.replace(offset, 0, invalid[i]);
+            if(validateUtf8(text.data(), text.size())) all = false;
+        }
+        if(all) ++rejected;
+    }
+    cout << "invalid cases rejected: " << rejected << "/12" << endl;
+
+    const char* valid = "ASCII, \xC3\xA9t\xC3\xA9, \xE4\xB8\xAD\xE6\x96\x87, \xF0\x9F\x98\x80, \xEF\xBF\xBF, \xF4\x8F\xBF\xBF";
+    cout << "valid: " << validateUtf8(valid) << " code points: " << StringView(valid).codePoints() << endl;
+
+    //COMMENT: random texts with random byte damage against the reference
+    int mismatch = 0, invalidCount = 0;
+    for(int round = 0; round < 20000; round++) {
+        string text = randomText(rand() % 200, rand() % 100);
+        int damage = rand() % 3;
+        for(int i = 0; i < damage && !text.empty(); i++) {
+            text[rand() % text.size()] = (char)rand();
+        }
+        bool expect = validateReference(text.data(), text.size());
+        if(!expect) ++invalidCount;
+        if(expect != validateUtf8(text.data(), text.size())) ++mismatch;
+        if(expect) {
+            cc_size_t count = 0;
+            for(cc_size_t i = 0; i < text.size(); i++) count += 0x80 != ((unsigned char)text[i] & 0xC0);
+            if(count != countCodePoints(text.data(), text.size())) ++mismatch;
+        }
+    }
+    cout << "random validate mismatch: " << mismatch << " (invalid inputs " << invalidCount << ")" << endl;
+}
+
+void transcodeTest() {
+    int failed = 0;
+    for(int round = 0; round < 5000; round++) {
+        string text = randomText(rand() % 300, rand() % 100);
+
+        vector<char16_t> utf16(utf16LengthFromUtf8(text.data(), text.size()) + 1);
+        cc_size_t units = utf8ToUtf16(text.data(), text.size(), &utf16[0]);
+        if(units != utf16.size() - 1) ++failed;
+        string back(utf8LengthFromUtf16(&utf16[0], units), '\0');
+        if(utf16ToUtf8(&utf16[0], units, &back[0]) != back.size() || back != text) ++failed;
+
+        vector<char32_t> utf32(countCodePoints(text.data(), text.size()) + 1);
+        cc_size_t points = utf8ToUtf32(text.data(), text.size(), &utf32[0]);
+        if(points != utf32.size() - 1) ++failed;
+        back.assign(utf8LengthFromUtf32(&utf32[0], points), '\0');
+        if(utf32ToUtf8(&utf32[0], points, &back[0]) != back.size() || back != text) ++failed;
+    }
+    cout << "random transcode failed: " << failed << endl;
+
+    char16_t buffer16[4];
+    char32_t buffer32[4];
+    char16_t lone[] = {0xD800, 'a'};
+    char32_t surrogate[] = {0xDC00};
+    char out[16];
+    cout << "errors: " << (UTF_ERROR == utf8ToUtf16("\xE0\x80\x80", 3, buffer16)) << " " << (UTF_ERROR == utf8ToUtf32("\xC3", 1, buffer32))
+         << " " << (UTF_ERROR == utf16ToUtf8(lone, 2, out)) << " " << (UTF_ERROR == utf32ToUtf8(surrogate, 1, out)) << endl;
+}
+
+void nulTest() {
+    //NOTICE: an embedded '\0' is data, it survives copies, appends and compares
+    String text("ab\0cd", 5);
+    String copy(text);
+    copy.append("\0ef", 3);
+    String other("ab\0ce", 5);
+    cout << "nul size: " << text.size() << " " << copy.size() << " compare: " << (text < other) << " " << (text == String("ab", 2))
+         << " find: " << copy.find(String("\0e", 2)) << " utf8: " << copy.validUtf8() << " " << copy.codePoints() << endl;
+}
+
+double timeSpend(clock_t startTime, clock_t endTime) {
+    return (double)(endTime - startTime) * 1000 / CLOCKS_PER_SEC;
+}
+
+cc_size_t utf8ToUtf16Reference(const string& text, char16_t* out) {
+    const unsigned char* p = (const unsigned char*)text.data();
+    const unsigned char* end = p + text.size();
+    char16_t* begin = out;
+    uint32_t codePoint = 0;
+    while(p < end) {
+        cc_size_t size = detail::decodeUtf8(p, end - p, codePoint);
+        if(0 == size) return UTF_ERROR;
+        p += size;
+        if(codePoint < 0x10000) {
+            *out++ = (char16_t)codePoint;
+        } else {
+            *out++ = (char16_t)(0xD800 + ((codePoint - 0x10000) >> 10));
+            *out++ = (char16_t)(0xDC00 + (codePoint & 0x3FF));
+        }
+    }
+    return out - begin;
+}
+
+void utf8Benchmark() {
+    const char* names[] = {"ascii", "european", "cjk"};
+    string corpora[3];
+    const char* european = "Die Gr\xC3\xB6\xC3\x9F" "e des Caf\xC3\xA9s, na\xC3\xAFve fa\xC3\xA7" "ade, \xC5\x81\xC3\xB3" "d\xC5\xBA, \xC3\xA5r ";
+    const char* cjk = "\xE4\xB8\xAD\xE6\x96\x87\xE6\xB5\x8B\xE8\xAF\x95\xE3\x80\x82\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xA7\xE3\x81\x99 ";
+    while(corpora[0].size() < (8 << 20)) {
+        corpora[0] += "The quick brown fox jumps over the lazy dog. ";
+        corpora[1] += european;
+        corpora[2] += cjk;
+    }
+
+    //NOTICE: never more UTF-16 units than UTF-8 bytes
+    vector<char16_t> utf16(corpora[0].size() + corpora[1].size() + corpora[2].size());
+    for(int n = 0; n < 3; n++) {
+        const string& text = corpora[n];
+        const int rounds = 20;
+        cc_size_t sum = 0;
+
+        clock_t start = clock();
+        //NOTICE: a different start every round, the calls are pure and would be hoisted out of the loop
+        for(int i = 0; i < rounds; i++) sum += validateUtf8(text.data() + i % 4, text.size() - i % 4);
+        double simdTime = timeSpend(start, clock());
+
+        start = clock();
+        for(int i = 0; i < rounds; i++) sum += validateReference(text.data() + i % 4, text.size() - i % 4);
+        double scalarTime = timeSpend(start, clock());
+
+        start = clock();
+        for(int i = 0; i < rounds; i++) sum += countCodePoints(text.data() + i % 4, text.size() - i % 4);
+        double countTime = timeSpend(start, clock());
+
+        start = clock();
+        for(int i = 0; i < rounds; i++) sum += utf8ToUtf16(text.data() + i % 4, text.size() - i % 4, &utf16[0]);
+        double transcodeTime = timeSpend(start, clock());
+
+        start = clock();
+        for(int i = 0; i < rounds; i++) sum += utf8ToUtf16Reference(text, &utf16[0]);
+        double referenceTime = timeSpend(start, clock());
+
+        double bytes = (double)text.size() * rounds / 1e6;
+        cout << names[n] << ": validate " << bytes / simdTime << " GB/s (byte at a time " << bytes / scalarTime
+             << " GB/s), count " << bytes / countTime << " GB/s, to utf16 " << bytes / transcodeTime
+             << " GB/s (byte at a time " << bytes / referenceTime << " GB/s) (" << (sum & 1) << ")" << endl;
+    }
+}
+
+int main(int argc, char const *argv[])
+{
+    validateTest();
+    transcodeTest();
+    nulTest();
+    utf8Benchmark();
+    return 0;
+}